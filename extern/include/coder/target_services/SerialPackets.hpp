@@ -13,16 +13,46 @@ namespace coder { namespace tgtsvc {
 enum PacketId {
     CONNECT_ID = 0,
     ACK_ID = 1,
-    DATA_ID = 2
+    DATA_ID = 2,
+    CONNECT_EX_ID = 3,
+    ACK_EX_ID = 4,
+    DATA_EX_ID = 5
 };
 
 enum {
    
     MAX_SERIAL_PACKET_SIZE = 64,
 
-    MAX_RX_WINDOW_SIZE = 128
+    MAX_RX_WINDOW_SIZE = 128,
+
+    /* high-throughput profile, see ConnectEx */
+    MAX_SERIAL_PACKET_SIZE_EX = 4096,
+
+    MAX_RX_WINDOW_SIZE_EX = 1024,
+
+    ACK_EX_MASK_BITS = 32
 };
 
+namespace detail {
+
+/* multi-byte fields of the high-throughput profile are little endian */
+inline uint16_t getLE16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline void setLE16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+inline uint32_t getLE32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+inline void setLE32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+}
+
+/* true if sequence number a comes before b in the 16-bit sequence space */
+inline bool sequenceBefore(uint16_t a, uint16_t b)
+{
+    return (uint16_t)(b - a) - 1U < 0x7fffU;
+}
+
 struct Ack
 {
     enum {
@@ -66,6 +96,114 @@ struct Connect
     uint8_t windowSize_; 
 };
 
+/*
+ * High-throughput profile: packets of up to MAX_SERIAL_PACKET_SIZE_EX bytes,
+ * 16-bit sequence numbers, acknowledgments that cover many packets, and a
+ * CRC-32 (crc32.hpp).
+ *
+ * Both sides connect with Connect as before.  A side that supports the
+ * profile then sends a ConnectEx with its limits; a side that does not
+ * drops it as an unknown packet.  The profile is used once each side has
+ * both sent and received a ConnectEx, with the smaller of the two packet
+ * sizes and windows.  If no ConnectEx arrives before the connect timeout,
+ * both sides keep the Connect packets and limits.  A side never sends a
+ * ConnectEx before it has received a Connect.
+ */
+struct ConnectEx
+{
+    enum {
+        ID = CONNECT_EX_ID,
+        VERSION = 1
+    };
+
+    ConnectEx() : id_(ID), version_(VERSION) {
+        detail::setLE16(maxPacketSize_, MAX_SERIAL_PACKET_SIZE_EX);
+        detail::setLE16(windowSize_, MAX_RX_WINDOW_SIZE_EX);
+    }
+    ConnectEx(uint16_t maxPacketSize, uint16_t windowSize) : id_(ID), version_(VERSION) {
+        detail::setLE16(maxPacketSize_, maxPacketSize);
+        detail::setLE16(windowSize_, windowSize);
+    }
+
+    uint16_t maxPacketSize() const { return detail::getLE16(maxPacketSize_); }
+    uint16_t windowSize() const { return detail::getLE16(windowSize_); }
+
+    uint8_t id_;
+    uint8_t version_;
+    uint8_t maxPacketSize_[2]; /* header included */
+    uint8_t windowSize_[2];    /* packets the receiver buffers */
+};
+
+/*
+ * Acknowledges every packet up to and including sequence_, and each packet
+ * sequence_+1+i whose bit i is set in mask_ (received out of order).  A
+ * receiver sends one when a packet has DataHeaderEx::ACK_NOW set, when half
+ * its window is unacknowledged, or when a packet arrives out of order.
+ */
+struct AckEx
+{
+    enum {
+        ID = ACK_EX_ID
+    };
+
+    AckEx() : id_(ID), reserved_(0) {
+        detail::setLE16(sequence_, 0);
+        detail::setLE32(mask_, 0);
+    }
+
+    uint16_t sequence() const { return detail::getLE16(sequence_); }
+    void setSequence(uint16_t sequence) { detail::setLE16(sequence_, sequence); }
+
+    uint32_t mask() const { return detail::getLE32(mask_); }
+    void setMask(uint32_t mask) { detail::setLE32(mask_, mask); }
+
+    bool acknowledges(uint16_t sequence) const {
+        uint16_t dist = (uint16_t)(sequence - this->sequence());
+        if (dist == 0 || sequenceBefore(sequence, this->sequence())) return true;
+        return dist <= ACK_EX_MASK_BITS && ((mask() >> (dist - 1)) & 1U) != 0;
+    }
+
+    uint8_t id_;
+    uint8_t reserved_;
+    uint8_t sequence_[2];
+    uint8_t mask_[4];
+};
+
+/*
+ * crc_ is the CRC-32 of the header bytes before it followed by the data.
+ */
+struct DataHeaderEx
+{
+    enum {
+        ID = DATA_EX_ID,
+        ACK_NOW = 0x01 /* flags_: acknowledge now, e.g. the last of a burst */
+    };
+
+    DataHeaderEx() : id_(ID), flags_(0) {
+        detail::setLE16(sequence_, 0);
+        detail::setLE16(dataSize_, 0);
+        detail::setLE32(crc_, 0);
+    }
+
+    uint8_t *data() { return reinterpret_cast<uint8_t*>(this + 1); }
+    const uint8_t *data() const { return const_cast<DataHeaderEx*>(this)->data(); }
+
+    uint16_t sequence() const { return detail::getLE16(sequence_); }
+    void setSequence(uint16_t sequence) { detail::setLE16(sequence_, sequence); }
+
+    uint16_t dataSize() const { return detail::getLE16(dataSize_); }
+    void setDataSize(uint16_t dataSize) { detail::setLE16(dataSize_, dataSize); }
+
+    uint32_t crc() const { return detail::getLE32(crc_); }
+    void setCrc(uint32_t crc) { detail::setLE32(crc_, crc); }
+
+    uint8_t id_;
+    uint8_t flags_;
+    uint8_t sequence_[2];
+    uint8_t dataSize_[2];
+    uint8_t crc_[4];
+};
+
 }}
 
 #endif
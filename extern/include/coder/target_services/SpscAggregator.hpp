@@ -0,0 +1,66 @@
+#ifndef coder_tgtsvc_SpscAggregator_hpp
+#define coder_tgtsvc_SpscAggregator_hpp
+
+#include <stdint.h>
+#include <utility>
+#include "spsc_fifo.hpp"
+
+namespace coder { namespace tgtsvc {
+
+/*
+ * Aggregator for a producer and a consumer on different threads or an ISR
+ * (C++11), on a detail::spsc_fifo.  put is called by the producer only, and
+ * get and release by the consumer only.  N must be a power of two, and all
+ * N bytes are usable.
+ *
+ * Besides the Aggregator interface, space and contents give the ring as up
+ * to two contiguous pieces, so that a driver can receive into it or send
+ * from it directly.
+ */
+template<size_t N>
+class SpscAggregator
+{
+public:
+	typedef std::pair<uint8_t *, size_t> ArrayRange;
+	typedef typename detail::spsc_fifo<uint8_t, N>::carrays ArrayRanges;
+
+	bool empty() const { return fifo_.empty(); }
+
+	bool full() const { return fifo_.full(); }
+
+	void clear() { fifo_.clear(); }
+
+	size_t count() const { return fifo_.contents_size(); }
+
+	size_t space() const { return N - count(); }
+
+	/* Producer */
+
+	bool put(ArrayRange range) {
+		ArrayRanges s = fifo_.space_carrays();
+		if (s.size() < range.second) return false;
+		return fifo_.put(range.first, range.second) == range.second;
+	}
+
+	ArrayRanges space_ranges() { return fifo_.space_carrays(); }
+
+	void commit(size_t count) { fifo_.contents_add(count); }
+
+	/* Consumer */
+
+	ArrayRange get() {
+		ArrayRanges c = fifo_.contents_carrays();
+		return ArrayRange(c.first_.addr_, c.first_.size_);
+	}
+
+	ArrayRanges contents_ranges() { return fifo_.contents_carrays(); }
+
+	void release(size_t count) { fifo_.contents_remove(count); }
+
+private:
+	detail::spsc_fifo<uint8_t, N> fifo_;
+};
+
+}}
+
+#endif
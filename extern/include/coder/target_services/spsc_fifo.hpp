@@ -0,0 +1,167 @@
+#ifndef coder_tgtsvc_detail_spsc_fifo_hpp
+#define coder_tgtsvc_detail_spsc_fifo_hpp
+
+#include <stddef.h>
+#include <atomic>
+#include <algorithm>
+
+/*
+ * Single producer, single consumer fifo for handing data between an ISR or
+ * comm thread and the application (C++11).  Unlike fifo, it orders memory:
+ * the producer publishes its elements with a release store of its index,
+ * which the consumer reads with an acquire load, and the other way around
+ * for the space the consumer frees.  For push and pop, each side keeps a
+ * copy of the other's index and reloads it only when that copy says the
+ * fifo is full (or empty), so most of them touch no shared cache line
+ * besides the data.  The bulk calls reload it once per call.
+ *
+ * The indices run freely and are masked into the buffer, so N must be a
+ * power of two and all N elements are usable.
+ */
+
+namespace coder { namespace tgtsvc { namespace detail {
+
+enum { SPSC_CACHE_LINE = 64 };
+
+template<typename T, size_t N>
+class spsc_fifo
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "spsc_fifo size must be a power of two");
+
+public:
+
+    typedef T valueType;
+
+    struct carray {
+        T *addr_;
+        size_t size_;
+    };
+
+    /* up to two contiguous pieces of the ring, in order */
+    struct carrays {
+        carray first_;
+        carray second_;
+
+        size_t size() const { return first_.size_ + second_.size_; }
+    };
+
+    spsc_fifo() : head_(0), tailCache_(0), tail_(0), headCache_(0) {}
+
+    /* Either side */
+
+    bool empty() const { return contents_size() == 0; }
+    bool full() const { return contents_size() == N; }
+
+    size_t contents_size() const {
+        /* tail first: head can only have moved on, and at most N past a
+           tail that a third thread saw move meanwhile */
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t count = head_.load(std::memory_order_acquire) - tail;
+        return count < N ? count : N;
+    }
+
+    /* Only while neither side uses the fifo */
+    void clear() {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        tailCache_ = 0;
+        headCache_ = 0;
+    }
+
+    /* Producer */
+
+    bool push(const T &val) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tailCache_ == N) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head - tailCache_ == N) return false;
+        }
+        buff_[head & MASK] = val;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Free space to fill in place, then publish with contents_add */
+    carrays space_carrays() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        tailCache_ = tail_.load(std::memory_order_acquire);
+        return pieces(head, N - (head - tailCache_));
+    }
+
+    void contents_add(size_t count) {
+        head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /* Copies up to count elements in; returns how many */
+    size_t put(const T *src, size_t count) {
+        carrays s = space_carrays();
+        size_t n1 = std::min(count, s.first_.size_);
+        size_t n2 = std::min(count - n1, s.second_.size_);
+        std::copy(src, src + n1, s.first_.addr_);
+        std::copy(src + n1, src + n1 + n2, s.second_.addr_);
+        contents_add(n1 + n2);
+        return n1 + n2;
+    }
+
+    /* Consumer */
+
+    bool pop(T &val) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == headCache_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail == headCache_) return false;
+        }
+        val = buff_[tail & MASK];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Elements to read in place, then free with contents_remove */
+    carrays contents_carrays() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        headCache_ = head_.load(std::memory_order_acquire);
+        return pieces(tail, headCache_ - tail);
+    }
+
+    void contents_remove(size_t count) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /* Copies up to count elements out; returns how many */
+    size_t get(T *dst, size_t count) {
+        carrays c = contents_carrays();
+        size_t n1 = std::min(count, c.first_.size_);
+        size_t n2 = std::min(count - n1, c.second_.size_);
+        std::copy(c.first_.addr_, c.first_.addr_ + n1, dst);
+        std::copy(c.second_.addr_, c.second_.addr_ + n2, dst + n1);
+        contents_remove(n1 + n2);
+        return n1 + n2;
+    }
+
+private:
+    enum { MASK = N - 1 };
+
+    /* producer side */
+    alignas(SPSC_CACHE_LINE) std::atomic<size_t> head_;
+    size_t tailCache_;
+
+    /* consumer side */
+    alignas(SPSC_CACHE_LINE) std::atomic<size_t> tail_;
+    size_t headCache_;
+
+    alignas(SPSC_CACHE_LINE) T buff_[N];
+
+    carrays pieces(size_t index, size_t count) {
+        carrays r;
+        size_t start = index & MASK;
+        r.first_.addr_ = buff_ + start;
+        r.first_.size_ = std::min(count, N - start);
+        r.second_.addr_ = buff_;
+        r.second_.size_ = count - r.first_.size_;
+        return r;
+    }
+};
+
+}}}
+
+#endif
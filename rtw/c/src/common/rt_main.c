@@ -22,6 +22,17 @@
  *   MODEL - Model name
  *   NUMST - Number of sample times
  *
+ * Optional Defines:
+ *
+ *   RT_LINUX_SCHED     - Pace the model in real time on Linux, see "Linux
+ *                        real-time scheduling" below.
+ *   RT_STEP_TIMING     - Record the execution time, start latency and
+ *                        overruns of the steps of each tid (rt_steptiming.c)
+ *                        and print them when the model terminates.
+ *   RT_OVERRUN_DEGRADE - On an overrun, skip the step that is due and carry
+ *                        on, instead of stopping the model.  The skipped
+ *                        steps are counted and printed at termination.
+ *
  */
 
 /*==================*
@@ -82,6 +93,11 @@ your application needs.
  * Includes *
  *==========*/
 
+#if defined(RT_LINUX_SCHED) && !defined(_POSIX_C_SOURCE)
+/* CLOCK_MONOTONIC, TIMER_ABSTIME and clock_nanosleep, before any include */
+# define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "rtwtypes.h"
 
 #if !defined(INTEGER_CODE) || INTEGER_CODE == 0
@@ -106,6 +122,16 @@ extern "C" {
 
 #include "ext_work.h"
 
+#ifdef RT_LINUX_SCHED
+#include <time.h>
+#include <sys/mman.h>
+#include "rtw_linux.h"
+#endif
+
+#ifdef RT_STEP_TIMING
+#include "rt_steptiming.h"
+#endif
+
 #ifdef MODEL_STEP_FCN_CONTROL_USED
 #error The static version of rt_main.c does not support model step function prototype control.
 #endif
@@ -145,6 +171,108 @@ static uint_T OverrunFlags[NUMST];
 static uint_T eventFlags[NUMST]; 
 #endif
 
+#ifdef RT_OVERRUN_DEGRADE
+static uint_T SkippedSteps[NUMST]; /* steps skipped after an overrun */
+#endif
+
+#ifdef RT_STEP_TIMING
+/*
+ * Time at which the current step of each tid was due, known only when the
+ * model is paced by RT_LINUX_SCHED.
+ */
+static uint32_T StepRelease[NUMST];
+# ifdef RT_LINUX_SCHED
+#  define STEP_HAS_RELEASE true
+# else
+#  define STEP_HAS_RELEASE false
+# endif
+# define STEP_TIMING_START(start) (start) = rt_StepTimingNow()
+# define STEP_TIMING_END(tid,start) \
+    rt_StepTimingRecord((tid), StepRelease[(tid)], STEP_HAS_RELEASE, \
+                        (start), rt_StepTimingNow())
+#else
+# define STEP_TIMING_START(start)   /* do nothing */
+# define STEP_TIMING_END(tid,start) /* do nothing */
+#endif
+
+/*===============================*
+ * Linux real-time scheduling    *
+ *===============================*/
+
+#ifdef RT_LINUX_SCHED
+/*
+ * The base rate is paced by sleeping until absolute deadlines on
+ * CLOCK_MONOTONIC, so that the time taken by a step does not accumulate
+ * as drift.  The process memory is locked so that page faults do not add
+ * latency.  In the MULTITASKING case each subrate tid runs in its own
+ * thread, registered with rtw_register_task_ex, and is triggered by the
+ * base rate with rtw_trigger_task.  Priorities are rate monotonic: tid i
+ * runs under SCHED_FIFO at RT_SCHED_PRIORITY - i.
+ *
+ *   RT_SCHED_PRIORITY       - SCHED_FIFO priority of the base rate,
+ *                             default 80.  0 keeps the default policy.
+ *   RT_SCHED_CPUS           - Comma-separated cores; tid i is pinned to the
+ *                             (i modulo count)th one.  Default: no pinning.
+ *   RT_SCHED_BASE_PERIOD_NS - Base period in nanoseconds.  Default: the
+ *                             step size of the model.
+ *
+ * Real-time priorities and memory locking need privileges; without them a
+ * warning is printed and the model runs paced but unprivileged.
+ */
+#ifndef RT_SCHED_PRIORITY
+# define RT_SCHED_PRIORITY 80
+#endif
+
+#ifdef RT_SCHED_CPUS
+static const int rtSchedCpus[] = { RT_SCHED_CPUS };
+# define RT_SCHED_CPU(tid) \
+    rtSchedCpus[(tid) % (int)(sizeof(rtSchedCpus)/sizeof(rtSchedCpus[0]))]
+#else
+# define RT_SCHED_CPU(tid) (-1)
+#endif
+
+#if RT_SCHED_PRIORITY > 0
+# define RT_SCHED_TID_PRIORITY(tid) \
+    ((RT_SCHED_PRIORITY - (tid)) > 1 ? (RT_SCHED_PRIORITY - (tid)) : 1)
+#else
+# define RT_SCHED_TID_PRIORITY(tid) 0
+#endif
+
+#define RT_NSEC_PER_SEC 1000000000L
+
+static long            rtSchedPeriodNs;    /* base period                 */
+static struct timespec rtSchedDeadline;    /* start of the next base step */
+
+#if defined(MULTITASKING)
+static void            *rtSubrateTask[NUMST];   /* from rtw_register_task_ex */
+static int_T           rtSubrateTid[NUMST];     /* argument of each task     */
+static boolean_T       rtSubrateTriggered[NUMST]; /* done not yet waited for */
+#endif
+
+#endif /* RT_LINUX_SCHED */
+
+/* Function: rt_CountOverrun =================================================
+ *
+ * Abstract:
+ *   Accounts for an overrun of sample time index 'tid', whose due step is
+ *   skipped when 'skipped'.
+ */
+#if defined(RT_OVERRUN_DEGRADE) || defined(RT_STEP_TIMING)
+static void rt_CountOverrun(int tid, boolean_T skipped)
+{
+#ifdef RT_OVERRUN_DEGRADE
+    if (skipped) SkippedSteps[tid]++;
+#endif
+#ifdef RT_STEP_TIMING
+    rt_StepTimingOverrun(tid, skipped);
+#endif
+    (void)tid;
+    (void)skipped;
+}
+#else
+# define rt_CountOverrun(tid,skipped) /* do nothing */
+#endif
+
 /*===================*
  * Visible functions *
  *===================*/
@@ -160,13 +288,25 @@ static uint_T eventFlags[NUMST];
  */
 static void rt_OneStep(void)
 {
+#ifdef RT_STEP_TIMING
+    uint32_T start;
+#endif
+
     /* Disable interrupts here */
 
     /***********************************************
      * Check and see if base step time is too fast *
      ***********************************************/
     if (OverrunFlags[0]++) {
+#ifdef RT_OVERRUN_DEGRADE
+        /* the step still running keeps the flag */
+        OverrunFlags[0]--;
+        rt_CountOverrun(0, true);
+        return;
+#else
+        rt_CountOverrun(0, false);
         rtmSetErrorStatus(RT_MDL, "Overrun");
+#endif
     }
 
     /*************************************************
@@ -184,7 +324,9 @@ static void rt_OneStep(void)
     /**************
      * Step model *
      **************/
+    STEP_TIMING_START(start);
     MODEL_STEP();
+    STEP_TIMING_END(0, start);
 
     /* Get model outputs here */
 
@@ -201,6 +343,106 @@ static void rt_OneStep(void)
 
 } /* end rtOneStep */
 
+#elif defined(RT_LINUX_SCHED) /* multitask, one thread per tid */
+
+/* Function: rt_SubrateStep ===================================================
+ *
+ * Abstract:
+ *   Body of the thread of a subrate tid.  eventFlags[tid] is set by the base
+ *   rate when it triggers the tid and cleared once the step is complete.
+ */
+static void rt_SubrateStep(void *arg)
+{
+    int_T i = *(const int_T *)arg;
+#ifdef RT_STEP_TIMING
+    uint32_T start;
+#endif
+
+    /* Set model inputs associated with subrate here */
+
+    STEP_TIMING_START(start);
+    MODEL_STEP(i);
+    STEP_TIMING_END(i, start);
+
+    /* Get model outputs associated with subrate here */
+
+    __atomic_store_n(&eventFlags[i], 0U, __ATOMIC_RELEASE);
+}
+
+/* Function: rtOneStep ========================================================
+ *
+ * Abstract:
+ *   Perform one step of the base rate, then trigger the thread of each
+ *   subrate that has a hit.  A subrate with a hit whose previous step is
+ *   still running has overrun.
+ */
+static void rt_OneStep(void)
+{
+    boolean_T hit[NUMST];
+    int i;
+#ifdef RT_STEP_TIMING
+    uint32_T start;
+#endif
+
+    if (rtmGetErrorStatus(RT_MDL) != NULL) {
+        return;
+    }
+
+    /*************************************************
+     * Find the subrate hits and check their overrun *
+     *************************************************/
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        hit[i] = (boolean_T)rtmStepTask(RT_MDL,i);
+        if (hit[i] && __atomic_load_n(&eventFlags[i], __ATOMIC_ACQUIRE)) {
+#ifdef RT_OVERRUN_DEGRADE
+            /* let the step still running finish, skip this one */
+            rt_CountOverrun(i, true);
+            hit[i] = false;
+#else
+            rt_CountOverrun(i, false);
+            OverrunFlags[i]++;
+            /* Sampling too fast */
+            rtmSetErrorStatus(RT_MDL, "Overrun");
+            return;
+#endif
+        }
+        if (++rtmTaskCounter(RT_MDL,i) == rtmCounterLimit(RT_MDL,i))
+            rtmTaskCounter(RT_MDL, i) = 0;
+    }
+
+    /* Set model inputs associated with base rate here */
+
+    /*******************************************
+     * Step the model for the base sample time *
+     *******************************************/
+    STEP_TIMING_START(start);
+    MODEL_STEP(0);
+    STEP_TIMING_END(0, start);
+
+    /* Get model outputs associated with base rate here */
+
+    /***************************************************
+     * Release the subrates, which preempt each other  *
+     * by priority on a shared core                    *
+     ***************************************************/
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        if (!hit[i]) continue;
+        if (rtSubrateTriggered[i]) {
+            /* collect the done post of the step that has just finished */
+            rtw_waitfor_task(rtSubrateTask[i]);
+        }
+        eventFlags[i] = 1U;
+#ifdef RT_STEP_TIMING
+        StepRelease[i] = StepRelease[0]; /* due with this base step */
+#endif
+        rtSubrateTriggered[i] = true;
+        rtw_trigger_task(rtSubrateTask[i]);
+    }
+
+    rtExtModeCheckEndTrigger();
+
+} /* end rtOneStep */
+
 #else /* multitask */
 
 /* Function: rtOneStep ========================================================
@@ -219,6 +461,9 @@ static void rt_OneStep(void)
 static void rt_OneStep(void)
 {
     int i;
+#ifdef RT_STEP_TIMING
+    uint32_T start;
+#endif
 
     /* Disable interrupts here */
 
@@ -226,7 +471,15 @@ static void rt_OneStep(void)
      * Check and see if base step time is too fast *
      ***********************************************/
     if (OverrunFlags[0]++) {
+#ifdef RT_OVERRUN_DEGRADE
+        /* the step still running keeps the flag */
+        OverrunFlags[0]--;
+        rt_CountOverrun(0, true);
+        return;
+#else
+        rt_CountOverrun(0, false);
         rtmSetErrorStatus(RT_MDL, "Overrun");
+#endif
     }
 
     /*************************************************
@@ -245,11 +498,18 @@ static void rt_OneStep(void)
      *************************************************/
     for (i = FIRST_TID+1; i < NUMST; i++) {
         if (rtmStepTask(RT_MDL,i) && eventFlags[i]++) {
+#ifdef RT_OVERRUN_DEGRADE
+            /* the pending step of "i" still runs, skip this one */
+            eventFlags[i]--;
+            rt_CountOverrun(i, true);
+#else
+            rt_CountOverrun(i, false);
             OverrunFlags[0]--;
             OverrunFlags[i]++;
             /* Sampling too fast */
             rtmSetErrorStatus(RT_MDL, "Overrun");
             return;
+#endif
         }
         if (++rtmTaskCounter(RT_MDL,i) == rtmCounterLimit(RT_MDL,i))
             rtmTaskCounter(RT_MDL, i) = 0;
@@ -260,7 +520,9 @@ static void rt_OneStep(void)
     /*******************************************
      * Step the model for the base sample time *
      *******************************************/
+    STEP_TIMING_START(start);
     MODEL_STEP(0);
+    STEP_TIMING_END(0, start);
 
     /* Get model outputs associated with base rate here */
 
@@ -287,7 +549,9 @@ static void rt_OneStep(void)
             /******************************************
              * Step the model for sample time "i" *
              ******************************************/
+            STEP_TIMING_START(start);
             MODEL_STEP(i);
+            STEP_TIMING_END(i, start);
 
             /* Get model outputs associated with subrate here */
             
@@ -308,6 +572,143 @@ static void rt_OneStep(void)
 
 #endif /* MULTITASKING */
 
+#ifdef RT_LINUX_SCHED
+
+/* Function: rt_SchedInit =====================================================
+ *
+ * Abstract:
+ *   Locks the process memory, schedules the calling thread as the base rate
+ *   and, when MULTITASKING, starts a thread per subrate tid.
+ */
+static void rt_SchedInit(void)
+{
+    int s;
+#if defined(MULTITASKING)
+    int i;
+#endif
+
+#ifdef RT_SCHED_BASE_PERIOD_NS
+    rtSchedPeriodNs = (long)(RT_SCHED_BASE_PERIOD_NS);
+#else
+    rtSchedPeriodNs = (long)(rtmGetStepSize(RT_MDL)*1e9 + 0.5);
+#endif
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        (void)printf("warning: could not lock the process memory\n");
+    }
+
+    s = rtw_set_thread_sched(pthread_self(),
+                             RT_SCHED_TID_PRIORITY(0), RT_SCHED_CPU(0));
+    if (s != 0) {
+        (void)printf("warning: could not set the real-time scheduling "
+                     "of the base rate (error %d)\n", s);
+    }
+
+#if defined(MULTITASKING)
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        rtSubrateTid[i]       = i;
+        rtSubrateTriggered[i] = false;
+        rtSubrateTask[i] = rtw_register_task_ex(rt_SubrateStep,
+                                                &rtSubrateTid[i],
+                                                RT_SCHED_TID_PRIORITY(i),
+                                                RT_SCHED_CPU(i));
+    }
+#endif
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &rtSchedDeadline);
+}
+
+/* Function: rt_SchedWaitForStep ==============================================
+ *
+ * Abstract:
+ *   Sleeps until the start of the next base step.  If that is already past,
+ *   as after an external mode pause, the schedule restarts from now.
+ */
+static void rt_SchedWaitForStep(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec > rtSchedDeadline.tv_sec ||
+        (now.tv_sec == rtSchedDeadline.tv_sec &&
+         now.tv_nsec > rtSchedDeadline.tv_nsec)) {
+        rtSchedDeadline = now;
+    } else {
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                               &rtSchedDeadline, NULL) != 0) {
+            /* interrupted by a signal */
+        }
+    }
+#ifdef RT_STEP_TIMING
+    StepRelease[0] = (uint32_T)((unsigned long)rtSchedDeadline.tv_sec *
+                                1000000000UL +
+                                (unsigned long)rtSchedDeadline.tv_nsec);
+#endif
+}
+
+/* Function: rt_SchedEndStep ==================================================
+ *
+ * Abstract:
+ *   Advances the deadline by one base period.  A base step that ends after
+ *   the start of the next one has overrun.  With RT_OVERRUN_DEGRADE the
+ *   base steps whose start has passed are skipped instead.
+ */
+static void rt_SchedEndStep(void)
+{
+    struct timespec now;
+
+    rtSchedDeadline.tv_nsec += rtSchedPeriodNs;
+    while (rtSchedDeadline.tv_nsec >= RT_NSEC_PER_SEC) {
+        rtSchedDeadline.tv_nsec -= RT_NSEC_PER_SEC;
+        rtSchedDeadline.tv_sec++;
+    }
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec > rtSchedDeadline.tv_sec ||
+        (now.tv_sec == rtSchedDeadline.tv_sec &&
+         now.tv_nsec > rtSchedDeadline.tv_nsec)) {
+#ifdef RT_OVERRUN_DEGRADE
+        do {
+            rt_CountOverrun(0, true);
+            rtSchedDeadline.tv_nsec += rtSchedPeriodNs;
+            while (rtSchedDeadline.tv_nsec >= RT_NSEC_PER_SEC) {
+                rtSchedDeadline.tv_nsec -= RT_NSEC_PER_SEC;
+                rtSchedDeadline.tv_sec++;
+            }
+        } while (now.tv_sec > rtSchedDeadline.tv_sec ||
+                 (now.tv_sec == rtSchedDeadline.tv_sec &&
+                  now.tv_nsec > rtSchedDeadline.tv_nsec));
+#else
+        rt_CountOverrun(0, false);
+        OverrunFlags[0]++;
+        if (rtmGetErrorStatus(RT_MDL) == NULL) {
+            rtmSetErrorStatus(RT_MDL, "Overrun");
+        }
+#endif
+    }
+}
+
+/* Function: rt_SchedTerm =====================================================
+ *
+ * Abstract:
+ *   Waits for the subrate steps still running and stops their threads.
+ */
+static void rt_SchedTerm(void)
+{
+#if defined(MULTITASKING)
+    int i;
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        if (rtSubrateTriggered[i]) {
+            rtw_waitfor_task(rtSubrateTask[i]);
+        }
+        rtw_deregister_task(rtSubrateTask[i]);
+        rtSubrateTask[i] = NULL;
+    }
+#endif
+}
+
+#endif /* RT_LINUX_SCHED */
+
 /* Function: rt_InitModel ====================================================
  * 
  * Abstract: 
@@ -326,6 +727,12 @@ static void rt_InitModel(void)
     OverrunFlags[0] = 0;
     eventFlags[0] = 0;
 #endif
+#ifdef RT_OVERRUN_DEGRADE
+    (void)memset(SkippedSteps, 0, sizeof(SkippedSteps));
+#endif
+#ifdef RT_STEP_TIMING
+    rt_StepTimingReset();
+#endif
 
     /************************
      * Initialize the model *
@@ -342,6 +749,21 @@ static void rt_InitModel(void)
 static int rt_TermModel(void)
 {
     MODEL_TERMINATE();
+
+#ifdef RT_STEP_TIMING
+    rt_StepTimingPrint(NUMST);
+#endif
+#ifdef RT_OVERRUN_DEGRADE
+    {
+        int i;
+        for (i = 0; i < NUMST; i++) {
+            if (SkippedSteps[i]) {
+                (void)printf("%u steps skipped after overruns for sample "
+                             "time index %d.\n", SkippedSteps[i], i);
+            }
+        }
+    }
+#endif
     
     {
         const char *errStatus = (const char *) (rtmGetErrorStatus(RT_MDL));
@@ -407,6 +829,10 @@ int main(int argc, const char *argv[])
 
     (void)printf("\n** starting the model **\n");
 
+#ifdef RT_LINUX_SCHED
+    rt_SchedInit();
+#endif
+
     /***********************************************************************
      * Execute (step) the model.  You may also attach rtOneStep to an ISR, *
      * in which case you replace the call to rtOneStep with a call to a    *
@@ -429,9 +855,19 @@ int main(int argc, const char *argv[])
                          NUMST,
                          (boolean_T *)&rtmGetStopRequested(RT_MDL));
         
+#ifdef RT_LINUX_SCHED
+        rt_SchedWaitForStep();
         rt_OneStep();
+        rt_SchedEndStep();
+#else
+        rt_OneStep();
+#endif
     }
 
+#ifdef RT_LINUX_SCHED
+    rt_SchedTerm();
+#endif
+
     /*******************************
      * Cleanup and exit (optional) *
      *******************************/
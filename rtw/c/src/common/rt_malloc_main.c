@@ -20,6 +20,8 @@
  *      MULTITASKING    - Optional. (use MT for a synonym).
  *	SAVEFILE        - Optional (non-quoted) name of .mat file to create. 
  *			  Default is <MODEL>.mat
+ *      RT_LINUX_SCHED  - Optional. Pace the model in real time on Linux, see
+ *                        "Linux real-time scheduling" below.
  */
 
 /*==================*
@@ -80,6 +82,11 @@ the 'Use dynamic memory allocation for model initialization' option.
  * Includes *
  *==========*/
 
+#if defined(RT_LINUX_SCHED) && !defined(_POSIX_C_SOURCE)
+/* CLOCK_MONOTONIC, TIMER_ABSTIME and clock_nanosleep, before any include */
+# define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "rtwtypes.h"
 #if !defined(INTEGER_CODE) || INTEGER_CODE == 0
 # include <stdio.h>    /* optional for printf */
@@ -102,6 +109,12 @@ extern "C" {
 #endif
 #include "ext_work.h"
 
+#ifdef RT_LINUX_SCHED
+#include <time.h>
+#include <sys/mman.h>
+#include "rtw_linux.h"
+#endif
+
 #ifdef MODEL_STEP_FCN_CONTROL_USED
 #error The static version of rt_malloc_main.c does not support model step function prototype control.
 #endif
@@ -147,6 +160,57 @@ static uint_T eventFlags[NUMST];
 
 const char *RT_MEMORY_ALLOCATION_ERROR = "memory allocation error"; 
 
+/*===============================*
+ * Linux real-time scheduling    *
+ *===============================*/
+
+#ifdef RT_LINUX_SCHED
+/*
+ * Same scheduling as rt_main.c: the base rate sleeps until absolute
+ * CLOCK_MONOTONIC deadlines with the process memory locked, and with
+ * MULTITASKING each subrate tid runs in its own thread under SCHED_FIFO at
+ * RT_SCHED_PRIORITY - i, triggered by the base rate.
+ *
+ *   RT_SCHED_PRIORITY       - SCHED_FIFO priority of the base rate,
+ *                             default 80.  0 keeps the default policy.
+ *   RT_SCHED_CPUS           - Comma-separated cores; tid i is pinned to the
+ *                             (i modulo count)th one.  Default: no pinning.
+ *   RT_SCHED_BASE_PERIOD_NS - Base period in nanoseconds.  Default: the
+ *                             step size of the model.
+ */
+#ifndef RT_SCHED_PRIORITY
+# define RT_SCHED_PRIORITY 80
+#endif
+
+#ifdef RT_SCHED_CPUS
+static const int rtSchedCpus[] = { RT_SCHED_CPUS };
+# define RT_SCHED_CPU(tid) \
+    rtSchedCpus[(tid) % (int)(sizeof(rtSchedCpus)/sizeof(rtSchedCpus[0]))]
+#else
+# define RT_SCHED_CPU(tid) (-1)
+#endif
+
+#if RT_SCHED_PRIORITY > 0
+# define RT_SCHED_TID_PRIORITY(tid) \
+    ((RT_SCHED_PRIORITY - (tid)) > 1 ? (RT_SCHED_PRIORITY - (tid)) : 1)
+#else
+# define RT_SCHED_TID_PRIORITY(tid) 0
+#endif
+
+#define RT_NSEC_PER_SEC 1000000000L
+
+static long            rtSchedPeriodNs;    /* base period                 */
+static struct timespec rtSchedDeadline;    /* start of the next base step */
+
+#if defined(MULTITASKING)
+static RT_MDL_TYPE     *rtSchedModel;           /* stepped by the subrates   */
+static void            *rtSubrateTask[NUMST];   /* from rtw_register_task_ex */
+static int_T           rtSubrateTid[NUMST];     /* argument of each task     */
+static boolean_T       rtSubrateTriggered[NUMST]; /* done not yet waited for */
+#endif
+
+#endif /* RT_LINUX_SCHED */
+
 /*=================*
  * Local functions *
  *=================*/
@@ -203,6 +267,86 @@ static void rt_OneStep(RT_MDL_TYPE *S)
 
 } /* end rtOneStep */
 
+#elif defined(RT_LINUX_SCHED) /* multitask, one thread per tid */
+
+/* Function: rt_SubrateStep ===================================================
+ *
+ * Abstract:
+ *   Body of the thread of a subrate tid.  eventFlags[tid] is set by the base
+ *   rate when it triggers the tid and cleared once the step is complete.
+ */
+static void rt_SubrateStep(void *arg)
+{
+    int_T i = *(const int_T *)arg;
+
+    /* Set model inputs associated with subrate here */
+
+    MODEL_STEP(rtSchedModel,i);
+
+    /* Get model outputs associated with subrate here */
+
+    __atomic_store_n(&eventFlags[i], 0U, __ATOMIC_RELEASE);
+}
+
+/* Function: rtOneStep ========================================================
+ *
+ * Abstract:
+ *   Perform one step of the base rate, then trigger the thread of each
+ *   subrate that has a hit.  A subrate with a hit whose previous step is
+ *   still running has overrun.
+ */
+static void rt_OneStep(RT_MDL_TYPE *S)
+{
+    boolean_T hit[NUMST];
+    int_T i;
+
+    if (rtmGetErrorStatus(S) != NULL) {
+        return;
+    }
+
+    /*************************************************
+     * Find the subrate hits and check their overrun *
+     *************************************************/
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        hit[i] = (boolean_T)rtmStepTask(S,i);
+        if (hit[i] && __atomic_load_n(&eventFlags[i], __ATOMIC_ACQUIRE)) {
+            OverrunFlags[i]++;
+            /* Sampling too fast */
+            rtmSetErrorStatus(S, "Overrun");
+            return;
+        }
+        if (++rtmTaskCounter(S,i) == rtmCounterLimit(S,i))
+            rtmTaskCounter(S, i) = 0;
+    }
+
+    /* Set model inputs associated with base rate here */
+
+    /*******************************************
+     * Step the model for the base sample time *
+     *******************************************/
+    MODEL_STEP(S,0);
+
+    /* Get model outputs associated with base rate here */
+
+    /***************************************************
+     * Release the subrates, which preempt each other  *
+     * by priority on a shared core                    *
+     ***************************************************/
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        if (!hit[i]) continue;
+        if (rtSubrateTriggered[i]) {
+            /* collect the done post of the step that has just finished */
+            rtw_waitfor_task(rtSubrateTask[i]);
+        }
+        eventFlags[i] = 1U;
+        rtSubrateTriggered[i] = true;
+        rtw_trigger_task(rtSubrateTask[i]);
+    }
+
+    rtExtModeCheckEndTrigger();
+
+} /* end rtOneStep */
+
 #else /* multitask */
 
 /* Function: rtOneStep ========================================================
@@ -313,6 +457,124 @@ static void rt_OneStep(RT_MDL_TYPE *S)
 
 #endif /* MULTITASKING */
 
+#ifdef RT_LINUX_SCHED
+
+/* Function: rt_SchedInit =====================================================
+ *
+ * Abstract:
+ *   Locks the process memory, schedules the calling thread as the base rate
+ *   and, when MULTITASKING, starts a thread per subrate tid of model 'S'.
+ */
+static void rt_SchedInit(RT_MDL_TYPE *S)
+{
+    int s;
+#if defined(MULTITASKING)
+    int_T i;
+#endif
+
+#ifdef RT_SCHED_BASE_PERIOD_NS
+    rtSchedPeriodNs = (long)(RT_SCHED_BASE_PERIOD_NS);
+#else
+    rtSchedPeriodNs = (long)(rtmGetStepSize(S)*1e9 + 0.5);
+#endif
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        (void)printf("warning: could not lock the process memory\n");
+    }
+
+    s = rtw_set_thread_sched(pthread_self(),
+                             RT_SCHED_TID_PRIORITY(0), RT_SCHED_CPU(0));
+    if (s != 0) {
+        (void)printf("warning: could not set the real-time scheduling "
+                     "of the base rate (error %d)\n", s);
+    }
+
+#if defined(MULTITASKING)
+    rtSchedModel = S;
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        rtSubrateTid[i]       = i;
+        rtSubrateTriggered[i] = false;
+        rtSubrateTask[i] = rtw_register_task_ex(rt_SubrateStep,
+                                                &rtSubrateTid[i],
+                                                RT_SCHED_TID_PRIORITY(i),
+                                                RT_SCHED_CPU(i));
+    }
+#endif
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &rtSchedDeadline);
+}
+
+/* Function: rt_SchedWaitForStep ==============================================
+ *
+ * Abstract:
+ *   Sleeps until the start of the next base step.  If that is already past,
+ *   as after an external mode pause, the schedule restarts from now.
+ */
+static void rt_SchedWaitForStep(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec > rtSchedDeadline.tv_sec ||
+        (now.tv_sec == rtSchedDeadline.tv_sec &&
+         now.tv_nsec > rtSchedDeadline.tv_nsec)) {
+        rtSchedDeadline = now;
+    } else {
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                               &rtSchedDeadline, NULL) != 0) {
+            /* interrupted by a signal */
+        }
+    }
+}
+
+/* Function: rt_SchedEndStep ==================================================
+ *
+ * Abstract:
+ *   Advances the deadline by one base period.  A base step of model 'S'
+ *   that ends after the start of the next one has overrun.
+ */
+static void rt_SchedEndStep(RT_MDL_TYPE *S)
+{
+    struct timespec now;
+
+    rtSchedDeadline.tv_nsec += rtSchedPeriodNs;
+    while (rtSchedDeadline.tv_nsec >= RT_NSEC_PER_SEC) {
+        rtSchedDeadline.tv_nsec -= RT_NSEC_PER_SEC;
+        rtSchedDeadline.tv_sec++;
+    }
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec > rtSchedDeadline.tv_sec ||
+        (now.tv_sec == rtSchedDeadline.tv_sec &&
+         now.tv_nsec > rtSchedDeadline.tv_nsec)) {
+        OverrunFlags[0]++;
+        if (rtmGetErrorStatus(S) == NULL) {
+            rtmSetErrorStatus(S, "Overrun");
+        }
+    }
+}
+
+/* Function: rt_SchedTerm =====================================================
+ *
+ * Abstract:
+ *   Waits for the subrate steps still running and stops their threads.
+ */
+static void rt_SchedTerm(void)
+{
+#if defined(MULTITASKING)
+    int_T i;
+    for (i = FIRST_TID+1; i < NUMST; i++) {
+        if (rtSubrateTriggered[i]) {
+            rtw_waitfor_task(rtSubrateTask[i]);
+        }
+        rtw_deregister_task(rtSubrateTask[i]);
+        rtSubrateTask[i] = NULL;
+    }
+#endif
+}
+
+#endif /* RT_LINUX_SCHED */
+
 /* Function: rt_InitModel ====================================================
  * 
  * Abstract: 
@@ -440,6 +702,10 @@ int_T main(int_T argc, const char *argv[])
 
     rt_InitModel(S);
 
+#ifdef RT_LINUX_SCHED
+    rt_SchedInit(S);
+#endif
+
     /***********************************************************************
      * Execute (step) the model.  You may also attach rtOneStep to an ISR, *
      * in which case you replace the call to rtOneStep with a call to a    *
@@ -460,9 +726,19 @@ int_T main(int_T argc, const char *argv[])
                          NUMST,
                          (boolean_T *)&rtmGetStopRequested(S));
         
+#ifdef RT_LINUX_SCHED
+        rt_SchedWaitForStep();
+        rt_OneStep(S);
+        rt_SchedEndStep(S);
+#else
         rt_OneStep(S);        
+#endif
     }
 
+#ifdef RT_LINUX_SCHED
+    rt_SchedTerm();
+#endif
+
     /********************
      * Cleanup and exit *
      ********************/
@@ -0,0 +1,246 @@
+/*
+ * File: ext_compress.c
+ *
+ * Abstract:
+ *  LZ4 block format compressor and decompressor for external mode parameter
+ *  packets.  It does not depend on the transport, so the serial, custom and
+ *  rtiostream transports all get the same packets.
+ *
+ *  A block is a sequence of
+ *      token | [literal length bytes] | literals | offset | [match length bytes]
+ *  where the token holds the literal length and the match length - 4 in
+ *  its high and low nibble (15 meaning more bytes follow, each adding up to
+ *  255) and the offset is 2 bytes, little endian, back into the output.
+ *  The last sequence has literals only, and holds at least the last 5
+ *  bytes; no match starts in the last 12 bytes.
+ *
+ *  The compressor finds matches through a table of the last position of
+ *  each hash of 4 bytes, which needs no memory besides the table on the
+ *  stack.  It favors speed over ratio: parameter data compresses mostly
+ *  through runs and repeated values, which it finds.
+ */
+
+#include <string.h>
+
+#include "rtwtypes.h"
+
+#include "ext_types.h"
+#include "ext_share.h"
+#include "ext_compress.h"
+
+#define LZ_MIN_MATCH     4
+#define LZ_LAST_LITERALS 5      /* bytes at the end that are literals   */
+#define LZ_MF_LIMIT      12     /* no match starts in the last 12 bytes */
+#define LZ_MAX_OFFSET    65535
+#define LZ_HASH_LOG      12
+#define LZ_HASH_SIZE     (1 << LZ_HASH_LOG)
+
+/* Function: LZRead32 ==========================================================
+ * Abstract:
+ *  The 4 bytes at p, whatever their alignment.
+ */
+PRIVATE uint32_T LZRead32(const uint8_T *p)
+{
+    uint32_T v;
+    (void)memcpy(&v, p, sizeof(v));
+    return(v);
+} /* end LZRead32 */
+
+/* Function: LZHash ============================================================
+ * Abstract:
+ *  Hash of the 4 bytes at p.
+ */
+PRIVATE int_T LZHash(const uint8_T *p)
+{
+    return((int_T)((LZRead32(p) * 2654435761U) >> (32 - LZ_HASH_LOG)));
+} /* end LZHash */
+
+/* Function: LZPutLength =======================================================
+ * Abstract:
+ *  Write the bytes that follow a token nibble of 15 for a length of len,
+ *  at dst[op].  Return the new op.
+ */
+PRIVATE int_T LZPutLength(uint8_T *dst, int_T op, int_T len)
+{
+    len -= 15;
+    while (len >= 255) {
+        dst[op++] = 255;
+        len -= 255;
+    }
+    dst[op++] = (uint8_T)len;
+    return(op);
+} /* end LZPutLength */
+
+/* Function: LZPutSequence =====================================================
+ * Abstract:
+ *  Write the nLit literals at lit, then a match of mLen bytes (0 for none)
+ *  at offset bytes back, at dst[op].  Return the new op, or -1 if that
+ *  would not fit in dstSize bytes.
+ */
+PRIVATE int_T LZPutSequence(uint8_T       *dst,
+                            int_T         op,
+                            int_T         dstSize,
+                            const uint8_T *lit,
+                            int_T         nLit,
+                            int_T         offset,
+                            int_T         mLen)
+{
+    int_T   mCode = (mLen > 0) ? mLen - LZ_MIN_MATCH : 0;
+    uint8_T token;
+
+    /* token, literals, offset and the lengths, counted generously */
+    if (op + 1 + nLit + nLit/255 + 1 + 2 + mCode/255 + 1 > dstSize) {
+        return(-1);
+    }
+
+    token = (uint8_T)(((nLit < 15) ? nLit : 15) << 4);
+    if (mLen > 0) token |= (uint8_T)((mCode < 15) ? mCode : 15);
+    dst[op++] = token;
+
+    if (nLit >= 15) op = LZPutLength(dst, op, nLit);
+    (void)memcpy(dst + op, lit, nLit);
+    op += nLit;
+
+    if (mLen > 0) {
+        dst[op++] = (uint8_T)(offset & 0xFF);
+        dst[op++] = (uint8_T)(offset >> 8);
+        if (mCode >= 15) op = LZPutLength(dst, op, mCode);
+    }
+    return(op);
+} /* end LZPutSequence */
+
+
+/*==================*
+ * Visible routines *
+ *==================*/
+
+
+/* Function: ExtCompress =======================================================
+ * Abstract:
+ *  Compress the nBytes at src into dst, which holds dstSize bytes.
+ *
+ *  Returns the size of the compressed data, or 0 if it would not be smaller
+ *  than nBytes (send the data raw then).
+ */
+PUBLIC int_T ExtCompress(const uint8_T *src,
+                         int_T         nBytes,
+                         uint8_T       *dst,
+                         int_T         dstSize)
+{
+    int_T table[LZ_HASH_SIZE];
+    int_T ip     = 0;
+    int_T anchor = 0;
+    int_T op     = 0;
+    int_T i;
+
+    if (dstSize > nBytes - 1) dstSize = nBytes - 1; /* must gain a byte */
+
+    if (nBytes > LZ_MF_LIMIT) {
+        const int_T mfLimit    = nBytes - LZ_MF_LIMIT;
+        const int_T matchLimit = nBytes - LZ_LAST_LITERALS;
+        int_T       nMisses    = 0;
+
+        for (i=0; i<LZ_HASH_SIZE; i++) table[i] = -1;
+
+        while (ip <= mfLimit) {
+            int_T h   = LZHash(src + ip);
+            int_T ref = table[h];
+            int_T mLen;
+
+            table[h] = ip;
+            if ((ref < 0) || (ip - ref > LZ_MAX_OFFSET) ||
+                (LZRead32(src + ref) != LZRead32(src + ip))) {
+                /* skip faster through data that does not compress */
+                ip += 1 + (nMisses++ >> 6);
+                continue;
+            }
+            nMisses = 0;
+
+            /* extend the match backwards, then forwards */
+            while ((ip > anchor) && (ref > 0) && (src[ip-1] == src[ref-1])) {
+                ip--;
+                ref--;
+            }
+            mLen = LZ_MIN_MATCH;
+            while ((ip + mLen < matchLimit) && (src[ref+mLen] == src[ip+mLen])) {
+                mLen++;
+            }
+
+            op = LZPutSequence(dst, op, dstSize, src + anchor, ip - anchor,
+                               ip - ref, mLen);
+            if (op < 0) return(0);
+
+            ip    += mLen;
+            anchor = ip;
+            if (ip <= mfLimit) table[LZHash(src + ip - 2)] = ip - 2;
+        }
+    }
+
+    /* the rest is literals */
+    op = LZPutSequence(dst, op, dstSize, src + anchor, nBytes - anchor, 0, 0);
+    return((op < 0) ? 0 : op);
+} /* end ExtCompress */
+
+
+/* Function: ExtDecompress =====================================================
+ * Abstract:
+ *  Decompress the nBytes at src into the dstSize bytes at dst.
+ *
+ *  EXT_NO_ERROR is returned on success, EXT_ERROR if the data is not a
+ *  valid block of dstSize bytes.
+ */
+PUBLIC boolean_T ExtDecompress(const uint8_T *src,
+                               int_T         nBytes,
+                               uint8_T       *dst,
+                               int_T         dstSize)
+{
+    int_T ip = 0;
+    int_T op = 0;
+
+    while (ip < nBytes) {
+        int_T token = src[ip++];
+        int_T nLit  = token >> 4;
+        int_T mLen  = token & 15;
+        int_T offset;
+
+        if (nLit == 15) {
+            int_T b;
+            do {
+                if (ip >= nBytes) return(EXT_ERROR);
+                b     = src[ip++];
+                nLit += b;
+            } while (b == 255);
+        }
+        if ((nLit > nBytes - ip) || (nLit > dstSize - op)) return(EXT_ERROR);
+        (void)memcpy(dst + op, src + ip, nLit);
+        ip += nLit;
+        op += nLit;
+
+        if (ip == nBytes) break; /* the last sequence has no match */
+
+        if (nBytes - ip < 2) return(EXT_ERROR);
+        offset = src[ip] | (src[ip+1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > op)) return(EXT_ERROR);
+
+        if (mLen == 15) {
+            int_T b;
+            do {
+                if (ip >= nBytes) return(EXT_ERROR);
+                b     = src[ip++];
+                mLen += b;
+            } while (b == 255);
+        }
+        mLen += LZ_MIN_MATCH;
+        if (mLen > dstSize - op) return(EXT_ERROR);
+
+        /* byte by byte: the match may overlap what it copies */
+        while (mLen-- > 0) {
+            dst[op] = dst[op - offset];
+            op++;
+        }
+    }
+    return((op == dstSize) ? EXT_NO_ERROR : EXT_ERROR);
+} /* end ExtDecompress */
+
+/* [EOF] ext_compress.c */
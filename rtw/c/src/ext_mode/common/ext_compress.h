@@ -0,0 +1,37 @@
+/*
+ * File: ext_compress.h
+ *
+ * Abstract:
+ *  Compression of external mode parameter packets (see
+ *  EXTMODE_PARAM_DELTA_SYNC in ext_svr.c).  The data is in the LZ4 block
+ *  format, so that the host can use any LZ4 implementation.
+ */
+
+#ifndef __EXT_COMPRESS__
+#define __EXT_COMPRESS__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * ExtCompress only keeps data that shrinks, so a dst of nBytes - 1 bytes
+ * is always large enough.
+ */
+extern int_T     ExtCompress(const uint8_T *src,
+                             int_T         nBytes,
+                             uint8_T       *dst,
+                             int_T         dstSize);
+
+extern boolean_T ExtDecompress(const uint8_T *src,
+                               int_T         nBytes,
+                               uint8_T       *dst,
+                               int_T         dstSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EXT_COMPRESS__ */
+
+/* [EOF] ext_compress.h */
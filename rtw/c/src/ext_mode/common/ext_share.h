@@ -85,11 +85,24 @@ typedef enum {
      */
     EXT_DAEMON_ACK,
 
+    /*
+     * Parameter delta sync (targets built with EXTMODE_PARAM_DELTA_SYNC,
+     * see ext_svr.c).  The host asks for the hashes of the blocks of the
+     * parameters, then only for the blocks that differ from its copy, and
+     * may send parameters compressed.  These follow the other actions so
+     * that the existing IDs keep their values.
+     */
+    EXT_GETPARAM_HASHES,
+    EXT_GETPARAM_HASHES_RESPONSE,
+    EXT_GETPARAM_BLOCKS,
+    EXT_GETPARAM_BLOCKS_RESPONSE,
+    EXT_SETPARAM_COMPRESSED,
+
     EXTENDED = 255 /* reserved for extending beyond 254 ID's */
 } ExtModeAction;
 
 
-typedef enum { STATUS_OK, NOT_ENOUGH_MEMORY } ResponseStatus;
+typedef enum { STATUS_OK, NOT_ENOUGH_MEMORY, CORRUPT_PACKET } ResponseStatus;
 
 typedef enum { LittleEndian, BigEndian } MachByteOrder;
 
@@ -54,6 +54,25 @@
 #include "updown_util.h"
 #include "dt_info.h"
 
+/*
+ * EXTMODE_PARAM_DELTA_SYNC: answer the host's requests for the hashes of
+ * the parameter blocks and for single blocks, optionally compressed, and
+ * accept compressed parameter packets (see ProcessGetParamHashesPkt).
+ * ext_compress.c must be built with it.
+ */
+#if defined(EXTMODE_PARAM_DELTA_SYNC) && defined(EXTMODE_DISABLEPARAMETERTUNING)
+#undef EXTMODE_PARAM_DELTA_SYNC
+#endif
+
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+#include "ext_compress.h"
+
+/* Bytes of parameters per hashed block; a block ends with its transition */
+#ifndef EXTMODE_PARAM_BLOCK_BYTES
+#define EXTMODE_PARAM_BLOCK_BYTES 4096
+#endif
+#endif
+
 
 /*Uncomment to test 4 byte reals*/
 /*#define real_T float*/
@@ -92,6 +111,15 @@ PRIVATE boolean_T   connected       = false;
 PRIVATE boolean_T   commInitialized = false;
 boolean_T gblSetParamPktReceived = false;
 
+#ifdef EXTMODE_STAGED_PARAMS
+/*
+ * Header of a parameter packet that waits for the previous update to be
+ * committed; its data stays in the transport until then.
+ */
+PRIVATE boolean_T   setParamHdrHeld = false;
+PRIVATE PktHeader   heldSetParamHdr;
+#endif
+
 /*
  * Pointer to opaque user data (defined by ext_svr_transport.c).
  */
@@ -103,6 +131,14 @@ PRIVATE ExtUserData *extUD          = NULL;
 PRIVATE int_T pktBufSize = 0;
 PRIVATE char  *pktBuf    = NULL;
 
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+/*
+ * Buffer that compressed parameter packets are unpacked to.
+ */
+PRIVATE int_T unpackBufSize = 0;
+PRIVATE char  *unpackBuf    = NULL;
+#endif
+
 
 #ifndef EXTMODE_DISABLESIGNALMONITORING
 #ifndef EXTMODE_DISABLEPRINTF 
@@ -462,6 +498,9 @@ PRIVATE void DisconnectFromHost(int_T numSampTimes)
     
     connected       = false;
     commInitialized = false;
+#ifdef EXTMODE_STAGED_PARAMS
+    setParamHdrHeld = false;
+#endif
     
     ExtCloseConnection(extUD);
 } /* end DisconnectFromHost */
@@ -479,6 +518,9 @@ PRIVATE void ForceDisconnectFromHost(int_T numSampTimes)
     int i;
     connected       = false;
     commInitialized = false;
+#ifdef EXTMODE_STAGED_PARAMS
+    setParamHdrHeld = false;
+#endif
 
     for (i=0; i<NUM_UPINFOS; i++) {
         UploadEndLoggingSession(i, numSampTimes);
@@ -667,6 +709,38 @@ EXIT_POINT:
 } /* end SendPktDataToHost */
 
 
+/* Function: SendBufMemToHost ==================================================
+ * Abstract:
+ *  Send the sections of an upload buffer to the host, back to back.  Each
+ *  section is made of whole upload packets (header and payload) and is sent
+ *  directly from the upload buffer, without copying.
+ */
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+PRIVATE boolean_T SendBufMemToHost(const BufMem *bufMem)
+{
+    int_T        i;
+    const char_T *sections[2];
+    int_T        nBytes[2];
+    boolean_T    error = EXT_NO_ERROR;
+
+    sections[0] = bufMem->section1;
+    nBytes[0]   = bufMem->nBytes1;
+    sections[1] = bufMem->section2;
+    nBytes[1]   = bufMem->nBytes2;
+
+    for (i=0; i<2; i++) {
+        if (nBytes[i] > 0) {
+            error = SendPktDataToHost(sections[i], nBytes[i]);
+            if (error != EXT_NO_ERROR) goto EXIT_POINT;
+        }
+    }
+
+EXIT_POINT:
+    return(error);
+} /* end SendBufMemToHost */
+#endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
+
+
 /* Function: SendPktToHost =====================================================
  * Abstract:
  *  Send a packet to the host.  Packets can be of two forms:
@@ -725,10 +799,13 @@ PRIVATE boolean_T SendResponseStatus(const ExtModeAction  response,
 
 #ifndef EXTMODE_DISABLEPARAMETERTUNING
 /* Function: ProcessSetParamPkt ================================================
- * Receive and process the EXT_SETPARAM packet.
+ * Receive and process the EXT_SETPARAM packet, or the EXT_SETPARAM_COMPRESSED
+ * packet when compressed: a uint32_T with the size of the EXT_SETPARAM data,
+ * then that data compressed (see ext_compress.h).
  */
-PRIVATE boolean_T ProcessSetParamPkt(RTWExtModeInfo *ei,
-                                     const int pktSize)
+PRIVATE boolean_T ProcessSetParamPkt(RTWExtModeInfo  *ei,
+                                     int             pktSize,
+                                     const boolean_T compressed)
 {
     int32_T    msg;
     const char *pkt;
@@ -750,6 +827,51 @@ PRIVATE boolean_T ProcessSetParamPkt(RTWExtModeInfo *ei,
         error = EXT_ERROR; 
         goto EXIT_POINT;
     }
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+    if (compressed) {
+        uint32_T rawSize = 0;
+
+        if (pktSize >= (int)sizeof(rawSize)) {
+            (void)memcpy(&rawSize, pkt, sizeof(rawSize));
+        }
+        if ((int_T)rawSize > unpackBufSize) {
+            if (unpackBuf != NULL) free(unpackBuf);
+            unpackBufSize = 0;
+            unpackBuf     = (char *)malloc(rawSize);
+            if (unpackBuf == NULL) {
+                msg = (int32_T)NOT_ENOUGH_MEMORY;
+                SendPktToHost(EXT_SETPARAM_RESPONSE,sizeof(int32_T),(char_T *)&msg);
+                error = EXT_ERROR;
+                goto EXIT_POINT;
+            }
+            unpackBufSize = (int_T)rawSize;
+        }
+        if ((rawSize == 0) ||
+            (ExtDecompress((const uint8_T *)pkt + sizeof(rawSize),
+                           pktSize - (int)sizeof(rawSize),
+                           (uint8_T *)unpackBuf,
+                           (int_T)rawSize) != EXT_NO_ERROR)) {
+            msg = (int32_T)CORRUPT_PACKET;
+            SendPktToHost(EXT_SETPARAM_RESPONSE,sizeof(int32_T),(char_T *)&msg);
+            error = EXT_ERROR;
+            goto EXIT_POINT;
+        }
+        pkt     = unpackBuf;
+        pktSize = (int)rawSize;
+    }
+#else
+    (void)compressed;
+#endif
+#ifdef EXTMODE_STAGED_PARAMS
+    /*
+     * While the model runs, install the parameters at a step boundary;
+     * without memory for the shadow bank, install them right away.
+     */
+    if ((modelStatus == TARGET_STATUS_RUNNING) &&
+        (ParamStageBegin(ei, pkt, pktSize) == EXT_NO_ERROR)) {
+        (void)ParamStageWork(true);
+    } else
+#endif
     SetParam(ei, pkt);
 
     msg = (int32_T)STATUS_OK;
@@ -835,6 +957,249 @@ EXIT_POINT:
 #endif /* ifndef EXTMODE_DISABLEPARAMETERTUNING */
 
 
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+/*
+ * Parameter delta sync.  The parameters are cut into blocks of
+ * EXTMODE_PARAM_BLOCK_BYTES, each transition on its own (the last block of
+ * a transition may be shorter).  On connect, the host that has a copy of
+ * the parameters asks for their hashes with EXT_GETPARAM_HASHES, and then
+ * with EXT_GETPARAM_BLOCKS only for the blocks whose hashes differ from
+ * those of its copy.  To change parameters, it sends the changed elements
+ * in an EXT_SETPARAM packet, which holds ranges of elements already, or in
+ * an EXT_SETPARAM_COMPRESSED packet.  All data is in target byte order.
+ */
+#define PARAM_HASH_BUF_WORDS 64
+
+/* Function: ParamBlockHash ====================================================
+ * Abstract:
+ *  Hash of the nBytes of a parameter block: FNV-1a in h[0] and Adler-32 in
+ *  h[1].
+ */
+PRIVATE void ParamBlockHash(const uint8_T *data,
+                            const int_T   nBytes,
+                            uint32_T      h[2])
+{
+    int_T    i;
+    uint32_T fnv = 2166136261U;
+    uint32_T a   = 1U;
+    uint32_T b   = 0U;
+
+    for (i=0; i<nBytes; i++) {
+        fnv = (fnv ^ data[i]) * 16777619U;
+        a  += data[i];
+        if (a >= 65521U) a -= 65521U;
+        b  += a;
+        if (b >= 65521U) b -= 65521U;
+    }
+    h[0] = fnv;
+    h[1] = (b << 16) | a;
+} /* end ParamBlockHash */
+
+
+/* Function: ParamTransInfo ====================================================
+ * Abstract:
+ *  Address and number of bytes of parameter transition i.
+ */
+PRIVATE int_T ParamTransInfo(const DataTypeTransInfo       *dtInfo,
+                             const DataTypeTransitionTable *dtTable,
+                             const int_T                   i,
+                             char_T                        **address)
+{
+    const uint_T *dtSizes = dtGetDataTypeSizes(dtInfo);
+    int_T        dt       = dtTransGetDataType(dtTable, i);
+
+    *address = dtTransGetAddress(dtTable, i);
+    return((int_T)dtSizes[dt] * dtTransNEls(dtTable, i));
+} /* end ParamTransInfo */
+
+
+/* Function: ProcessGetParamHashesPkt ==========================================
+ * Abstract:
+ *  Respond to EXT_GETPARAM_HASHES with an EXT_GETPARAM_HASHES_RESPONSE
+ *  packet of uint32_T's:
+ *      blockBytes, nTrans, nBytes[nTrans],
+ *      then the hash pair of each block of each transition, in order.
+ */
+PRIVATE boolean_T ProcessGetParamHashesPkt(RTWExtModeInfo *ei)
+{
+    int_T                         i;
+    int_T                         nWords;
+    uint32_T                      buf[PARAM_HASH_BUF_WORDS];
+    int_T                         nBuf     = 0;
+    int_T                         nTrans   = 0;
+    boolean_T                     error    = EXT_NO_ERROR;
+    const DataTypeTransInfo       *dtInfo  = (const DataTypeTransInfo *) rteiGetModelMappingInfo(ei);
+    const DataTypeTransitionTable *dtTable = dtGetParamDataTypeTrans(dtInfo);
+
+    if (dtTable != NULL) nTrans = dtGetNumTransitions(dtTable);
+
+    /*
+     * Take pass 1 through the transitions to count the blocks.
+     */
+    nWords = 2 + nTrans;
+    for (i=0; i<nTrans; i++) {
+        char_T *tranAddress;
+        int_T  nBytes = ParamTransInfo(dtInfo, dtTable, i, &tranAddress);
+
+        nWords += 2 * ((nBytes + EXTMODE_PARAM_BLOCK_BYTES - 1) /
+                       EXTMODE_PARAM_BLOCK_BYTES);
+    }
+
+    error = SendPktHdrToHost(EXT_GETPARAM_HASHES_RESPONSE,
+                             nWords * (int_T)sizeof(uint32_T));
+    if (error != EXT_NO_ERROR) goto EXIT_POINT;
+
+    /*
+     * Take pass 2 for the sizes and pass 3 for the hashes, sending them
+     * through buf.
+     */
+    buf[nBuf++] = (uint32_T)EXTMODE_PARAM_BLOCK_BYTES;
+    buf[nBuf++] = (uint32_T)nTrans;
+    for (i=0; i<nTrans; i++) {
+        char_T *tranAddress;
+
+        if (nBuf == PARAM_HASH_BUF_WORDS) {
+            error = SendPktDataToHost((const char *)buf,
+                                      nBuf * (int_T)sizeof(uint32_T));
+            if (error != EXT_NO_ERROR) goto EXIT_POINT;
+            nBuf = 0;
+        }
+        buf[nBuf++] = (uint32_T)ParamTransInfo(dtInfo, dtTable, i,
+                                               &tranAddress);
+    }
+    for (i=0; i<nTrans; i++) {
+        char_T *tranAddress;
+        int_T  nBytes = ParamTransInfo(dtInfo, dtTable, i, &tranAddress);
+        int_T  offset;
+
+        for (offset=0; offset<nBytes; offset+=EXTMODE_PARAM_BLOCK_BYTES) {
+            int_T blockBytes = nBytes - offset;
+
+            if (blockBytes > EXTMODE_PARAM_BLOCK_BYTES) {
+                blockBytes = EXTMODE_PARAM_BLOCK_BYTES;
+            }
+            if (nBuf > PARAM_HASH_BUF_WORDS - 2) {
+                error = SendPktDataToHost((const char *)buf,
+                                          nBuf * (int_T)sizeof(uint32_T));
+                if (error != EXT_NO_ERROR) goto EXIT_POINT;
+                nBuf = 0;
+            }
+            ParamBlockHash((const uint8_T *)tranAddress + offset, blockBytes,
+                           &buf[nBuf]);
+            nBuf += 2;
+        }
+    }
+    error = SendPktDataToHost((const char *)buf,
+                              nBuf * (int_T)sizeof(uint32_T));
+
+EXIT_POINT:
+    return(error);
+} /* end ProcessGetParamHashesPkt */
+
+
+/* Function: ProcessGetParamBlocksPkt ==========================================
+ * Abstract:
+ *  Receive an EXT_GETPARAM_BLOCKS packet of uint32_T's:
+ *      flags (bit 0: compress), nReq, then trans and block nReq times,
+ *  and respond with an EXT_GETPARAM_BLOCKS_RESPONSE packet per block:
+ *      uint32_T trans, block, rawBytes, codedBytes, then codedBytes bytes.
+ *  The data is raw when codedBytes equals rawBytes, and compressed (see
+ *  ext_compress.h) otherwise.  A block that does not exist has 0 bytes.
+ */
+PRIVATE boolean_T ProcessGetParamBlocksPkt(RTWExtModeInfo *ei,
+                                           const int      pktSize)
+{
+    int_T                         i;
+    uint32_T                      nReq;
+    const uint32_T                *req;
+    const char                    *pkt;
+    uint8_T                       *codeBuf = NULL;
+    int_T                         nTrans   = 0;
+    boolean_T                     error    = EXT_NO_ERROR;
+    const DataTypeTransInfo       *dtInfo  = (const DataTypeTransInfo *) rteiGetModelMappingInfo(ei);
+    const DataTypeTransitionTable *dtTable = dtGetParamDataTypeTrans(dtInfo);
+
+#ifdef DAEMON_MODE
+    pkt = GetPktUsingAck(pktSize);
+#else
+    pkt = GetPkt(pktSize);
+#endif
+    if ((pkt == NULL) || (pktSize < 2*(int)sizeof(uint32_T))) {
+        error = EXT_ERROR;
+        goto EXIT_POINT;
+    }
+    req  = (const uint32_T *)pkt;
+    nReq = req[1];
+    if (nReq > (uint32_T)(pktSize/(int)sizeof(uint32_T) - 2) / 2) {
+        nReq = (uint32_T)(pktSize/(int)sizeof(uint32_T) - 2) / 2;
+    }
+
+    /* without memory to compress, the blocks go raw */
+    if (req[0] & 1U) {
+        codeBuf = (uint8_T *)malloc(EXTMODE_PARAM_BLOCK_BYTES);
+    }
+
+    if (dtTable != NULL) nTrans = dtGetNumTransitions(dtTable);
+
+    for (i=0; i<(int_T)nReq; i++) {
+        uint32_T   info[4];
+        const char *data  = NULL;
+        int_T      nBytes = 0;
+
+        info[0] = req[2 + 2*i];
+        info[1] = req[3 + 2*i];
+        info[2] = 0U;
+        info[3] = 0U;
+
+        if (info[0] < (uint32_T)nTrans) {
+            char_T   *tranAddress;
+            uint32_T tranBytes = (uint32_T)ParamTransInfo(
+                dtInfo, dtTable, (int_T)info[0], &tranAddress);
+            uint32_T nBlocks = (tranBytes + EXTMODE_PARAM_BLOCK_BYTES - 1) /
+                               EXTMODE_PARAM_BLOCK_BYTES;
+
+            if (info[1] < nBlocks) {
+                uint32_T offset = info[1] * EXTMODE_PARAM_BLOCK_BYTES;
+
+                info[2] = tranBytes - offset;
+                if (info[2] > EXTMODE_PARAM_BLOCK_BYTES) {
+                    info[2] = EXTMODE_PARAM_BLOCK_BYTES;
+                }
+                data   = tranAddress + offset;
+                nBytes = (int_T)info[2];
+                if (codeBuf != NULL) {
+                    int_T nCoded = ExtCompress((const uint8_T *)data, nBytes,
+                                               codeBuf,
+                                               EXTMODE_PARAM_BLOCK_BYTES);
+                    if (nCoded > 0) {
+                        data   = (const char *)codeBuf;
+                        nBytes = nCoded;
+                    }
+                }
+                info[3] = (uint32_T)nBytes;
+            }
+        }
+
+        error = SendPktHdrToHost(EXT_GETPARAM_BLOCKS_RESPONSE,
+                                 (int)sizeof(info) + nBytes);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+
+        error = SendPktDataToHost((const char *)info, (int)sizeof(info));
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+
+        if (nBytes > 0) {
+            error = SendPktDataToHost(data, nBytes);
+            if (error != EXT_NO_ERROR) goto EXIT_POINT;
+        }
+    }
+
+EXIT_POINT:
+    if (codeBuf != NULL) free(codeBuf);
+    return(error);
+} /* end ProcessGetParamBlocksPkt */
+#endif /* ifdef EXTMODE_PARAM_DELTA_SYNC */
+
+
 #ifndef EXTMODE_DISABLESIGNALMONITORING
 /* Function: ProcessSelectTriggerSignalPkt ===========================================
  * Receive and process the EXT_SELECT_TRIGGER or EXT_SELECT_SIGNALS packet.
@@ -1063,33 +1428,18 @@ taskSafe();
             const BufMem *bufMem = &upList.bufs[i];
 
             /*
-             * We call SendPktDataToHost() instead of SendPktToHost() because
-             * the packet header is combined with packet payload.  We do this
-             * to avoid the overhead of making two calls for each upload
-             * packet - one for the head and one for the payload.
+             * We send the buffer sections instead of calling SendPktToHost()
+             * because the packet header is combined with packet payload.  We
+             * do this to avoid the overhead of making two calls for each
+             * upload packet - one for the head and one for the payload.
              */
-            error = SendPktDataToHost(
-                bufMem->section1,
-                bufMem->nBytes1);
+            error = SendBufMemToHost(bufMem);
             if (error != EXT_NO_ERROR) {
 #ifndef EXTMODE_DISABLEPRINTF                    
                 fprintf(stderr,"SendPktDataToHost() failed on data upload.\n");
 #endif
                 goto EXIT_POINT;
             }
-            
-            if (bufMem->nBytes2 > 0) {
-
-                error = SendPktDataToHost(
-                    bufMem->section2,
-                    bufMem->nBytes2);
-                if (error != EXT_NO_ERROR) {
-#ifndef EXTMODE_DISABLEPRINTF                        
-                    fprintf(stderr,"SendPktDataToHost() failed on data upload.\n");
-#endif
-                    goto EXIT_POINT;
-                }
-            }
             /* confirm that the data was sent */
             UploadBufDataSent(upList.tids[i], upInfoIdx);
         }
@@ -1188,6 +1538,16 @@ PUBLIC void rt_PktServerWork(RTWExtModeInfo *ei,
     boolean_T  error             = EXT_NO_ERROR;
     boolean_T  disconnectOnError = false;
     
+#ifdef EXTMODE_STAGED_PARAMS
+    /*
+     * Stage the next slice of a parameter update.  Its data is in the
+     * packet buffer until it is staged.
+     */
+    if (ParamStageWork((boolean_T)(modelStatus == TARGET_STATUS_RUNNING))) {
+        goto EXIT_POINT;
+    }
+#endif
+
     /*
      * If not connected, attempt to make connection to host.
      */
@@ -1209,6 +1569,15 @@ PUBLIC void rt_PktServerWork(RTWExtModeInfo *ei,
      */
 
     /* Wait for a packet. */
+#ifdef EXTMODE_STAGED_PARAMS
+    if (setParamHdrHeld) {
+        /* a held parameter packet goes once the last update is committed */
+        if (ParamStageBusy()) goto EXIT_POINT;
+        pktHdr          = heldSetParamHdr;
+        hdrAvail        = true;
+        setParamHdrHeld = false;
+    } else
+#endif
     error = GetPktHdr(&pktHdr, &hdrAvail);
     if (error != EXT_NO_ERROR) {
 #ifndef EXTMODE_DISABLEPRINTF            
@@ -1296,13 +1665,22 @@ PUBLIC void rt_PktServerWork(RTWExtModeInfo *ei,
     }
 
     case EXT_SETPARAM:
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+    case EXT_SETPARAM_COMPRESSED:
+#endif
     {
 #ifndef EXTMODE_DISABLEPARAMETERTUNING
         PRINT_VERBOSE(("got EXT_SETPARAM packet.\n"));
         if (pktHdr.size == 0) {
             gblSetParamPktReceived = true;
+#ifdef EXTMODE_STAGED_PARAMS
+        } else if (ParamStageBusy()) {
+            heldSetParamHdr = pktHdr;
+            setParamHdrHeld = true;
+#endif
         } else {
-            error = ProcessSetParamPkt(ei, pktHdr.size);
+            error = ProcessSetParamPkt(ei, pktHdr.size,
+                (boolean_T)(pktHdr.type == EXT_SETPARAM_COMPRESSED));
             if (error != EXT_NO_ERROR) {
                 goto EXIT_POINT;
             }
@@ -1328,6 +1706,24 @@ PUBLIC void rt_PktServerWork(RTWExtModeInfo *ei,
         break;
     }
 
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+    case EXT_GETPARAM_HASHES:
+    {
+        PRINT_VERBOSE(("got EXT_GETPARAM_HASHES packet.\n"));
+        error = ProcessGetParamHashesPkt(ei);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+        break;
+    }
+
+    case EXT_GETPARAM_BLOCKS:
+    {
+        PRINT_VERBOSE(("got EXT_GETPARAM_BLOCKS packet.\n"));
+        error = ProcessGetParamBlocksPkt(ei, pktHdr.size);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+        break;
+    }
+#endif
+
     case EXT_DISCONNECT_REQUEST:
     {
         PRINT_VERBOSE(("got EXT_DISCONNECT_REQUEST packet.\n"));
@@ -1521,6 +1917,13 @@ PRIVATE void ExtModeShutdown(int32_T upInfoIdx, int_T numSampTimes)
         free(pktBuf);
         pktBuf = NULL;
     }
+#ifdef EXTMODE_PARAM_DELTA_SYNC
+    if (unpackBuf != NULL) {
+        free(unpackBuf);
+        unpackBuf     = NULL;
+        unpackBufSize = 0;
+    }
+#endif
 
 } /* end ExtModeShutdown */
 
@@ -1538,6 +1941,10 @@ PUBLIC boolean_T rt_ExtModeShutdown(int_T numSampTimes)
         ExtModeShutdown(i, numSampTimes);
     }
 
+#ifdef EXTMODE_STAGED_PARAMS
+    ParamStageTerm();
+#endif
+
     if (commInitialized) {
         error = SendPktToHost(EXT_MODEL_SHUTDOWN, 0, NULL);
         if (error != EXT_NO_ERROR) {
@@ -1599,6 +2006,23 @@ PUBLIC void rt_UploadBufAddTimePoint(int_T tid, real_T taskTime)
         UploadBufAddTimePoint(tid, taskTime, i);
     }
 } /* end rt_UploadBufAddTimePoint */
+
+
+/* Function: rt_UploadBufNumOverFlows ==========================================
+ * Abstract:
+ *  Return the number of time points of the specified tid which were dropped
+ *  because they did not fit in the upload buffers, summed over the upInfos.
+ */
+PUBLIC uint32_T rt_UploadBufNumOverFlows(int_T tid)
+{
+    int      i;
+    uint32_T nOverFlows = 0;
+    
+    for (i=0; i<NUM_UPINFOS; i++) {
+        nOverFlows += UploadBufNumOverFlows(tid, i);
+    }
+    return(nOverFlows);
+} /* end rt_UploadBufNumOverFlows */
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 /* [EOF] ext_svr.c */
@@ -40,6 +40,8 @@ extern void      rt_UploadCheckEndTrigger(void);
 extern void      rt_UploadBufAddTimePoint(int_T tid,
                                           real_T taskTime);
 
+extern uint32_T  rt_UploadBufNumOverFlows(int_T tid);
+
 #ifndef VXWORKS
 extern void      rt_ExtModeSleep(long sec,   /* number of seconds to wait      */
                                  long usec); /* number of micro seconds to wait*/
@@ -192,6 +192,10 @@ void rtExtModeUpload(int_T tid, real_T taskTime)
 
 void rtExtModeCheckEndTrigger(void)
 {
+#ifdef EXTMODE_STAGED_PARAMS
+    /* end of a base rate step: install a staged parameter update */
+    ParamStageCommit();
+#endif
 #ifndef EXTMODE_DISABLESIGNALMONITORING
     rt_UploadCheckEndTrigger();
 #endif
@@ -4,6 +4,21 @@
  * File: mem_mgr.c     $Revision.2 $
  *
  * Abstract:
+ *  Allocator for the static memory pool used by external mode when
+ *  EXTMODE_STATIC is defined.
+ *
+ *  The pool is managed as a two-level segregated fit (TLSF) heap, so that
+ *  ExtModeMalloc and ExtModeFree take constant time whatever the number of
+ *  blocks:
+ *
+ *  - Every block starts with a header holding its size and the address of
+ *    the block physically before it, so a freed block is found from its
+ *    pointer and merged with free neighbours at once.
+ *
+ *  - Free blocks are kept in lists by size class: the power of two of the
+ *    size, split linearly into MEM_SL_COUNT classes.  Bitmaps of the
+ *    non-empty lists give the smallest class that is large enough with two
+ *    bit scans.
  */
 
 #include <stddef.h>
@@ -32,319 +47,285 @@
 #  endif
 #endif
 
-PRIVATE char MemoryBuffer[EXTMODE_STATIC_SIZE];
+/*
+ * Block sizes are multiples of MEM_ALIGN.  Sizes below MEM_SMALL_SIZE are
+ * all in first-level class 0, MEM_SMALL_SIZE/MEM_SL_COUNT bytes apart.
+ */
+#define MEM_ALIGN_LOG2       3
+#define MEM_ALIGN            (1U << MEM_ALIGN_LOG2)
+#define MEM_SL_COUNT_LOG2    4
+#define MEM_SL_COUNT         (1 << MEM_SL_COUNT_LOG2)
+#define MEM_FL_SHIFT         (MEM_SL_COUNT_LOG2 + MEM_ALIGN_LOG2)
+#define MEM_SMALL_SIZE       (1U << MEM_FL_SHIFT)
+/*
+ * Highest bit of a block size.  mappingInsert puts a size whose top bit is
+ * f in first-level class f - (MEM_FL_SHIFT - 1), so the largest size maps to
+ * MEM_FL_COUNT - 1.
+ */
+#define MEM_FL_MAX           31
+#define MEM_FL_COUNT         (MEM_FL_MAX - (MEM_FL_SHIFT - 1) + 1)
+
+#define MEM_BLK_FREE         1U  /* flag in the low bit of the size */
+
+typedef struct MemBlk_Tag {
+    struct MemBlk_Tag *prevPhys;  /* block physically before, NULL if first */
+    uint32_T          size;       /* payload bytes | MEM_BLK_FREE           */
+    /* The payload starts here; free blocks link themselves through it. */
+    struct MemBlk_Tag *nextFree;
+    struct MemBlk_Tag *prevFree;
+} MemBlk;
+
+#define MEM_BLK_HDR_SIZE     ((uint32_T)offsetof(MemBlk, nextFree))
+#define MEM_BLK_MIN_SIZE \
+    ((uint32_T)((sizeof(MemBlk) - offsetof(MemBlk, nextFree) + MEM_ALIGN - 1) \
+                & ~(size_t)(MEM_ALIGN - 1)))
+
+#define blkSize(b)     ((b)->size & ~MEM_BLK_FREE)
+#define blkIsFree(b)   (((b)->size & MEM_BLK_FREE) != 0U)
+#define blkPayload(b)  ((void *)((char *)(b) + MEM_BLK_HDR_SIZE))
+#define blkFromPayload(p) ((MemBlk *)((char *)(p) - MEM_BLK_HDR_SIZE))
+#define blkNextPhys(b) ((MemBlk *)((char *)(b) + MEM_BLK_HDR_SIZE + blkSize(b)))
+
+/*
+ * The pool, with room to align its start.  The last MEM_BLK_HDR_SIZE bytes
+ * hold a zero-size block in use that ends the physical list.
+ */
+PRIVATE char MemoryBuffer[EXTMODE_STATIC_SIZE + MEM_ALIGN];
+
+PRIVATE boolean_T poolInitialized = false;
+PRIVATE MemBlk    *firstBlk       = NULL;
+
+PRIVATE uint32_T  flBitmap = 0U;              /* non-empty first levels     */
+PRIVATE uint32_T  slBitmap[MEM_FL_COUNT];     /* non-empty second levels    */
+PRIVATE MemBlk    *freeLists[MEM_FL_COUNT][MEM_SL_COUNT];
 
-PRIVATE MemBufHdr *FreeQueue = NULL;
-PRIVATE MemBufHdr InUseQueue = {NULL, NULL, NULL, 0};
+PRIVATE ExtModeMemStats memStats;
 
 #ifdef VERBOSE
 uint32_T numBytesAllocated = 0;
 #endif
 
-PRIVATE void insertMemBufRight(MemBufHdr *buf, MemBufHdr *queue)
+/* Function: memFls ============================================================
+ * Abstract:
+ *  Index of the most significant set bit of a non-zero word.
+ */
+PRIVATE int memFls(uint32_T word)
 {
-    assert(queue != NULL);
-    assert(buf != NULL);
-
-    buf->memBufPrev = queue;
-    buf->memBufNext = queue->memBufNext;
-
-    if (buf->memBufNext != NULL) {
-	buf->memBufNext->memBufPrev = buf;
-    }
-
-    queue->memBufNext = buf;
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(word);
+#else
+    int bit = 31;
+    assert(word != 0U);
+    while ((word & (1UL << bit)) == 0U) bit--;
+    return bit;
+#endif
 }
 
-PRIVATE void removeMemBuf(MemBufHdr *buf)
+/* Function: memFfs ============================================================
+ * Abstract:
+ *  Index of the least significant set bit of a non-zero word.
+ */
+PRIVATE int memFfs(uint32_T word)
 {
-    MemBufHdr *rightMemBuf;
-    MemBufHdr *leftMemBuf;
-
-    assert(buf != NULL);
-
-    rightMemBuf = buf->memBufNext;
-    leftMemBuf  = buf->memBufPrev;
-
-    if (rightMemBuf != NULL) {
-	rightMemBuf->memBufPrev = leftMemBuf;
-    }
-    if (leftMemBuf != NULL) {
-	leftMemBuf->memBufNext = rightMemBuf;
-    }
-
-    buf->memBufNext = NULL;
-    buf->memBufPrev = NULL;
+#if defined(__GNUC__)
+    return __builtin_ctz(word);
+#else
+    int bit = 0;
+    assert(word != 0U);
+    while ((word & (1UL << bit)) == 0U) bit++;
+    return bit;
+#endif
 }
 
-PRIVATE boolean_T moveRight(MemBufHdr *buf)
+/* Function: mappingInsert =====================================================
+ * Abstract:
+ *  Size class of a free block of 'size' bytes.
+ */
+PRIVATE void mappingInsert(uint32_T size, int *fl, int *sl)
 {
-    MemBufHdr *buf2;
-
-    assert(buf != NULL);
-
-    if (buf->memBufNext == NULL) {
-	return false;
+    if (size < MEM_SMALL_SIZE) {
+        *fl = 0;
+        *sl = (int)(size / (MEM_SMALL_SIZE / MEM_SL_COUNT));
     } else {
-	buf2 = buf->memBufNext;
-	removeMemBuf(buf);
-	insertMemBufRight(buf,buf2);
+        int f = memFls(size);
+        *sl = (int)((size >> (f - MEM_SL_COUNT_LOG2)) ^ (1U << MEM_SL_COUNT_LOG2));
+        *fl = f - (MEM_FL_SHIFT - 1);
     }
-    return true;    
 }
 
-PRIVATE boolean_T sortRight(MemBufHdr *buf)
+/* Function: mappingSearch =====================================================
+ * Abstract:
+ *  Smallest size class whose blocks all hold 'size' bytes.
+ */
+PRIVATE void mappingSearch(uint32_T size, int *fl, int *sl)
 {
-    assert(buf != NULL);
-
-    if ((buf->memBufNext != NULL) && (buf > buf->memBufNext)) {
-	return moveRight(buf);
+    if (size >= MEM_SMALL_SIZE) {
+        size += (1U << (memFls(size) - MEM_SL_COUNT_LOG2)) - 1U;
     }
-    return false;
+    mappingInsert(size, fl, sl);
 }
 
-PRIVATE boolean_T sortLeft(MemBufHdr *buf)
+PRIVATE void removeFreeBlk(MemBlk *blk)
 {
-    assert(buf != NULL);
+    int fl, sl;
 
-    if ((buf->memBufPrev != NULL) && (buf < buf->memBufPrev)) {
-	return moveRight(buf->memBufPrev);
-    }
-    return false;
-}
+    assert(blkIsFree(blk));
+    mappingInsert(blkSize(blk), &fl, &sl);
 
-PRIVATE boolean_T mergeWithMemBufOnRight(MemBufHdr *buf)
-{
-    assert(buf != NULL);
-
-    /*
-     * If this memory buffer is adjacent to a free memory buffer to its right,
-     * merge the two memory buffers into one contiguous free memory buffer.
-     */
-    if (buf->memBufNext != NULL) {
-	MemBufHdr *leftMemBuf   = buf;
-	MemBufHdr *rightMemBuf  = buf->memBufNext;
-	
-	/* Assumes data portion of mem buf is contiguous with mem buf header. */
-	char *pointer1 = ((char *)leftMemBuf + sizeof(MemBufHdr) + leftMemBuf->size);
-	char *pointer2 = (char *)leftMemBuf->memBufNext;
-
-	if (pointer1 == pointer2)
-        {
-            removeMemBuf(rightMemBuf);
-            leftMemBuf->size += rightMemBuf->size + sizeof(MemBufHdr);
-            return true;
+    if (blk->nextFree != NULL) blk->nextFree->prevFree = blk->prevFree;
+    if (blk->prevFree != NULL) {
+        blk->prevFree->nextFree = blk->nextFree;
+    } else {
+        freeLists[fl][sl] = blk->nextFree;
+        if (freeLists[fl][sl] == NULL) {
+            slBitmap[fl] &= ~(1U << sl);
+            if (slBitmap[fl] == 0U) flBitmap &= ~(1U << fl);
         }
     }
-    return false;
+    blk->size &= ~MEM_BLK_FREE;
+
+    memStats.freeBytes -= blkSize(blk);
+    memStats.numFreeBlocks--;
 }
 
-PRIVATE boolean_T mergeMemBuf(MemBufHdr *buf)
+PRIVATE void insertFreeBlk(MemBlk *blk)
 {
-    boolean_T statusRight = false;
-    boolean_T statusLeft  = false;
-
-    assert(buf != NULL);
+    int fl, sl;
 
-    statusRight = mergeWithMemBufOnRight(buf);
+    mappingInsert(blkSize(blk), &fl, &sl);
 
-    if (buf->memBufPrev != NULL) {
-        statusLeft = mergeWithMemBufOnRight(buf->memBufPrev);
-    }
+    blk->size    |= MEM_BLK_FREE;
+    blk->prevFree = NULL;
+    blk->nextFree = freeLists[fl][sl];
+    if (blk->nextFree != NULL) blk->nextFree->prevFree = blk;
+    freeLists[fl][sl] = blk;
+    slBitmap[fl] |= 1U << sl;
+    flBitmap     |= 1U << fl;
 
-    return (statusRight | statusLeft);
+    memStats.freeBytes += blkSize(blk);
+    memStats.numFreeBlocks++;
 }
 
-PRIVATE MemBufHdr *inUseQueueFindMemBufHdr(void *mem)
+/* Function: findFreeBlk =======================================================
+ * Abstract:
+ *  A free block of at least 'size' bytes, or NULL.  It is not removed from
+ *  its list.
+ *
+ *  The class search skips the class that 'size' itself falls in, since only
+ *  some of its blocks are large enough.  When no larger class has a block,
+ *  that class is walked for one, so that a request is only refused when no
+ *  free block can hold it.
+ */
+PRIVATE MemBlk *findFreeBlk(uint32_T size)
 {
-    MemBufHdr *LocalBuf;
-
-    assert(mem != NULL);
-
-    LocalBuf = &InUseQueue;
-
-    if (LocalBuf->MemBuf == mem) return LocalBuf;
-
-    while (LocalBuf->memBufNext != NULL) {
-	LocalBuf = LocalBuf->memBufNext;
-        if (LocalBuf->MemBuf == mem) return LocalBuf;
+    int      fl, sl;
+    uint32_T slMap;
+    MemBlk   *blk;
+
+    mappingSearch(size, &fl, &sl);
+    if (fl < MEM_FL_COUNT) {
+        slMap = slBitmap[fl] & (~0U << sl);
+        if (slMap == 0U) {
+            uint32_T flMap = (fl+1 < MEM_FL_COUNT) ? (flBitmap & (~0U << (fl+1))) : 0U;
+            if (flMap != 0U) {
+                fl    = memFfs(flMap);
+                slMap = slBitmap[fl];
+            }
+        }
+        if (slMap != 0U) {
+            sl = memFfs(slMap);
+            return freeLists[fl][sl];
+        }
     }
 
-    return NULL;
+    mappingInsert(size, &fl, &sl);
+    for (blk = freeLists[fl][sl]; blk != NULL; blk = blk->nextFree) {
+        if (blkSize(blk) >= size) break;
+    }
+    return blk;
 }
 
-PRIVATE void inUseQueueInsert(MemBufHdr *buf)
+PRIVATE void initPool(void)
 {
-    MemBufHdr *LocalBuf;
+    char     *start;
+    MemBlk   *endBlk;
+    uint32_T poolSize;
 
-    assert(buf != NULL);
+    (void)memset(slBitmap, 0, sizeof(slBitmap));
+    (void)memset(freeLists, 0, sizeof(freeLists));
+    (void)memset(&memStats, 0, sizeof(memStats));
+    flBitmap = 0U;
 
-    LocalBuf = &InUseQueue;
-    while (LocalBuf->memBufNext != NULL) {
-	LocalBuf = LocalBuf->memBufNext;
-	continue;
-    }
-    insertMemBufRight(buf, LocalBuf);
-}
+    start = (char *)(((size_t)MemoryBuffer + MEM_ALIGN - 1) &
+                     ~(size_t)(MEM_ALIGN - 1));
+    poolSize = (uint32_T)((EXTMODE_STATIC_SIZE - MEM_BLK_HDR_SIZE) &
+                          ~(MEM_ALIGN - 1U));
 
-PRIVATE void sortQueue(MemBufHdr *buf)
-{
-    int count = 1;
-
-    assert(buf != NULL);
-
-    /* Bi-directional bubble sort...
-     *
-     * Whatever packet given, move it left until the packet to the
-     * left belongs there, or there is no packet to the left.
-     *
-     * If there is a packet to the left, move it to the left as
-     * above. 
-     *
-     * If there is no packet to the left, reverse direction moving
-     * packets to the right.
-     *
-     * Repeat this until no packets are moved.
-     */
-
-    /* While something moves... */
-    while (count > 0) {
-	count = 0;
-
-	/* Bubble left. */
-	while (1) {
-	    /* Move the current packet as far left as it will go. */
-	    if (sortLeft(buf)) {
-		count++;
-		continue;
-	    } else {
-		/* Try to merge the packet with its neighbor to the right. */
-		mergeMemBuf(buf);
-
-		/* Move the MemBufHdr to the left, if possible, and
-		 * continue bubbling left.
-		 */ 
-		if (buf->memBufPrev != NULL) {
-		    buf = buf->memBufPrev;
-		    continue;
-		} else {
-		    break;
-		}
-	    }
-	}
-
-	/* All done bubbling to the left. Now bubble to the right. */
-
-	/* Bubble right. */
-	while (1) {
-	    /* Move the current packet as far right as it will go. */
-	    if (sortRight(buf)) {
-		count++;
-		continue;
-	    } else {
-		/* Try to merge the packet with its neighbor to the right. */
-		mergeMemBuf(buf);
-
-		/* Move the MemBufHdr to the right, if possible, and
-		 * continue bubbling right.
-		 */ 
-		if (buf->memBufNext != NULL) {
-		    buf = buf->memBufNext;
-		    continue;
-		} else {
-		    break;
-		}
-	    }
-	}
-    }
-}
+    /* One free block covering the pool, ended by a zero-size block */
+    firstBlk           = (MemBlk *)start;
+    firstBlk->prevPhys = NULL;
+    firstBlk->size     = poolSize - MEM_BLK_HDR_SIZE;
 
-PRIVATE void initFreeQueue(void)
-{
-    MemBufHdr *initialFreeMemBuf = NULL;
+    endBlk           = blkNextPhys(firstBlk);
+    endBlk->prevPhys = firstBlk;
+    endBlk->size     = 0U;
+
+    memStats.poolSize = poolSize;
+    insertFreeBlk(firstBlk);
 
 #ifdef VERBOSE
     /* There is always at least one header allocated from the buffer. */
-    numBytesAllocated = sizeof(MemBufHdr);
+    numBytesAllocated = MEM_BLK_HDR_SIZE;
 #endif
 
-    /* The FreeQueue is a pointer to a "free" buffer. */
-    FreeQueue = (MemBufHdr *)MemoryBuffer;
-
-    /*
-     * The first free packet describes blocks of free space in the free queue
-     * buffer (initially the whole buffer) and, as space becomes fragmented, is
-     * linked to other "free" buffers.
-     */
-    initialFreeMemBuf = FreeQueue;
-
-    /*
-     * The location and size of the initial free buffer describes the whole
-     * memory buffer.
-     */
-    initialFreeMemBuf->MemBuf = (char *)initialFreeMemBuf + sizeof(MemBufHdr);
-    initialFreeMemBuf->size   = sizeof(MemoryBuffer) - sizeof(MemBufHdr);
-
-    /*
-     * When there is only one, contiguous memory buffer, the initial free
-     * buffer is linked to no other free buffers. When there are more than
-     * one, or discontiguous free buffers, these links tie together all free
-     * buffers.
-     */
-    initialFreeMemBuf->memBufPrev = NULL;
-    initialFreeMemBuf->memBufNext = NULL;
-}
-
-PRIVATE MemBufHdr *findFirstFreeMemBuf(const int bufSize)
-{
-    /* Get the first free packet. */
-    MemBufHdr *buf = FreeQueue;
-
-    /*
-     * Loop until we find a free packet big enough for our request or we
-     * run out of free packets.
-     */
-    while (buf != NULL) {
-        /* Take the first free packet that fits. */
-        if (buf->size >= bufSize) {
-            /* Got it. Break out to continue. */
-            break;
-        }
-        /* Get the next free packet. */
-        buf = buf->memBufNext;
-    }
-
-    return buf;
+    poolInitialized = true;
 }
 
 PUBLIC void ExtModeFree(void *mem)
 {
-    MemBufHdr *buf = NULL;
+    MemBlk *blk;
+    MemBlk *next;
 
     if (mem == NULL) return;
 
-    /* Find the header associated with the memory pointer. */
-    buf = inUseQueueFindMemBufHdr(mem);
-    assert(buf != NULL);
+    blk = blkFromPayload(mem);
+    assert(!blkIsFree(blk));
 
+    memStats.inUse -= blkSize(blk) + MEM_BLK_HDR_SIZE;
 #ifdef VERBOSE
-    numBytesAllocated -= (buf->size + sizeof(MemBufHdr));
+    numBytesAllocated -= (blkSize(blk) + MEM_BLK_HDR_SIZE);
     printf("\nBytes allocated: %d out of %d.\n", numBytesAllocated, EXTMODE_STATIC_SIZE);
 #endif
 
-    /* Remove the buffer from the linked list. */
-    removeMemBuf(buf);
+    /* Merge with a free block on the right. */
+    next = blkNextPhys(blk);
+    if (blkIsFree(next)) {
+        removeFreeBlk(next);
+        blk->size += MEM_BLK_HDR_SIZE + blkSize(next);
+        blkNextPhys(blk)->prevPhys = blk;
+    }
+
+    /* Merge with a free block on the left. */
+    if (blk->prevPhys != NULL && blkIsFree(blk->prevPhys)) {
+        MemBlk *prev = blk->prevPhys;
+        removeFreeBlk(prev);
+        prev->size += MEM_BLK_HDR_SIZE + blkSize(blk);
+        blkNextPhys(prev)->prevPhys = prev;
+        blk = prev;
+    }
 
-    /* Put the buffer back in the free queue. */
-    insertMemBufRight(buf, FreeQueue);
-    mergeMemBuf(buf);
+    insertFreeBlk(blk);
 }
 
 PUBLIC void *ExtModeCalloc(uint32_T number, uint32_T size)
 {
     uint32_T numBytes = number*size;
-    void     *mem     = ExtModeMalloc(numBytes);
+    void     *mem     = NULL;
 
+    /* the product must not wrap */
+    if (size != 0U && numBytes / size != number) goto EXIT_POINT;
+
+    mem = ExtModeMalloc(numBytes);
     if (mem == NULL) goto EXIT_POINT;
 
     memset(mem, 0, numBytes);
@@ -355,85 +336,82 @@ PUBLIC void *ExtModeCalloc(uint32_T number, uint32_T size)
 
 PUBLIC void *ExtModeMalloc(uint32_T size)
 {
-    boolean_T keepTrying = false;
-
-    MemBufHdr *LocalMemBuf = NULL; /* Requested buffer (NULL if none available). */
-    MemBufHdr *FreeMemBuf = NULL;  /* First free buffer big enough for request. */
-
-    /*
-     * Must allocate enough space for the requested number of bytes plus the
-     * size of the memory buffer header.
-     */
-    int sizeToAlloc = size + sizeof(MemBufHdr);
+    MemBlk   *blk = NULL;
+    uint32_T sizeToAlloc;
 
-    while (!keepTrying) {
-        keepTrying = true;
+    if (!poolInitialized) initPool();
 
-        LocalMemBuf = NULL;
-        FreeMemBuf  = NULL;
+    /* Payload rounded up to the alignment and to the free list links. */
+    sizeToAlloc = (size + MEM_ALIGN - 1U) & ~(MEM_ALIGN - 1U);
+    if (sizeToAlloc < MEM_BLK_MIN_SIZE) sizeToAlloc = MEM_BLK_MIN_SIZE;
+    if (size > memStats.poolSize || sizeToAlloc < size) goto EXIT_POINT;
 
-        /* Initialize the free queue. */
-        if (FreeQueue == NULL) initFreeQueue();
+    blk = findFreeBlk(sizeToAlloc);
+    if (blk == NULL) goto EXIT_POINT;
+    removeFreeBlk(blk);
 
-        /* Find first free packet big enough for our request. */
-        FreeMemBuf = findFirstFreeMemBuf(sizeToAlloc);
-
-        if (FreeMemBuf == NULL) {
-            /* We couldn't find a free buffer.  Run garbage collection to merge
-               free buffers together and try again. */
-            sortQueue(FreeQueue);
-
-            FreeMemBuf = findFirstFreeMemBuf(sizeToAlloc);
-        }
+    /* Give the tail back if it can hold a block of its own. */
+    if (blkSize(blk) >= sizeToAlloc + MEM_BLK_HDR_SIZE + MEM_BLK_MIN_SIZE) {
+        MemBlk *rest = (MemBlk *)((char *)blk + MEM_BLK_HDR_SIZE + sizeToAlloc);
 
-        /* No free buffers are available which satisfy the request. */
-        if (FreeMemBuf == NULL) goto EXIT_POINT;
-
-        /*
-         * Found a free buffer with enough space.  Carve out the exact buffer size
-         * needed from the end of the free buffer.
-         */
-        LocalMemBuf = (MemBufHdr *)(FreeMemBuf->MemBuf +
-                                    FreeMemBuf->size -
-                                    sizeToAlloc);
-
-        /*
-         * The pointer to the free memory must be longword aligned.  If it
-         * is not, adjust the size to allocate and try again.
-         */
-        {
-            int alignBytes = (int)((ptrdiff_t)LocalMemBuf % 4);
-            if (alignBytes) {
-                sizeToAlloc += (4-alignBytes);
-                keepTrying = false;
-            }
-        }
+        rest->prevPhys = blk;
+        rest->size     = blkSize(blk) - sizeToAlloc - MEM_BLK_HDR_SIZE;
+        blkNextPhys(rest)->prevPhys = rest;
+        blk->size      = sizeToAlloc;
+        insertFreeBlk(rest);
     }
 
-    /* Set up the new packet's info. */
-    LocalMemBuf->memBufPrev = NULL;
-    LocalMemBuf->memBufNext = NULL;
-    LocalMemBuf->MemBuf     = (char *)LocalMemBuf + sizeof(MemBufHdr);
-    LocalMemBuf->size       = size;
-
-    /* Insert the newly created buffer into the InUseQueue. */
-    inUseQueueInsert(LocalMemBuf);
-
-    /* Update the free packet's size to reflect giving up a piece. */
-    FreeMemBuf->size -= sizeToAlloc;
+    memStats.inUse += blkSize(blk) + MEM_BLK_HDR_SIZE;
+    if (memStats.inUse > memStats.highWater) {
+        memStats.highWater = memStats.inUse;
+    }
 
   EXIT_POINT:
-    if (LocalMemBuf) {
+    if (blk != NULL) {
+        memStats.numAllocs++;
 #ifdef VERBOSE
-        numBytesAllocated += sizeToAlloc;
+        numBytesAllocated += blkSize(blk) + MEM_BLK_HDR_SIZE;
         printf("\nBytes allocated: %d out of %d.\n", numBytesAllocated, EXTMODE_STATIC_SIZE);
 #endif
-        return LocalMemBuf->MemBuf;
+        return blkPayload(blk);
     }
 
+    memStats.numFailed++;
 #ifdef VERBOSE
-    printf("\nBytes allocated: %d out of %d.", numBytesAllocated+sizeToAlloc, EXTMODE_STATIC_SIZE);
+    printf("\nBytes allocated: %d out of %d.", numBytesAllocated+size, EXTMODE_STATIC_SIZE);
     printf("\nMust increase size of static allocation!\n");
 #endif
     return NULL;
 }
+
+/* Function: ExtModeMemGetStats ================================================
+ * Abstract:
+ *  Usage statistics of the static pool.  The largest free block is found
+ *  by walking the list of the largest non-empty size class, so this is
+ *  meant for diagnostics rather than for the base rate.
+ */
+PUBLIC void ExtModeMemGetStats(ExtModeMemStats *stats)
+{
+    if (!poolInitialized) initPool();
+
+    *stats = memStats;
+    stats->largestFree   = 0U;
+    stats->fragmentation = 0U;
+
+    if (flBitmap != 0U) {
+        int    fl = memFls(flBitmap);
+        int    sl = memFls(slBitmap[fl]);
+        MemBlk *blk;
+
+        for (blk = freeLists[fl][sl]; blk != NULL; blk = blk->nextFree) {
+            if (blkSize(blk) > stats->largestFree) {
+                stats->largestFree = blkSize(blk);
+            }
+        }
+        stats->fragmentation = (uint32_T)(100U -
+            (uint32_T)(((real_T)stats->largestFree * 100.0) /
+                       (real_T)stats->freeBytes + 0.5));
+    }
+}
+
+/* [EOF] mem_mgr.c */
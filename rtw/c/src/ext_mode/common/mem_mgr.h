@@ -1,7 +1,7 @@
 /*
  * Copyright 1994-2002 The MathWorks, Inc.
  *
- * File: mem_mgr.h     
+ * File: mem_mgr.h
  *
  * Abstract:
  */
@@ -9,14 +9,17 @@
 #ifndef __MEM_MGR__
 #define __MEM_MGR__
 
-struct MemBufHdr {
-    struct MemBufHdr *memBufNext;
-    struct MemBufHdr *memBufPrev;
-    char   *MemBuf;
-    int    size;
-};
-
-typedef struct MemBufHdr MemBufHdr;
+typedef struct ExtModeMemStats_tag {
+    uint32_T poolSize;       /* bytes managed, headers included            */
+    uint32_T inUse;          /* bytes of allocated blocks and headers      */
+    uint32_T highWater;      /* largest inUse so far                       */
+    uint32_T freeBytes;      /* bytes available in free blocks             */
+    uint32_T numFreeBlocks;
+    uint32_T largestFree;    /* bytes in the largest free block            */
+    uint32_T fragmentation;  /* percent of freeBytes outside largestFree   */
+    uint32_T numAllocs;      /* successful allocations                     */
+    uint32_T numFailed;      /* allocations that found no room             */
+} ExtModeMemStats;
 
 extern void ExtModeFree(void *mem);
 
@@ -24,6 +27,8 @@ extern void *ExtModeMalloc(uint32_T size);
 
 extern void *ExtModeCalloc(uint32_T number, uint32_T size);
 
+extern void ExtModeMemGetStats(ExtModeMemStats *stats);
+
 #endif /* __MEM_MGR__ */
 
 /* [EOF] mem_mgr.h */
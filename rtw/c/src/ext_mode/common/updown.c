@@ -75,6 +75,40 @@
     #include EXTMODE_INTERRUPT_INC_HDR
 #endif
 
+/*
+ * The head of an upload buffer is only written by the task that adds data
+ * to it and its tail only by ext_svr, so the two can run on different cores
+ * without locks.  The head and tail are stored with release semantics and
+ * read with acquire semantics, so that the data is written before it is
+ * handed over (and read before its memory is reused) on weakly ordered
+ * targets:
+ *  o with C11 atomics when available,
+ *  o with the GCC __atomic builtins otherwise,
+ *  o else with volatile accesses, which is enough on targets running the
+ *    model and ext_svr on a single core (see above when reading a pointer
+ *    is not atomic).
+ * Staged parameter updates are handed over the same way (ParamEpoch).
+ */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+    !defined(__STDC_NO_ATOMICS__) && !defined(__cplusplus)
+    #include <stdatomic.h>
+    typedef char_T * _Atomic UploadBufPtr;
+    typedef uint32_T _Atomic ParamEpoch;
+    #define UPLOADBUF_LOAD(p)  atomic_load_explicit(&(p), memory_order_acquire)
+    #define UPLOADBUF_STORE(p, v) \
+        atomic_store_explicit(&(p), (v), memory_order_release)
+#elif defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+    typedef char_T * volatile UploadBufPtr;
+    typedef uint32_T volatile ParamEpoch;
+    #define UPLOADBUF_LOAD(p)     __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+    #define UPLOADBUF_STORE(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+#else
+    typedef char_T * volatile UploadBufPtr;
+    typedef uint32_T volatile ParamEpoch;
+    #define UPLOADBUF_LOAD(p)     (p)
+    #define UPLOADBUF_STORE(p, v) ((p) = (v))
+#endif
+
 /**********************
  * External Variables *
  **********************/
@@ -294,6 +328,222 @@ PUBLIC void SetParam(RTWExtModeInfo  *ei, const char *pbuf)
 #endif /* ifndef EXTMODE_DISABLEPARAMETERTUNING */
 
 
+#ifdef EXTMODE_STAGED_PARAMS
+/*
+ * Staged parameter updates (EXTMODE_STAGED_PARAMS).
+ *
+ * SetParam writes the parameter vector while the model tasks may be in the
+ * middle of a step, so a step can see part of an update, e.g. half of a
+ * lookup table.  When the model is running, ext_svr instead:
+ *  o decodes the packet with ParamStageBegin, and copies its data into a
+ *    shadow bank with ParamStageWork, EXTMODE_PARAM_SLICE_BYTES per call,
+ *    so that a large update does not hold up a background loop that shares
+ *    its thread with the model,
+ *  o publishes the complete bank by advancing paramStage.ready.
+ * The base rate task calls ParamStageCommit at the end of each step (from
+ * rtExtModeCheckEndTrigger), which copies a published bank into the
+ * parameter vector and acknowledges it in paramStage.done.  The model task
+ * takes no lock and never waits for ext_svr; the cost of a commit is the
+ * copy of the bytes of the update.
+ *
+ * ext_svr reads no packet while a bank is being staged (its data is in the
+ * packet buffer), and holds a new parameter packet until the previous bank
+ * is committed.  While the model is not running, ext_svr commits the bank
+ * itself.
+ *
+ * A base rate step sees all or none of an update; a slower task of a
+ * multitasking model whose step spans the commit can still see part of it.
+ */
+#ifndef EXTMODE_PARAM_SLICE_BYTES
+#define EXTMODE_PARAM_SLICE_BYTES 16384
+#endif
+
+/* Sections start on 8 byte boundaries in the bank */
+#define PARAM_STAGE_ALIGN(n) (((n) + 7) & ~7)
+
+typedef struct StagedParam_tag {
+    char_T     *dst;    /* section of the parameter vector          */
+    const char *src;    /* its data in the packet, while staging    */
+    int_T      nBytes;
+    int_T      offset;  /* of its data in the bank                  */
+} StagedParam;
+
+PRIVATE struct {
+    char_T     *bank;       /* nParams StagedParams, then their data */
+    int_T      bankSize;
+    int_T      nParams;
+    int_T      nextParam;   /* section being staged                  */
+    int_T      nextByte;    /* byte of that section                  */
+    boolean_T  staging;     /* the packet buffer is in use           */
+    ParamEpoch ready;       /* banks published (ext_svr)             */
+    ParamEpoch done;        /* banks committed (model task)          */
+} paramStage;
+
+
+/* Function: ParamStageBegin ===================================================
+ * Abstract:
+ *  Decode a parameter packet (see SetParam) of pktSize bytes for staging.
+ *  The packet must stay in place until ParamStageWork returns false, and
+ *  the previous update must be committed (ParamStageBusy returns false).
+ *
+ *  EXT_NO_ERROR is returned on success, EXT_ERROR if the shadow bank could
+ *  not be allocated.
+ */
+PUBLIC boolean_T ParamStageBegin(RTWExtModeInfo *ei,
+                                 const char     *pbuf,
+                                 int_T          pktSize)
+{
+    int         i;
+    int32_T     nParams;
+    int_T       offset;
+    int_T       size;
+    StagedParam *table;
+    const char  *bufPtr   = pbuf;
+    const int   B         = 0; /* index into dtype tran table (base address) */
+    const int   SI        = 1; /* starting index - wrt to base address       */
+    const int   W         = 2; /* width of section (number of elements)      */
+    const int   DI        = 3; /* index into data type tables                */
+    int32_T     tmpBuf[4];
+
+    const DataTypeTransInfo *dtInfo = (const DataTypeTransInfo *) rteiGetModelMappingInfo(ei);
+    const DataTypeTransitionTable *dtTable = dtGetParamDataTypeTrans(dtInfo);
+    const uint_T *dtSizes = dtGetDataTypeSizes(dtInfo);
+
+    /* unpack NPARAMS */
+    (void)memcpy(&nParams, bufPtr, sizeof(int32_T));
+    bufPtr += sizeof(int32_T);
+
+    /* the table, then the data of the sections: less than a packet, aligned */
+    offset = PARAM_STAGE_ALIGN(nParams * (int_T)sizeof(StagedParam));
+    size   = offset + pktSize + nParams*7;
+    if (size > paramStage.bankSize) {
+        free(paramStage.bank);
+        paramStage.bankSize = 0;
+        paramStage.bank = (char_T *)malloc(size);
+        if (paramStage.bank == NULL) return(EXT_ERROR);
+        paramStage.bankSize = size;
+    }
+    table = (StagedParam *)paramStage.bank;
+
+    for (i=0; i<nParams; i++) {
+        int_T elSize;
+
+        /* unpack B SI W DI */
+        (void)memcpy(tmpBuf, bufPtr, sizeof(tmpBuf));
+        bufPtr += sizeof(tmpBuf);
+
+        elSize = dtSizes[tmpBuf[DI]] *
+            (dtTransGetComplexFlag(dtTable, tmpBuf[B]) ? 2 : 1);
+
+        table[i].dst    = dtTransGetAddress(dtTable, tmpBuf[B]) +
+                          (tmpBuf[SI] * elSize);
+        table[i].src    = bufPtr;
+        table[i].nBytes = tmpBuf[W] * elSize;
+        table[i].offset = offset;
+
+        bufPtr += table[i].nBytes;
+        offset  = PARAM_STAGE_ALIGN(offset + table[i].nBytes);
+    }
+
+    paramStage.nParams   = nParams;
+    paramStage.nextParam = 0;
+    paramStage.nextByte  = 0;
+    paramStage.staging   = true;
+    return(EXT_NO_ERROR);
+} /* end ParamStageBegin */
+
+
+/* Function: ParamStageCommit ==================================================
+ * Abstract:
+ *  Install the published bank, if any, in the parameter vector.  Called by
+ *  the base rate task between steps; does not wait.
+ */
+PUBLIC void ParamStageCommit(void)
+{
+    uint32_T ready = UPLOADBUF_LOAD(paramStage.ready);
+
+    if (ready != paramStage.done) {
+        const StagedParam *table = (const StagedParam *)paramStage.bank;
+        int_T             i;
+
+        for (i=0; i<paramStage.nParams; i++) {
+            (void)memcpy(table[i].dst, paramStage.bank + table[i].offset,
+                         table[i].nBytes);
+        }
+        UPLOADBUF_STORE(paramStage.done, ready);
+    }
+} /* end ParamStageCommit */
+
+
+/* Function: ParamStageWork ====================================================
+ * Abstract:
+ *  Stage the next EXTMODE_PARAM_SLICE_BYTES of the update begun by
+ *  ParamStageBegin, and publish the bank once it is complete.  Called by
+ *  ext_svr; commits the bank as well when the model is not running.
+ *
+ *  Returns true while the packet buffer is still in use.
+ */
+PUBLIC boolean_T ParamStageWork(boolean_T modelRunning)
+{
+    if (paramStage.staging) {
+        StagedParam *table  = (StagedParam *)paramStage.bank;
+        int_T       nBudget = EXTMODE_PARAM_SLICE_BYTES;
+
+        while (paramStage.nextParam < paramStage.nParams) {
+            const StagedParam *param = &table[paramStage.nextParam];
+            int_T             n      = param->nBytes - paramStage.nextByte;
+
+            if (n > nBudget) n = nBudget;
+            (void)memcpy(paramStage.bank + param->offset + paramStage.nextByte,
+                         param->src + paramStage.nextByte, n);
+            paramStage.nextByte += n;
+            nBudget             -= n;
+            if (paramStage.nextByte < param->nBytes) {
+                return(true); /* out of budget */
+            }
+            paramStage.nextParam++;
+            paramStage.nextByte = 0;
+        }
+
+        /* hand the bank over to the model task */
+        paramStage.staging = false;
+        UPLOADBUF_STORE(paramStage.ready, (uint32_T)(paramStage.ready + 1U));
+    }
+
+    if (!modelRunning) {
+        ParamStageCommit();
+    }
+    return(false);
+} /* end ParamStageWork */
+
+
+/* Function: ParamStageBusy ====================================================
+ * Abstract:
+ *  Return true if an update is being staged or waits to be committed.
+ */
+PUBLIC boolean_T ParamStageBusy(void)
+{
+    return((boolean_T)(paramStage.staging ||
+                       (UPLOADBUF_LOAD(paramStage.done) != paramStage.ready)));
+} /* end ParamStageBusy */
+
+
+/* Function: ParamStageTerm ====================================================
+ * Abstract:
+ *  Free the shadow bank.  The model must no longer be running.
+ */
+PUBLIC void ParamStageTerm(void)
+{
+    free(paramStage.bank);
+    paramStage.bank      = NULL;
+    paramStage.bankSize  = 0;
+    paramStage.nParams   = 0;
+    paramStage.staging   = false;
+    UPLOADBUF_STORE(paramStage.done, paramStage.ready);
+} /* end ParamStageTerm */
+#endif /* ifdef EXTMODE_STAGED_PARAMS */
+
+
 /******************************************************************************
  * Parameter Upload                                                           *
  ******************************************************************************/
@@ -304,6 +554,21 @@ PUBLIC void SetParam(RTWExtModeInfo  *ei, const char *pbuf)
 /*=============================================================================
  * Circular buffer stuff.
  *============================================================================*/
+
+/*
+ * Alignment of the upload buffers (a power of 2), so that they start on a
+ * cache line.
+ */
+#ifndef EXTMODE_UPLOAD_BUF_ALIGN
+#define EXTMODE_UPLOAD_BUF_ALIGN 64
+#endif
+
+/*
+ * Size of the fixed part of an upload packet: [pktType nBytes nSys tid
+ * upInfoIdx t].  See UploadBufAddTimePoint().
+ */
+#define UPLOAD_PKT_HDR_SIZE (5*sizeof(int32_T) + sizeof(real_T))
+
 typedef struct BufMemList_tag {
 
 #if ASSERTS_ON
@@ -315,14 +580,28 @@ typedef struct BufMemList_tag {
 } BufMemList;
 
 
+/*
+ * Each time point is stored contiguously: when a packet does not fit between
+ * the head and the end of the buffer it is written at the start of the
+ * buffer instead, and wrapEnd records where the data before the wrap ends.
+ * The data between the tail and the head is thus always made of whole
+ * packets, in at most two pieces, which are handed as is to the transport.
+ *
+ * The buffer is empty when head == tail: the head never catches up with the
+ * tail from behind.  The head and wrapEnd belong to the task adding data, the
+ * tail to ext_svr (or to the task adding data when pre-triggering, while
+ * ext_svr does not read the buffer).
+ */
 typedef struct CircularBuf_tag {
-    volatile int_T    empty;
-
     int_T    bufSize;
-    char_T   *buf;
+    char_T   *buf;      /* aligned on EXTMODE_UPLOAD_BUF_ALIGN bytes */
+    char_T   *bufAlloc; /* as returned by malloc                     */
     
-    char_T* volatile head;
-    char_T* volatile tail;
+    UploadBufPtr head;
+    UploadBufPtr tail;
+    char_T       *wrapEnd;
+
+    uint32_T nOverFlows; /* time points which did not fit in the buffer */
 
     char_T   *newTail;
 
@@ -373,6 +652,9 @@ typedef struct UploadMap_tag {
     UploadSection *sections;
 
     int_T nBytes;  /* total number of bytes in this map */
+#ifdef MW_DYNAMIC_STRING_SUPPORT
+    boolean_T hasString;
+#endif
 } UploadMap;
 
 
@@ -772,6 +1054,35 @@ PRIVATE void InitUploadSection(
 } /* end InitUploadSection */
 
 
+/* Function ====================================================================
+ * Merge the sections of an UploadMap which are adjacent in memory, so that
+ * they are copied into the upload buffers with a single memcpy.  The data is
+ * uploaded in the order of the sections so this does not change the packets.
+ */
+PRIVATE void UploadMergeSections(UploadMap *map)
+{
+    int32_T i;
+    int32_T nMerged = 0;
+
+    for (i=0; i<map->nSections; i++) {
+        UploadSection *sect = &map->sections[i];
+        UploadSection *last = (nMerged > 0) ? &map->sections[nMerged-1] : NULL;
+
+#ifdef MW_DYNAMIC_STRING_SUPPORT
+        if (sect->isString) map->hasString = true;
+        if ((last != NULL) && (last->isString || sect->isString)) last = NULL;
+#endif
+        if ((last != NULL) &&
+            ((char_T *)last->start + last->nBytes == (char_T *)sect->start)) {
+            last->nBytes += sect->nBytes;
+        } else {
+            map->sections[nMerged++] = *sect;
+        }
+    }
+    map->nSections = nMerged;
+} /* end UploadMergeSections */
+
+
 /* Function ====================================================================
  * Initialize a SysUploadTable.  The callerBufPtr points to the current place in
  * the EXT_SELECT_SIGNALS pkt which should be the enableIdx field.  This
@@ -861,6 +1172,8 @@ PRIVATE boolean_T InitSysUploadTable(
             /* keep track of total number of bytes in this map */
             map->nBytes += uploadSection->nBytes;
         }
+
+        UploadMergeSections(map);
     }
     
 EXIT_POINT:
@@ -869,9 +1182,14 @@ EXIT_POINT:
 } /* end InitSysUploadTable */
 
 /* Function ====================================================================
- * Initialize circular buffer fields and allocate required memory.
+ * Initialize circular buffer fields and allocate required memory.  maxPktSize
+ * is the size of the largest packet of the buffer's tid: as packets are not
+ * split across the end of the buffer, up to that many bytes may be left
+ * unused before a wrap, so they are added to the size requested by the host.
  */
-PRIVATE boolean_T UploadBufInit(CircularBuf *circBuf, int32_T size)
+PRIVATE boolean_T UploadBufInit(CircularBuf *circBuf,
+                                int32_T     size,
+                                int_T       maxPktSize)
 {
     boolean_T error = NO_ERR;
 
@@ -885,20 +1203,28 @@ PRIVATE boolean_T UploadBufInit(CircularBuf *circBuf, int32_T size)
         error = EXT_ERROR; goto EXIT_POINT;
     }
 
-    circBuf->empty = true;
     if (size > 0) {
-        assert(circBuf->buf == NULL);
-        circBuf->buf = (char_T *)malloc(size);
-        if (circBuf->buf == NULL) {
+        size_t misalign;
+
+        size += maxPktSize;
+        assert(circBuf->bufAlloc == NULL);
+        circBuf->bufAlloc = (char_T *)malloc(size + EXTMODE_UPLOAD_BUF_ALIGN-1);
+        if (circBuf->bufAlloc == NULL) {
             error = EXT_ERROR; goto EXIT_POINT;
         }
+        misalign = (size_t)circBuf->bufAlloc & (EXTMODE_UPLOAD_BUF_ALIGN-1);
+        circBuf->buf = circBuf->bufAlloc +
+            ((EXTMODE_UPLOAD_BUF_ALIGN - misalign) & (EXTMODE_UPLOAD_BUF_ALIGN-1));
     } else {
-        circBuf->buf = NULL;
+        circBuf->bufAlloc = NULL;
+        circBuf->buf      = NULL;
     }
     circBuf->bufSize = size;
     
-    circBuf->head = circBuf->buf;
-    circBuf->tail = circBuf->buf;
+    UPLOADBUF_STORE(circBuf->head, circBuf->buf);
+    UPLOADBUF_STORE(circBuf->tail, circBuf->buf);
+    circBuf->wrapEnd    = circBuf->buf;
+    circBuf->nOverFlows = 0;
 
     circBuf->newTail = NULL;
 
@@ -1025,7 +1351,7 @@ PUBLIC void UploadLogInfoTerm(int32_T upInfoIdx, int_T numSampTimes)
     /* Free circular buf fields and bufMemLists. */
     if (uploadInfo->circBufs) {
         for (i=0; i<numSampTimes; i++) {
-            free(uploadInfo->circBufs[i].buf);
+            free(uploadInfo->circBufs[i].bufAlloc);
         }
         free(uploadInfo->circBufs);
     }
@@ -1134,17 +1460,31 @@ PUBLIC boolean_T UploadLogInfoInit(RTWExtModeInfo *ei,
     uploadInfo->circBufs = (CircularBuf *) calloc(numSampTimes,
                                                   sizeof(CircularBuf));
 
+    if (uploadInfo->circBufs == NULL) {
+        error = EXT_ERROR; goto EXIT_POINT;
+    }
+
     /*
      * Allocate the circular buffers.
      */
     nActiveTids = 0;
     for (i=0; i<numSampTimes; i++) {
         int32_T size;
+        int32_T sys;
+        int_T   maxPktSize = UPLOAD_PKT_HDR_SIZE;
         
         (void)memcpy(&size, bufPtr, sizeof(int32_T));
         bufPtr += sizeof(int32_T);
+
+        /* largest packet: all of the systems with data in this tid active */
+        for (sys=0; sys<uploadInfo->nSys; sys++) {
+            const UploadMap *map = uploadInfo->sysTables[sys].uploadMap[i];
+            if (map != NULL) {
+                maxPktSize += sizeof(int32_T) + map->nBytes;
+            }
+        }
         
-        error = UploadBufInit(&uploadInfo->circBufs[i], size);
+        error = UploadBufInit(&uploadInfo->circBufs[i], size, maxPktSize);
         if (error != EXT_NO_ERROR) goto EXIT_POINT;
 
         nActiveTids += (size != 0);
@@ -1315,11 +1655,12 @@ PUBLIC void UploadArmTrigger(int32_T upInfoIdx, int_T numSampTimes)
     for (tid=0; tid<numSampTimes; tid++) {
         CircularBuf *circBuf = &uploadInfo->circBufs[tid];
         if (circBuf->bufSize > 0) {
-            circBuf->head = circBuf->buf;
-            circBuf->tail = circBuf->buf;
+            UPLOADBUF_STORE(circBuf->head, circBuf->buf);
+            UPLOADBUF_STORE(circBuf->tail, circBuf->buf);
+            circBuf->wrapEnd    = circBuf->buf;
+            circBuf->nOverFlows = 0;
 
             circBuf->newTail = NULL;
-            circBuf->empty   = true;
         }
     }
 
@@ -1420,24 +1761,21 @@ PUBLIC void UploadBufDataSent(const int_T tid, int32_T upInfoIdx)
     CircularBuf  *circBuf    = &uploadInfo->circBufs[tid];            
 
     host_upstatus_is_uploading = true;
-    
-    /* Move the tail forward. */
-    circBuf->tail = circBuf->newTail;
         
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
     /* 
      * disable interrupts around this critical region. We need to 
-     * guarantee that reading the head pointer is an atomic 
+     * guarantee that writing the tail pointer is an atomic 
      * operation.
      */
     EXTMODE_DISABLE_INTERRUPTS;
 #endif
     
-    /* 
-     * Since we are moving the tail forward, we know that head == tail
-     * represents an empty buffer and not a full buffer.
+    /*
+     * Move the tail forward, releasing the memory that was sent to the task
+     * adding data.
      */
-    circBuf->empty = (circBuf->tail == circBuf->head);
+    UPLOADBUF_STORE(circBuf->tail, circBuf->newTail);
     
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
     /* re-enable interrupts */
@@ -1450,115 +1788,78 @@ PUBLIC void UploadBufDataSent(const int_T tid, int32_T upInfoIdx)
 /*
  * Macro =======================================================================
  * Move the tail of a circular buffer forward by one time step - accounting for
- * wrapping.
+ * wrapping.  Packets are contiguous, so the tail wraps when it reaches the end
+ * of the data before the wrap.  Only called by the task adding data, when
+ * pre-triggering.
  */
-#define MOVE_TAIL_ONESTEP(circBuf, end)                            \
+#define MOVE_TAIL_ONESTEP(circBuf)                                 \
 {                                                                  \
-    int     nBytesPassedEnd;                                       \
     int     nBytesInStep;                                          \
-    int32_T *nBytesPtr = (int32_T *)((circBuf)->tail)+1;           \
+    char_T  *head = (circBuf)->head;                               \
+    char_T  *tail = (circBuf)->tail;                               \
                                                                    \
-    (void)memcpy(&nBytesInStep, nBytesPtr, sizeof(int32_T));       \
+    if ((tail > head) && (tail == (circBuf)->wrapEnd)) {           \
+        tail = (circBuf)->buf;                                     \
+    }                                                              \
+    (void)memcpy(&nBytesInStep, (int32_T *)tail+1, sizeof(int32_T)); \
     nBytesInStep += (2*sizeof(int32_T));                           \
     assert(nBytesInStep > 0);                                      \
-    (circBuf)->tail += (nBytesInStep);                             \
-    nBytesPassedEnd = (int)((circBuf)->tail - (end));              \
-    if (nBytesPassedEnd >= 0) {                                    \
-        (circBuf)->tail = (circBuf)->buf + nBytesPassedEnd;        \
+    tail += (nBytesInStep);                                        \
+    if ((tail > head) && (tail == (circBuf)->wrapEnd)) {           \
+        tail = (circBuf)->buf;                                     \
     }                                                              \
+    UPLOADBUF_STORE((circBuf)->tail, tail);                        \
 } /* end MOVE_TAIL_ONESTEP */
 
 
-/*
- * Macro =======================================================================
- * Copy data into the circular buffer.
- */
-#define CIRCBUF_COPY_DATA(bufMem, data)                         \
-{                                                               \
-    (void)memcpy((bufMem).section1, (data), (bufMem).nBytes1);  \
-    if ((bufMem).section2 != NULL) {                            \
-        char *tmp = ((char *)(data)) + (bufMem).nBytes1;        \
-        (void)memcpy((bufMem).section2, tmp, (bufMem).nBytes2); \
-    }                                                           \
-} /* end CIRCBUF_COPY_DATA */
-
-
 /* Function ====================================================================
- * Assign sections in the circular buffer for the requested number of bytes
- * (i.e., fill in the bufMem struct).  If there is no room in the circular
- * buffer return an overflow error.
+ * Reserve nBytes of contiguous memory in the circular buffer and return its
+ * start, or NULL if there is no room (overflow).  If the bytes do not fit
+ * between the head and the end of the buffer they are taken at the start of
+ * the buffer, and the end of the data before the wrap is recorded.
  *
  * NOTE: Do not move the CircularBuffers head forward in this function!  
- *       Only move the tmpHead forward.  The actual head is not advanced
- *       until the entire time point is successfully copied into the buffer.
- *
- *       This function modifies tmpHead to point at the next available 
- *       location.
+ *       The actual head is not advanced until the entire time point is
+ *       successfully copied into the buffer.
  *
- *       It is possible for tmpHead to equal the tail upon entry to this
- *       function.  This does not necessarily mean that the buffer is
- *       empty (unwrapped).  It could also mean that the buffer is exactly
- *       full (this is considered as wrapped).
+ *       The head must stay strictly behind the tail of a wrapped buffer,
+ *       as head == tail means that the buffer is empty.
  */
 #ifndef EXTMODE_DISABLESIGNALMONITORING
-PRIVATE boolean_T UploadBufAssignMem(
-    CircularBuf  *circBuf,
-    int_T        nBytesToAdd,
-    char         **tmpHead,   /* in-out */
-    BufMem       *bufMem)     /* out */
+PRIVATE char_T *UploadBufReserve(CircularBuf *circBuf, int_T nBytes)
 {
-    int_T       nBytesLeft;
-    boolean_T   overFlow  = false;
-    char        *end      = circBuf->buf + circBuf->bufSize; /* 1 passed end */
+    char_T *head = circBuf->head;
+    char_T *tail;
+    char_T *end  = circBuf->buf + circBuf->bufSize; /* 1 passed end */
 
-    if ((*tmpHead > circBuf->tail) || circBuf->empty) {
-        /* buffer not wrapped */
-        nBytesLeft = (int_T)((end - *tmpHead) + (circBuf->tail - circBuf->buf));
-
-        if (nBytesLeft < nBytesToAdd) {
-            overFlow = true;
-            goto EXIT_POINT;
-        }
-
-        if ((*tmpHead + nBytesToAdd) < end) {
-            /* still not wrapped */
-            bufMem->nBytes1  = nBytesToAdd;
-            bufMem->section1 = *tmpHead;
-
-            bufMem->nBytes2  = 0;
-            bufMem->section2 = NULL;
+#ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
+    EXTMODE_DISABLE_INTERRUPTS;
+#endif
 
-            *tmpHead += nBytesToAdd;
-        } else {
-            /* now we're wrapped */
-            bufMem->nBytes1  = (int_T)(end - *tmpHead);
-            bufMem->section1 = *tmpHead;
+    tail = UPLOADBUF_LOAD(circBuf->tail);
 
-            bufMem->nBytes2  = nBytesToAdd - bufMem->nBytes1;
-            bufMem->section2 = (bufMem->nBytes2 > 0) ? circBuf->buf : NULL;
+#ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
+    EXTMODE_ENABLE_INTERRUPTS;
+#endif
 
-            *tmpHead = circBuf->buf + bufMem->nBytes2;
-        }  
+    if (head >= tail) {
+        /* buffer not wrapped (empty if head == tail) */
+        if ((end - head) >= nBytes) {
+            return(head);
+        }
+        if ((tail - circBuf->buf) > nBytes) {
+            /* wrap, leaving the end of the buffer unused */
+            circBuf->wrapEnd = head;
+            return(circBuf->buf);
+        }
     } else {
         /* wrapped */
-        nBytesLeft = (int_T)(circBuf->tail - *tmpHead);
-        if (nBytesLeft < nBytesToAdd) {
-            overFlow = true;
-            goto EXIT_POINT;
+        if ((tail - head) > nBytes) {
+            return(head);
         }
-
-        bufMem->nBytes1  = nBytesToAdd;
-        bufMem->section1 = *tmpHead;
-
-        bufMem->nBytes2  = 0;
-        bufMem->section2 = NULL;
-
-        *tmpHead += nBytesToAdd;
     }
-    
-EXIT_POINT:
-    return(overFlow);
-} /* end UploadBufAssignMem */
+    return(NULL);
+} /* end UploadBufReserve */
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 /* Function ====================================================================
@@ -1708,10 +2009,7 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
         circBuf->bufSize != 0) {
         
         int32_T     i;
-        BufMem      bufMem;
-        BufMem      pktStart;
-        int_T       size;
-        char_T *tmpHead    = circBuf->head;
+        char_T      *pkt;
         const int_T PKT_TYPE_IDX = 0;
         const int_T NBYTES_IDX   = 1;
         const int_T NSYS_IDX     = 2;
@@ -1719,43 +2017,78 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
         const int_T UPINFO_IDX   = 4;
 
         int32_T intHdr[5] = {0, 0, 0, 0, 0};
-        intHdr[UPINFO_IDX] = upInfoIdx;
+        int_T   pktSize   = UPLOAD_PKT_HDR_SIZE;
         
         if (preTrig && (trigInfo->preTrig.count==trigInfo->preTrig.duration)) {
             /* Advance the tail (we don't need the oldest point anymore). */
-            char *end = circBuf->buf + circBuf->bufSize;
-            MOVE_TAIL_ONESTEP(circBuf, end);
+            MOVE_TAIL_ONESTEP(circBuf);
             trigInfo->preTrig.count--;
         }
-        
+
         /*
-         * Save some space for the 5 integer values that make up the packet
-         * header: [pktType nBytes nSys tid upInfoIdx].
-         * The values are filled in later.
+         * Size the packet from the systems that are active, so that it can
+         * be reserved as a single piece of the buffer.
          */
-        size = 5*sizeof(int32_T);
-        overFlow = UploadBufAssignMem(circBuf, size, &tmpHead, &pktStart);
-        if (overFlow) goto EXIT_POINT;
+        for (i=0; i<uploadInfo->nSys; i++) {
+            const SysUploadTable *sysTable =
+                (const SysUploadTable *)&uploadInfo->sysTables[i];
+            
+            if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
+                 (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) ) {
+                const UploadMap *map = sysTable->uploadMap[tid];
+
+                if (map != NULL) {
+                    intHdr[NSYS_IDX]++;
+                    pktSize += sizeof(int32_T) + map->nBytes;
+                    
+#ifdef MW_DYNAMIC_STRING_SUPPORT
+                    if (map->hasString) {
+                        int_T section;
+                        for (section=0; section<map->nSections; section++) {
+                            const UploadSection *sect = &map->sections[section];
+                            if (sect->isString) {
+                                /* String data is [nBytes "abc...\0"] */
+                                const void* strPtr = *(void**)sect->start;
+                                pktSize += sizeof(int32_T) +
+                                    suStrlen(strPtr) + 1 - sect->nBytes;
+                            }
+                        }
+                    }
+#endif
+                }
+            }
+        }
+
+        /* If no systems were active then, do nothing. */
+        if (intHdr[NSYS_IDX] == 0) goto EXIT_POINT;
 
+        pkt = UploadBufReserve(circBuf, pktSize);
+        if (pkt == NULL) {
+            overFlow = true;
+            goto EXIT_POINT;
+        }
+        
         /*
+         * The packet header: [pktType nBytes nSys tid upInfoIdx].
+         *
          * We do not want to include the packet type and number of bytes
          * in the size calculation.  Size should represent the payload of
          * this packet.  The packet type and number of bytes represent the
          * packet header and are not included in the payload size.
          */
-        size -= 2*sizeof(int32_T);
-        intHdr[NBYTES_IDX] += size;
+        intHdr[PKT_TYPE_IDX] = EXT_UPLOAD_LOGGING_DATA;
+        intHdr[NBYTES_IDX]   = pktSize - 2*sizeof(int32_T);
+        intHdr[TID_IDX]      = tid;
+        intHdr[UPINFO_IDX]   = upInfoIdx;
+        (void)memcpy(pkt, intHdr, sizeof(intHdr));
+        pkt += sizeof(intHdr);
         
         /* time */
-        overFlow =
-            UploadBufAssignMem(circBuf, sizeof(real_T), &tmpHead, &bufMem);
-        if (overFlow) goto EXIT_POINT;
-        intHdr[NBYTES_IDX] += sizeof(real_T);
-        
-        CIRCBUF_COPY_DATA(bufMem, &taskTime);
+        (void)memcpy(pkt, &taskTime, sizeof(real_T));
+        pkt += sizeof(real_T);
 
         /*
-         * Check each system for an UploadMap. 
+         * Copy the data of each active system.
          */
         for (i=0; i<uploadInfo->nSys; i++) {
             const SysUploadTable *sysTable =
@@ -1763,24 +2096,18 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
             
             if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
                  (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) ) {
-                UploadMap *map = sysTable->uploadMap[tid];
+                const UploadMap *map = sysTable->uploadMap[tid];
 
                 if (map != NULL) {
                     int_T section;
-                    intHdr[NSYS_IDX]++;
                     
                     /* Add system index */
-                    size = sizeof(int32_T);
-                    overFlow =
-                        UploadBufAssignMem(circBuf, size, &tmpHead, &bufMem);
-                    if (overFlow) goto EXIT_POINT;
-                    intHdr[NBYTES_IDX] += size;
-                    
-                    CIRCBUF_COPY_DATA(bufMem, &i);
+                    (void)memcpy(pkt, &i, sizeof(int32_T));
+                    pkt += sizeof(int32_T);
                     
                     /* Add data values */
                     for (section=0; section<map->nSections; section++) {
-                        UploadSection *sect = &map->sections[section];
+                        const UploadSection *sect = &map->sections[section];
                         
 #ifdef MW_DYNAMIC_STRING_SUPPORT
                         if (sect->isString) {
@@ -1790,55 +2117,37 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
                             int32_T strNBytes = suStrlen(strPtr) + 1;
                             char *tmpStr;
                             
-                            overFlow = UploadBufAssignMem(circBuf, size, &tmpHead, &bufMem);
-                            if (overFlow) goto EXIT_POINT;
-                            intHdr[NBYTES_IDX] += size;
-                            CIRCBUF_COPY_DATA(bufMem, &strNBytes);
+                            (void)memcpy(pkt, &strNBytes, sizeof(int32_T));
+                            pkt += sizeof(int32_T);
 
                             /* Add character bytes */
-                            overFlow = UploadBufAssignMem(circBuf, strNBytes, &tmpHead, &bufMem);
-                            if (overFlow) goto EXIT_POINT;
-                            intHdr[NBYTES_IDX] += strNBytes;
-                            
                             tmpStr = suToCStr(strPtr);
-                            CIRCBUF_COPY_DATA(bufMem, tmpStr);
+                            (void)memcpy(pkt, tmpStr, strNBytes);
+                            pkt += strNBytes;
                             free(tmpStr);
                         } else
 #endif
                         
                         {
                             /* Regular cases */
-                            overFlow = UploadBufAssignMem(
-                                circBuf, sect->nBytes, &tmpHead, &bufMem);
-                            if (overFlow) goto EXIT_POINT;
-                            intHdr[NBYTES_IDX] += sect->nBytes;
-                            
-                            CIRCBUF_COPY_DATA(bufMem, sect->start);
+                            (void)memcpy(pkt, sect->start, sect->nBytes);
+                            pkt += sect->nBytes;
                         }
                     }
                 }
             }
         }
 
-        /* If no systems were active then, do nothing. */
-        if (intHdr[NSYS_IDX] == 0) goto EXIT_POINT;
-        
-        /*
-         * Go back and finish the header: [nBytes pktType nSys tid]
-         */
-        
-        /* ...pktType */
-        intHdr[PKT_TYPE_IDX] = EXT_UPLOAD_LOGGING_DATA;
-
-        /* ...tid */
-        intHdr[TID_IDX] = tid;
-        CIRCBUF_COPY_DATA(pktStart, intHdr);
-
         /*
-         * Time point successfully added to queue.
+         * Time point successfully added to queue: hand it over to ext_svr.
          */
-        circBuf->head  = tmpHead;
-        circBuf->empty = false;
+#ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
+        EXTMODE_DISABLE_INTERRUPTS;
+#endif
+        UPLOADBUF_STORE(circBuf->head, pkt);
+#ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
+        EXTMODE_ENABLE_INTERRUPTS;
+#endif
         
         if (preTrig) {
             trigInfo->preTrig.count++;
@@ -1848,8 +2157,15 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
 EXIT_POINT:
     if (!preTrig) {
         if (overFlow) {
+            /*
+             * The time point is dropped.  Unless EXTMODE_UPLOAD_DROP_ON_OVERFLOW
+             * is defined, this also terminates the data logging event.
+             */
+            circBuf->nOverFlows++;
             trigInfo->overFlow = true;
+#ifndef EXTMODE_UPLOAD_DROP_ON_OVERFLOW
             trigInfo->state    = TRIGGER_TERMINATING;
+#endif
         }
 #ifdef VXWORKS
         else if (trigInfo->state == TRIGGER_FIRED) {
@@ -1971,35 +2287,36 @@ PRIVATE void SetExtBufListFields(ExtBufMemList *extBufList,
 
     for (tid=0; tid<numSampTimes; tid++) {
         CircularBuf *circBuf = &uploadInfo->circBufs[tid];
-
-        if (!circBuf->empty) {
-            BufMem  *bufMem;
-            char_T  *head;
-            char_T  *tail   = circBuf->tail;
-            int_T   size    = circBuf->bufSize;
-
+        BufMem      *bufMem;
+        char_T      *head;
+        char_T      *tail;
             
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
-            /* 
-             * disable interrupts around this critical region. We need to 
-             * guarantee that reading the head pointer is an atomic 
-             * operation.
-             */
-            EXTMODE_DISABLE_INTERRUPTS;
+        /* 
+         * disable interrupts around this critical region. We need to 
+         * guarantee that reading the head and tail pointers is an atomic 
+         * operation.
+         */
+        EXTMODE_DISABLE_INTERRUPTS;
 #endif
 
-            head = circBuf->head;
-
+        /*
+         * Read the head first: the tail is only moved by the task adding
+         * data before it hands over a new head, when pre-triggering.
+         */
+        head = UPLOADBUF_LOAD(circBuf->head);
+        tail = circBuf->tail;
             
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
-            /* re-enable interrupts */
-            EXTMODE_ENABLE_INTERRUPTS;
+        /* re-enable interrupts */
+        EXTMODE_ENABLE_INTERRUPTS;
 #endif
 
+        if (head != tail) {
             /* Validate that head/tail ptrs are within allocated range. */
             assert((head >= circBuf->buf) && (tail >= circBuf->buf));
-            assert((head < circBuf->buf + circBuf->bufSize) &&
-                   (tail < circBuf->buf + circBuf->bufSize));
+            assert((head <= circBuf->buf + circBuf->bufSize) &&
+                   (tail <= circBuf->buf + circBuf->bufSize));
 
             bufMem = &bufList->bufs[bufList->nActiveBufs];
             bufList->tids[bufList->nActiveBufs] = tid;
@@ -2016,8 +2333,12 @@ PRIVATE void SetExtBufListFields(ExtBufMemList *extBufList,
                 bufMem->nBytes2  = 0;
                 bufMem->section2 = NULL;
             } else {
-                /* wrapped - 2 sections required */
-                bufMem->nBytes1 = (int_T)(circBuf->buf + size - tail);
+                /*
+                 * wrapped - 2 sections required, each made of whole packets.
+                 * The writer only moves wrapEnd when the buffer is not
+                 * wrapped, so it is consistent with the head read above.
+                 */
+                bufMem->nBytes1 = (int_T)(circBuf->wrapEnd - tail);
 
                 bufMem->nBytes2  = (int_T)(head - circBuf->buf);
                 bufMem->section2 = circBuf->buf;
@@ -2094,6 +2415,19 @@ PUBLIC void UploadBufGetData(ExtBufMemList *extBufList,
         SetExtBufListFieldsForEmptyList(extBufList, upInfoIdx);
     }
 } /* end UploadBufGetData */
+
+
+/* Function ====================================================================
+ * Return the number of time points of the specified tid which did not fit in
+ * its upload buffer since the trigger was last armed.
+ */
+PUBLIC uint32_T UploadBufNumOverFlows(int_T tid, int32_T upInfoIdx)
+{
+    BdUploadInfo *uploadInfo = &uploadInfoArray[upInfoIdx];
+
+    if (uploadInfo->circBufs == NULL) return(0);
+    return(uploadInfo->circBufs[tid].nOverFlows);
+} /* end UploadBufNumOverFlows */
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 
@@ -8,6 +8,17 @@
 
 #define NUM_UPINFOS   2 /* Number of UploadLogInfos in use */
 
+/*
+ * EXTMODE_STAGED_PARAMS: install the parameters of a packet received while
+ * the model runs at a base rate step boundary, all at once (see updown.c).
+ * Strings are allocated as they are installed, so rapid accelerator keeps
+ * installing parameters as they arrive.
+ */
+#if defined(EXTMODE_STAGED_PARAMS) && \
+    (defined(IS_RAPID_ACCEL) || defined(EXTMODE_DISABLEPARAMETERTUNING))
+#undef EXTMODE_STAGED_PARAMS
+#endif
+
 #ifdef __cplusplus
 
 extern "C" {
@@ -17,6 +28,20 @@ extern "C" {
 extern void      SetParam(RTWExtModeInfo  *ei,
                           const char      *pbuf);
 
+#ifdef EXTMODE_STAGED_PARAMS
+extern boolean_T ParamStageBegin(RTWExtModeInfo *ei,
+                                 const char     *pbuf,
+                                 int_T          pktSize);
+
+extern boolean_T ParamStageWork(boolean_T modelRunning);
+
+extern boolean_T ParamStageBusy(void);
+
+extern void      ParamStageCommit(void);
+
+extern void      ParamStageTerm(void);
+#endif
+
 extern void      UploadLogInfoReset(int32_T upInfoIdx);
 
 extern void      UploadPrepareForFinalFlush(int32_T upInfoIdx);
@@ -59,6 +84,9 @@ extern void      UploadBufGetData(ExtBufMemList *extBufList,
 
 extern boolean_T IsAnyDataReadyForUpload(int32_T upInfoIdx);
 
+extern uint32_T  UploadBufNumOverFlows(int_T   tid,
+                                       int32_T upInfoIdx);
+
 #ifdef __cplusplus
 
 }
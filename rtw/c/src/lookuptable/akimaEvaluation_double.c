@@ -111,11 +111,13 @@ void akimaFixedGrid_interpolate_double
                                             workspaceEvaluation,
                                             workspaceIndices,
                                             coefficients,
+                                            (void *)0,
                                             noDerivatives,
                                             numQ,
                                             Xq,
                                             binsXq,
                                             (void *)0,
+                                            (void *)0,
                                             Vq);
 }
 
@@ -171,20 +173,28 @@ void akimaFixedQuery_precompute_double
     MFL_INTERP_UINT b, jj, jj2, kk, kk2;
     double* H;
     double* dH;
+    akimaBinHint_double prevBin;
     H = akimaBasis;
     dH = H + N*2*numQ;
 
-    for (kk = 0; kk < numQ; ++kk) {
-        kk2 = 2*kk;
-        for (jj = 0; jj < N; ++jj) {
+    for (jj = 0; jj < N; ++jj) {
+        jj2 = jj*2*numQ;
+
+        /* Start the search for each query point from the bin of the previous one */
+        prevBin.bin = 0;
+        prevBin.x0 = gridVectors[jj][0];
+        prevBin.invDx = 0;
+
+        for (kk = 0; kk < numQ; ++kk) {
+            kk2 = 2*kk;
 
             b = binsXq ? binsXq[jj][kk]
-                       : akimaFindGridInterval1D_double(gridVectors[jj],
-                                                                       gridSize[jj],
-                                                                       Xq[jj][kk]);
+                       : akimaFindGridIntervalHint1D_double(gridVectors[jj],
+                                                                           gridSize[jj],
+                                                                           Xq[jj][kk],
+                                                                           &prevBin);
 
             /* Compute the first and second Hermite basis coefficients: */
-            jj2 = jj*2*numQ;
             akimaHermiteBasis1D_double(
                                         gridVectors[jj],
                                         gridSize[jj],
@@ -273,10 +283,12 @@ void akimaFixedQuery_interpolate_double
                                             tmp,
                                             work2,
                                             work1,
+                                            (void *)0,
                                             noDerivatives,
                                             numQ,
                                             Xq,
                                             binsXq,
+                                            (void *)0,
                                             akimaBasis,
                                             Vq);
 }
@@ -319,14 +331,256 @@ void akimaQueryBins_double
 )
 {
     MFL_INTERP_UINT i, k;
+    akimaBinHint_double prevBin;
 
     for (i = 0; i < N; ++i) {
+        /* Start the search for each query point from the bin of the previous one */
+        prevBin.bin = 0;
+        prevBin.x0 = gridVectors[i][0];
+        prevBin.invDx = 0;
         for (k = 0; k < numQ; ++k) {
-            binsXq[i][k] = akimaFindGridInterval1D_double(gridVectors[i],gridSize[i],Xq[i][k]);
+            binsXq[i][k] = akimaFindGridIntervalHint1D_double(gridVectors[i],gridSize[i],Xq[i][k],
+                                                                             &prevBin);
         }
     }
 }
 
+/**
+ * Initialize the bin search caches for a table's grid vectors. The caches are then passed to
+ * akimaQueryBinsHint_double() or akimaFixedGrid_interpolateHint_double() on each call for that
+ * table, and must be initialized again if its grid vectors change.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *
+ * \param[out] hints        Bin search cache for each grid vector. Must be \b pre-allocated
+ *                          with \p N entries.
+ */
+
+void akimaQueryBinHintsInit_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    /* OUTPUTS: */
+    akimaBinHint_double*          hints
+)
+{
+    MFL_INTERP_UINT i;
+
+    for (i = 0; i < N; ++i) {
+        akimaBinHintInit_double(gridVectors[i],gridSize[i],hints+i);
+    }
+}
+
+/**
+ * Find the bins (grid intervals) which contain the query points, starting the search in each
+ * dimension from the bin cached for the table. Returns the same bins as akimaQueryBins_double().
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  Xq     Query points vectors <tt> xq1, ..., xqN</tt> of length \p numQ.
+ * \param[in,out] hints  Bin search caches initialized by akimaQueryBinHintsInit_double().
+ *
+ * \param[out] binsXq Bins (grid intervals) containing the given query points \p Xq.
+ *                    binsXq has the same size as Xq and must be \b pre-allocated.
+ */
+
+void akimaQueryBinsHint_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    akimaBinHint_double*          hints,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT**             binsXq
+)
+{
+    MFL_INTERP_UINT i, k;
+
+    for (i = 0; i < N; ++i) {
+        for (k = 0; k < numQ; ++k) {
+            binsXq[i][k] = akimaFindGridIntervalHint1D_double(gridVectors[i],gridSize[i],Xq[i][k],
+                                                                             hints+i);
+        }
+    }
+}
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients, finding the bins of the
+ * query points from the bin search caches of the table. Otherwise the same as
+ * akimaFixedGrid_interpolate_double() with null binsXq.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  extrapMethod Specifies the extrapolation method:
+ *                              0 for Akima extrapolation,
+ *                              1 for Akima nearest-boundary extrapolation, or
+ *                              2 for Akima linear-boundary extrapolation.
+ * \param[in]  noDerivatives Switches between computing interpolation values or derivatives:
+ *                              0 for computing derivatives, or
+ *                              1 for computing values.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities.
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  coefficients \b Pre-computed Akima cubic polynomial coefficients.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  Xq     Query points vectors <tt> xq1, ..., xqN</tt> of length \p numQ.
+ * \param[in,out] hints  Bin search caches initialized by akimaQueryBinHintsInit_double().
+ *
+ * \param[out] Vq  Interpolation result at given query points \p Xq. Must be \b pre-allocated.
+ */
+
+void akimaFixedGrid_interpolateHint_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    akimaBinHint_double*          hints,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    akimaEvaluationViaHermiteBasis_double(
+                                            gridVectors,
+                                            gridSize,
+                                            N,
+                                            extrapMethod,
+                                            workspaceEvaluation,
+                                            workspaceIndices,
+                                            coefficients,
+                                            (void *)0,
+                                            noDerivatives,
+                                            numQ,
+                                            Xq,
+                                            (void *)0,
+                                            hints,
+                                            (void *)0,
+                                            Vq);
+}
+
+/**
+ * Pre-compute Akima cubic polynomial coefficients for fixed grid vectors and grid values, and
+ * store them in single precision. The 2^N coefficient arrays then take half the memory of
+ * akimaFixedGrid_precompute_double(), at the cost of single precision accuracy in the
+ * interpolated values. The coefficients must be within the range of single precision.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  gridValues   Values at each grid node.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities.
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  coefficients \b Pre-allocated workspace for the double precision coefficients.
+ *                          It is only needed during this call.
+ *
+ * \param[out] coefficientsSingle  Akima cubic polynomial coefficients in single precision.
+ */
+
+void akimaFixedGrid_precomputeSingle_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const double*  gridValues,
+    double*        work1,
+    MFL_INTERP_UINT*              work2,
+    double*        coefficients,
+    /* OUTPUTS: */
+    float*         coefficientsSingle
+)
+{
+    MFL_INTERP_UINT numelCoefficients, ii;
+
+    akimaCoefficients_double(gridVectors, gridValues, gridSize,
+                                            N, work1, work2, coefficients);
+
+    numelCoefficients = akimaProd(gridSize,N) * (((MFL_INTERP_UINT)1) << N);
+    for (ii = 0; ii < numelCoefficients; ++ii) {
+        coefficientsSingle[ii] = (float)coefficients[ii];
+    }
+}
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients stored in single precision
+ * by akimaFixedGrid_precomputeSingle_double(). The Hermite basis and the Akima formula are
+ * evaluated in double precision.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  extrapMethod Specifies the extrapolation method:
+ *                              0 for Akima extrapolation,
+ *                              1 for Akima nearest-boundary extrapolation, or
+ *                              2 for Akima linear-boundary extrapolation.
+ * \param[in]  noDerivatives Switches between computing interpolation values or derivatives:
+ *                              0 for computing derivatives, or
+ *                              1 for computing values.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities.
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  coefficientsSingle \b Pre-computed single precision Akima coefficients.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  Xq     Query points vectors <tt> xq1, ..., xqN</tt> of length \p numQ.
+ * \param[in,out] hints  Bin search caches initialized by akimaQueryBinHintsInit_double(),
+ *                       or null.
+ *
+ * \param[out] Vq  Interpolation result at given query points \p Xq. Must be \b pre-allocated.
+ */
+
+void akimaFixedGrid_interpolateSingle_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    const float*   coefficientsSingle,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    akimaBinHint_double*          hints,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    akimaEvaluationViaHermiteBasis_double(
+                                            gridVectors,
+                                            gridSize,
+                                            N,
+                                            extrapMethod,
+                                            workspaceEvaluation,
+                                            workspaceIndices,
+                                            (void *)0,
+                                            coefficientsSingle,
+                                            noDerivatives,
+                                            numQ,
+                                            Xq,
+                                            (void *)0,
+                                            hints,
+                                            (void *)0,
+                                            Vq);
+}
+
 
 /*------------------------------------------------------------------------------------------------*/
 /* 1-D optimizations:                                                                             */
@@ -424,6 +678,7 @@ void akimaFixedGrid_interpolate_1D_double
                                             numQ,
                                             xq,
                                             binsXq,
+                                            (void *)0,
                                             vq);
 }
 
@@ -474,11 +729,17 @@ void akimaFixedQuery_precompute_1D_double
 )
 {
     MFL_INTERP_UINT b, kk, kk2;
+    akimaBinHint_double prevBin;
+
+    /* Start the search for each query point from the bin of the previous one */
+    prevBin.bin = 0;
+    prevBin.x0 = x[0];
+    prevBin.invDx = 0;
 
     for (kk = 0; kk < numQ; ++kk) {
         kk2 = 2*kk;
 
-        b = binsXq ? binsXq[kk] : akimaFindGridInterval1D_double(x,nx,xq[kk]);
+        b = binsXq ? binsXq[kk] : akimaFindGridIntervalHint1D_double(x,nx,xq[kk],&prevBin);
 
         /* Compute the first and second Hermite basis coefficients: */
         akimaHermiteBasis1D_double(
@@ -551,6 +812,12 @@ void akimaFixedQuery_interpolate_1D_double
     double h1, h2, dh1, dh2;
     double* coefficients;
     double* tmp;
+    akimaBinHint_double prevBin;
+
+    /* Start the search for each query point from the bin of the previous one */
+    prevBin.bin = 0;
+    prevBin.x0 = x[0];
+    prevBin.invDx = 0;
 
     coefficients = workspace;
     tmp = workspace + (2*nx);
@@ -568,7 +835,7 @@ void akimaFixedQuery_interpolate_1D_double
     for (kk = 0; kk < numQ; ++kk) {
 
         /* Compute the bins if needed */
-        b = binsXq ? binsXq[kk] : akimaFindGridInterval1D_double(x,nx,xq[kk]);
+        b = binsXq ? binsXq[kk] : akimaFindGridIntervalHint1D_double(x,nx,xq[kk],&prevBin);
 
         /*
          * Form Hermite basis for each 1-D query point.
@@ -632,9 +899,104 @@ void akimaQueryBins_1D_double
     /* OUTPUTS: */
     MFL_INTERP_UINT*              binsXq
 )
+{
+    MFL_INTERP_UINT k;
+    akimaBinHint_double prevBin;
+
+    /* Start the search for each query point from the bin of the previous one */
+    prevBin.bin = 0;
+    prevBin.x0 = x[0];
+    prevBin.invDx = 0;
+
+    for (k = 0; k < numQ; ++k) {
+        binsXq[k] = akimaFindGridIntervalHint1D_double(x,nx,xq[k],&prevBin);
+    }
+}
+
+/**
+ * Optimized 1-D function.
+ *
+ * Find the bins (grid intervals) which contain the query points, starting the search from the
+ * bin cached for the table. Returns the same bins as akimaQueryBins_1D_double().
+ *
+ * \param[in]  nx     Number of 1-D grid coordinates.
+ * \param[in]  x      Vector of 1-D grid coordinates.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  xq     Query points vector representing coordinates for each query point.
+ * \param[in,out] hint  Bin search cache initialized by akimaQueryBinHintsInit_double() with
+ *                     <tt>N = 1</tt>.
+ *
+ * \param[out] binsXq Bins (grid intervals) containing the given query points \p Xq.
+ *                    binsXq has the same size as Xq and must be \b pre-allocated.
+ */
+
+void akimaQueryBinsHint_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         nx,
+    const double*  x,
+    const MFL_INTERP_UINT         numQ,
+    const double*  xq,
+    akimaBinHint_double*          hint,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT*              binsXq
+)
 {
     MFL_INTERP_UINT k;
     for (k = 0; k < numQ; ++k) {
-        binsXq[k] = akimaFindGridInterval1D_double(x,nx,xq[k]);
+        binsXq[k] = akimaFindGridIntervalHint1D_double(x,nx,xq[k],hint);
     }
 }
+
+/**
+ * Optimized 1-D function.
+ *
+ * Interpolate using pre-computed Akima cubic polynomial coefficients, finding the bins of the
+ * query points from the bin search cache of the table. Otherwise the same as
+ * akimaFixedGrid_interpolate_1D_double() with null binsXq.
+ *
+ * \param[in]  nx           Number of 1-D grid coordinates.
+ * \param[in]  x            Vector of 1-D grid coordinates.
+ * \param[in]  extrapMethod Specifies the extrapolation method:
+ *                              0 for Akima extrapolation,
+ *                              1 for Akima nearest-boundary extrapolation, or
+ *                              2 for Akima linear-boundary extrapolation.
+ * \param[in]  noDerivatives Switches between computing interpolation values or derivatives:
+ *                              0 for computing derivatives, or
+ *                              1 for computing values.
+ * \param[in]  coefficients \b Pre-computed Akima cubic polynomial coefficients.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  xq     Query points vector representing coordinates for each query point.
+ * \param[in,out] hint  Bin search cache initialized by akimaQueryBinHintsInit_double() with
+ *                     <tt>N = 1</tt>.
+ *
+ * \param[out] vq  Interpolation result at given query points \p xq. Must be \b pre-allocated.
+ */
+
+void akimaFixedGrid_interpolateHint_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const MFL_INTERP_UINT        extrapMethod,
+    const MFL_INTERP_UINT        noDerivatives,
+    double*       coefficients,
+    const MFL_INTERP_UINT        numQ,
+    const double* xq,
+    akimaBinHint_double*         hint,
+    /* OUTPUTS: */
+    double*       vq
+)
+{
+    akimaEvaluationViaHermiteBasis1D_double(
+                                            x,
+                                            nx,
+                                            extrapMethod,
+                                            coefficients,
+                                            noDerivatives,
+                                            numQ,
+                                            xq,
+                                            (void *)0,
+                                            hint,
+                                            vq);
+}
@@ -8,6 +8,7 @@ extern "C" {
 #endif
 
 #include "mfl_interp_util.h" /* MFL_INTERP_UINT */
+#include "akimaUtils_double.h" /* akimaBinHint_double */
 
 /**
  * \file
@@ -248,6 +249,178 @@ void akimaQueryBins_double
     MFL_INTERP_UINT**             binsXq
 );
 
+/**
+ * Initialize the bin search caches for a table's grid vectors. The caches are then passed to
+ * akimaQueryBinsHint_double() or akimaFixedGrid_interpolateHint_double() on each call for that
+ * table, and must be initialized again if its grid vectors change.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *
+ * \param[out] hints        Bin search cache for each grid vector. Must be \b pre-allocated
+ *                          with \p N entries.
+ */
+
+void akimaQueryBinHintsInit_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    /* OUTPUTS: */
+    akimaBinHint_double*          hints
+);
+
+/**
+ * Find the bins (grid intervals) which contain the query points, starting the search in each
+ * dimension from the bin cached for the table. Returns the same bins as akimaQueryBins_double().
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  Xq     Query points vectors <tt> xq1, ..., xqN</tt> of length \p numQ.
+ * \param[in,out] hints  Bin search caches initialized by akimaQueryBinHintsInit_double().
+ *
+ * \param[out] binsXq Bins (grid intervals) containing the given query points \p Xq.
+ *                    binsXq has the same size as Xq and must be \b pre-allocated.
+ */
+
+void akimaQueryBinsHint_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    akimaBinHint_double*          hints,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT**             binsXq
+);
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients, finding the bins of the
+ * query points from the bin search caches of the table. Otherwise the same as
+ * akimaFixedGrid_interpolate_double() with null binsXq.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  extrapMethod Specifies the extrapolation method:
+ *                              0 for Akima extrapolation,
+ *                              1 for Akima nearest-boundary extrapolation, or
+ *                              2 for Akima linear-boundary extrapolation.
+ * \param[in]  noDerivatives Switches between computing interpolation values or derivatives:
+ *                              0 for computing derivatives, or
+ *                              1 for computing values.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities.
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  coefficients \b Pre-computed Akima cubic polynomial coefficients.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  Xq     Query points vectors <tt> xq1, ..., xqN</tt> of length \p numQ.
+ * \param[in,out] hints  Bin search caches initialized by akimaQueryBinHintsInit_double().
+ *
+ * \param[out] Vq  Interpolation result at given query points \p Xq. Must be \b pre-allocated.
+ */
+
+void akimaFixedGrid_interpolateHint_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    akimaBinHint_double*          hints,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
+/**
+ * Pre-compute Akima cubic polynomial coefficients for fixed grid vectors and grid values, and
+ * store them in single precision. The 2^N coefficient arrays then take half the memory of
+ * akimaFixedGrid_precompute_double(), at the cost of single precision accuracy in the
+ * interpolated values. The coefficients must be within the range of single precision.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  gridValues   Values at each grid node.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities.
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  coefficients \b Pre-allocated workspace for the double precision coefficients.
+ *                          It is only needed during this call.
+ *
+ * \param[out] coefficientsSingle  Akima cubic polynomial coefficients in single precision.
+ */
+
+void akimaFixedGrid_precomputeSingle_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const double*  gridValues,
+    double*        work1,
+    MFL_INTERP_UINT*              work2,
+    double*        coefficients,
+    /* OUTPUTS: */
+    float*         coefficientsSingle
+);
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients stored in single precision
+ * by akimaFixedGrid_precomputeSingle_double(). The Hermite basis and the Akima formula are
+ * evaluated in double precision.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  extrapMethod Specifies the extrapolation method:
+ *                              0 for Akima extrapolation,
+ *                              1 for Akima nearest-boundary extrapolation, or
+ *                              2 for Akima linear-boundary extrapolation.
+ * \param[in]  noDerivatives Switches between computing interpolation values or derivatives:
+ *                              0 for computing derivatives, or
+ *                              1 for computing values.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities.
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  coefficientsSingle \b Pre-computed single precision Akima coefficients.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  Xq     Query points vectors <tt> xq1, ..., xqN</tt> of length \p numQ.
+ * \param[in,out] hints  Bin search caches initialized by akimaQueryBinHintsInit_double(),
+ *                       or null.
+ *
+ * \param[out] Vq  Interpolation result at given query points \p Xq. Must be \b pre-allocated.
+ */
+
+void akimaFixedGrid_interpolateSingle_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    const float*   coefficientsSingle,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    akimaBinHint_double*          hints,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
 
 /*------------------------------------------------------------------------------------------------*/
 /* 1-D optimizations:                                                                             */
@@ -458,6 +631,75 @@ void akimaQueryBins_1D_double
     MFL_INTERP_UINT*              binsXq
 );
 
+/**
+ * Optimized 1-D function.
+ *
+ * Find the bins (grid intervals) which contain the query points, starting the search from the
+ * bin cached for the table. Returns the same bins as akimaQueryBins_1D_double().
+ *
+ * \param[in]  nx     Number of 1-D grid coordinates.
+ * \param[in]  x      Vector of 1-D grid coordinates.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  xq     Query points vector representing coordinates for each query point.
+ * \param[in,out] hint  Bin search cache initialized by akimaQueryBinHintsInit_double() with
+ *                     <tt>N = 1</tt>.
+ *
+ * \param[out] binsXq Bins (grid intervals) containing the given query points \p Xq.
+ *                    binsXq has the same size as Xq and must be \b pre-allocated.
+ */
+
+void akimaQueryBinsHint_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         nx,
+    const double*  x,
+    const MFL_INTERP_UINT         numQ,
+    const double*  xq,
+    akimaBinHint_double*          hint,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT*              binsXq
+);
+
+/**
+ * Optimized 1-D function.
+ *
+ * Interpolate using pre-computed Akima cubic polynomial coefficients, finding the bins of the
+ * query points from the bin search cache of the table. Otherwise the same as
+ * akimaFixedGrid_interpolate_1D_double() with null binsXq.
+ *
+ * \param[in]  nx           Number of 1-D grid coordinates.
+ * \param[in]  x            Vector of 1-D grid coordinates.
+ * \param[in]  extrapMethod Specifies the extrapolation method:
+ *                              0 for Akima extrapolation,
+ *                              1 for Akima nearest-boundary extrapolation, or
+ *                              2 for Akima linear-boundary extrapolation.
+ * \param[in]  noDerivatives Switches between computing interpolation values or derivatives:
+ *                              0 for computing derivatives, or
+ *                              1 for computing values.
+ * \param[in]  coefficients \b Pre-computed Akima cubic polynomial coefficients.
+ * \param[in]  numQ   Number of query points.
+ * \param[in]  xq     Query points vector representing coordinates for each query point.
+ * \param[in,out] hint  Bin search cache initialized by akimaQueryBinHintsInit_double() with
+ *                     <tt>N = 1</tt>.
+ *
+ * \param[out] vq  Interpolation result at given query points \p xq. Must be \b pre-allocated.
+ */
+
+void akimaFixedGrid_interpolateHint_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const MFL_INTERP_UINT        extrapMethod,
+    const MFL_INTERP_UINT        noDerivatives,
+    double*       coefficients,
+    const MFL_INTERP_UINT        numQ,
+    const double* xq,
+    akimaBinHint_double*         hint,
+    /* OUTPUTS: */
+    double*       vq
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,8 @@
  * \param[in]  workspaceIndices     \b Pre-allocated workspace for sizes of each finite difference.
  *
  * \param[in]  coefficients  \b Pre-computed Akima cubic polynomial coefficients.
+ * \param[in]  coefficientsSingle  The same coefficients stored in single precision, used if
+ *                                 \p coefficients is null.
  *
  * \param[in]  noDerivatives 1 for interpolation/extrapolation and 0 for derivative computations.
  *
@@ -48,6 +50,9 @@
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out] Vq  If \p noDerivatives = 1, returns interpolation results at query points \p Xq.
  *                 Else, returns derivatives at query points \p Xq.
  *                 Must be \b pre-allocated.
@@ -62,10 +67,12 @@ void akimaEvaluationViaHermiteBasis_double
     double*        workspaceEvaluation,
     MFL_INTERP_UINT*              workspaceIndices,
     double*        coefficients,
+    const float*   coefficientsSingle,
     const MFL_INTERP_UINT         noDerivatives,
     const MFL_INTERP_UINT         numVq,
     const double** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_double*          hints,
     double*        hermXq,
     /* OUTPUTS: */
     double*        Vq
@@ -130,6 +137,30 @@ void akimaEvaluationViaHermiteBasis_double
         }
     }
 
+    /*
+     * The offsets of the corners of the N-D cube from its first corner qq are the same for all
+     * query points:
+     *   0
+     *   1
+     *
+     *     n1
+     *   1+n1
+     *
+     *        n1*n2
+     *   1   +n1*n2
+     *     n1+n1*n2
+     *   1+n1+n1*n2
+     *   ...
+     */
+    for (ii = 0; ii < N; ++ii) {
+        thisStride = gridSizeCumprod[ii];
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) { /* skip jj = 0 */
+            lastStride = strides[jj-ii2];
+            strides[jj] = lastStride + thisStride;
+        }
+    }
+
     /*
      * Evaluate N-D Akima polynomial interpolant.
      */
@@ -149,46 +180,30 @@ void akimaEvaluationViaHermiteBasis_double
                                     numVq,
                                     Xq,
                                     binsXq,
+                                    hints,
                                     hermXq,
                                     H,
                                     dH);
 
         /*
          * Sum interpolation result obtained at each corner of the N-D cube
-         * containing the query point Xq, i.e., sum interpolation results at:
-         *   qq
-         *   qq+1
-         *
-         *   qq  +n1
-         *   qq+1+n1
-         *
-         *   qq     +n1*n2
-         *   qq+1   +n1*n2
-         *   qq  +n1+n1*n2
-         *   qq+1+n1+n1*n2
-         *   ...
+         * containing the query point Xq, i.e., sum interpolation results at qq+strides[jj].
          */
 
-        /* Evaluate at a single N-D grid point: qq+strides[0] */
-        Vq[kk] = akimaHermitePolynomialND_double(
-                                                qq+strides[0],
-                                                N,
-                                                gridNumel,
-                                                coefficients,
-                                                H,
-                                                dH,
-                                                indH,
-                                                ndcube);
-
-        for (ii = 0; ii < N; ++ii) {
-
-            thisStride = gridSizeCumprod[ii];
+        if (coefficients != 0) {
 
-            ii2 = ((MFL_INTERP_UINT)1) << ii;
-            for (jj = ii2; jj < 2*ii2; ++jj) { /* skip jj = 0 */
+            /* Evaluate at a single N-D grid point: qq+strides[0] */
+            Vq[kk] = akimaHermitePolynomialND_double(
+                                                    qq+strides[0],
+                                                    N,
+                                                    gridNumel,
+                                                    coefficients,
+                                                    H,
+                                                    dH,
+                                                    indH,
+                                                    ndcube);
 
-                lastStride = strides[jj-ii2];
-                strides[jj] = lastStride + thisStride;
+            for (jj = 1; jj < pow2toN; ++jj) {
 
                 /* Evaluate at a single N-D grid point: qq+strides[jj] */
                 Vq[kk] += akimaHermitePolynomialND_double(
@@ -202,6 +217,31 @@ void akimaEvaluationViaHermiteBasis_double
                                                         ndcube);
             }
         }
+        else {
+
+            /* Same, reading single precision coefficients */
+            Vq[kk] = akimaHermitePolynomialNDSingle_double(
+                                                    qq+strides[0],
+                                                    N,
+                                                    gridNumel,
+                                                    coefficientsSingle,
+                                                    H,
+                                                    dH,
+                                                    indH,
+                                                    ndcube);
+
+            for (jj = 1; jj < pow2toN; ++jj) {
+                Vq[kk] += akimaHermitePolynomialNDSingle_double(
+                                                        qq+strides[jj],
+                                                        N,
+                                                        gridNumel,
+                                                        coefficientsSingle,
+                                                        H,
+                                                        dH,
+                                                        indH + jj*N,
+                                                        ndcube);
+            }
+        }
     }
 }
 
@@ -221,6 +261,8 @@ void akimaEvaluationViaHermiteBasis_double
  * \param[in]  numVq         Number of 1-D query points.
  * \param[in]  xq            1-D query points.
  * \param[in]  bq            Pre-computed bins for the query points. If NULL, compute the bins.
+ * \param[in,out] hint      Bin search cache for \p x, used if \p bq is NULL. If NULL, the search
+ *                          for each query point starts from the bin of the previous one.
  *
  * \param[out] vq  If \p noDerivatives = 1, returns interpolation results at query points \p xq.
  *                 Else, returns derivatives at query points \p xq.
@@ -237,12 +279,21 @@ void akimaEvaluationViaHermiteBasis1D_double
     const MFL_INTERP_UINT        numVq,
     const double* xq,
     const MFL_INTERP_UINT*       bq,
+    akimaBinHint_double*         hint,
     /* OUTPUTS: */
     double*       vq
 )
 {
     MFL_INTERP_UINT kk, b;
     double h1, h2, dh1, dh2;
+    akimaBinHint_double prevBin;
+
+    if (hint == 0) {
+        prevBin.bin = 0;
+        prevBin.x0 = x[0];
+        prevBin.invDx = 0;
+        hint = &prevBin;
+    }
 
     /*
      * Evaluate 1-D Akima polynomial interpolant.
@@ -250,7 +301,7 @@ void akimaEvaluationViaHermiteBasis1D_double
     for (kk = 0; kk < numVq; ++kk) {
 
         /* Compute the bins if needed */
-        b = bq ? bq[kk] : akimaFindGridInterval1D_double(x,nx,xq[kk]);
+        b = bq ? bq[kk] : akimaFindGridIntervalHint1D_double(x,nx,xq[kk],hint);
 
         /*
          * Form Hermite basis for each 1-D query point.
@@ -275,6 +326,49 @@ void akimaEvaluationViaHermiteBasis1D_double
     }
 }
 
+/**
+ * Evaluate the Akima formula on a contiguous N-D cube of Akima coefficients, in place.
+ *
+ * \param[in]  N          Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  H          First Hermite basis coefficient.
+ * \param[in]  dH         Second Hermite basis coefficient.
+ * \param[in]  indH       Indices to loop through the Hermite coefficients in the right order.
+ * \param[in]  ndcube     Akima coefficients c0, c1, c2, c12, ... of one N-D grid node.
+ *
+ * \return  Interpolation result at one N-D grid node
+ */
+static double akimaHermiteReduceND_double
+(
+    const MFL_INTERP_UINT         N,
+    const double*  H,
+    const double*  dH,
+    const MFL_INTERP_UINT*        indH,
+    double*        ndcube
+)
+{
+    MFL_INTERP_UINT ii, jj, ii2, jjh;
+
+    for (ii = N; ii > 0; --ii) {
+        /*
+         * Evaluate polynomial in this dimension and then reduce
+         * the cube's dimension by 1 and move on to the next higher dimension:
+         */
+
+        jjh = 2*(N-ii) + indH[N-ii];
+        ii2 = ((MFL_INTERP_UINT)1) << (ii-1);
+        for (jj = 0; jj < ii2; ++jj) {
+
+            ndcube[jj] = ndcube[2*jj] * H[jjh] + ndcube[2*jj+1] * dH[jjh];
+
+        }
+    }
+
+    /*
+     * Akima formula was accumulated in the first cube entry:
+     */
+    return ndcube[0];
+}
+
 /**
  * Multiply Hermite basis with Akima coefficients to evaluate cubic interpolant at one N-D node
  * in the N-D grid.
@@ -302,7 +396,7 @@ double akimaHermitePolynomialND_double
     double*        ndcube
 )
 {
-    MFL_INTERP_UINT ii, jj, ii2, jjh;
+    MFL_INTERP_UINT ii, jj, ii2;
     /*
      * Place Akima coefficients c0, c1, c2, c12, c3, c13, c23, c123 ... on an N-D cube:
      *
@@ -332,25 +426,48 @@ double akimaHermitePolynomialND_double
     /*
      * Finally, compute on the contiguous N-D cube:
      */
-    for (ii = N; ii > 0; --ii) {
-        /*
-         * Evaluate polynomial in this dimension and then reduce
-         * the cube's dimension by 1 and move on to the next higher dimension:
-         */
-
-        jjh = 2*(N-ii) + indH[N-ii];
-        ii2 = ((MFL_INTERP_UINT)1) << (ii-1);
-        for (jj = 0; jj < ii2; ++jj) {
+    return akimaHermiteReduceND_double(N, H, dH, indH, ndcube);
+}
 
-            ndcube[jj] = ndcube[2*jj] * H[jjh] + ndcube[2*jj+1] * dH[jjh];
+/**
+ * Multiply Hermite basis with single precision Akima coefficients to evaluate cubic interpolant
+ * at one N-D node in the N-D grid. The coefficients are widened to double before the Akima
+ * formula is evaluated.
+ *
+ * \param[in]  qq         Current linear index into N-D Akima coefficients.
+ * \param[in]  N          Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridNumel  Number of nodes in the grid: <tt>prod(gridSize)</tt>.
+ * \param[in]  C          Akima cubic polynomial coefficients, in single precision.
+ * \param[in]  H          First Hermite basis coefficient.
+ * \param[in]  dH         Second Hermite basis coefficient.
+ * \param[in]  indH       Indices to loop through the Hermite coefficients in the right order.
+ * \param[in]  ndcube     Workspace for N-D polynomial evaluation.
+ *
+ * \return  Interpolation result at one N-D grid node
+ */
+double akimaHermitePolynomialNDSingle_double
+(
+    const MFL_INTERP_UINT         qq,
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT         gridNumel,
+    const float*   C,
+    const double*  H,
+    const double*  dH,
+    const MFL_INTERP_UINT*        indH,
+    double*        ndcube
+)
+{
+    MFL_INTERP_UINT ii, jj, ii2;
 
+    ndcube[0] = (double)C[qq];
+    for (ii = 0; ii < N; ++ii) {
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) { /* skip jj = 0 */
+            ndcube[jj] = (double)C[jj*gridNumel + qq];
         }
     }
 
-    /*
-     * Akima formula was accumulated in the first cube entry:
-     */
-    return ndcube[0];
+    return akimaHermiteReduceND_double(N, H, dH, indH, ndcube);
 }
 
 /**
@@ -383,6 +500,9 @@ double akimaHermitePolynomialND_double
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out]  H      First Hermite basis coefficient.
  * \param[out]  dH     Second Hermite basis coefficient.
  * \return             Linear index of query point relative to the N-D grid
@@ -400,6 +520,7 @@ MFL_INTERP_UINT akimaHermiteBasisND_double
     const MFL_INTERP_UINT         numVq,
     const double** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_double*          hints,
     double*        hermXq,
     /* OUTPUTS: */
     double*        H,
@@ -413,6 +534,10 @@ MFL_INTERP_UINT akimaHermiteBasisND_double
     for (jj = 0; jj < N; ++jj) {
 
         b = binsXq ? binsXq[jj][kk]
+                   : hints ? akimaFindGridIntervalHint1D_double(gridVectors[jj],
+                                                                gridSize[jj],
+                                                                Xq[jj][kk],
+                                                                hints+jj)
                    : akimaFindGridInterval1D_double(gridVectors[jj],
                                                                    gridSize[jj],
                                                                    Xq[jj][kk]);
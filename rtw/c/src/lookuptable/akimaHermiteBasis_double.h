@@ -4,6 +4,7 @@
 #define _MFL_INTERP_AKIMAHERMITEBASIS_double_H_
 
 #include "mfl_interp_util.h" /* MFL_INTERP_UINT */
+#include "akimaUtils_double.h" /* akimaBinHint_double */
 
 /**
  * \file
@@ -30,6 +31,8 @@
  * \param[in]  workspaceIndices     \b Pre-allocated workspace for sizes of each finite difference.
  *
  * \param[in]  coefficients  \b Pre-computed Akima cubic polynomial coefficients.
+ * \param[in]  coefficientsSingle  The same coefficients stored in single precision, used if
+ *                                 \p coefficients is null.
  *
  * \param[in]  noDerivatives 1 for interpolation/extrapolation and 0 for derivative computations.
  *
@@ -47,6 +50,9 @@
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out] Vq  If \p noDerivatives = 1, returns interpolation results at query points \p Xq.
  *                 Else, returns derivatives at query points \p Xq.
  *                 Must be \b pre-allocated.
@@ -61,10 +67,12 @@ void akimaEvaluationViaHermiteBasis_double
     double*        workspaceEvaluation,
     MFL_INTERP_UINT*              workspaceIndices,
     double*        coefficients,
+    const float*   coefficientsSingle,
     const MFL_INTERP_UINT         noDerivatives,
     const MFL_INTERP_UINT         numVq,
     const double** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_double*          hints,
     double*        hermXq,
     /* OUTPUTS: */
     double*        Vq
@@ -86,6 +94,8 @@ void akimaEvaluationViaHermiteBasis_double
  * \param[in]  numVq         Number of 1-D query points.
  * \param[in]  xq            1-D query points.
  * \param[in]  bq            Pre-computed bins for the query points. If NULL, compute the bins.
+ * \param[in,out] hint      Bin search cache for \p x, used if \p bq is NULL. If NULL, the search
+ *                          for each query point starts from the bin of the previous one.
  *
  * \param[out] vq  If \p noDerivatives = 1, returns interpolation results at query points \p xq.
  *                 Else, returns derivatives at query points \p xq.
@@ -102,6 +112,7 @@ void akimaEvaluationViaHermiteBasis1D_double
     const MFL_INTERP_UINT        numVq,
     const double* xq,
     const MFL_INTERP_UINT*       bq,
+    akimaBinHint_double*         hint,
     /* OUTPUTS: */
     double*       vq
 );
@@ -133,6 +144,33 @@ double akimaHermitePolynomialND_double
     double*        ndcube
 );
 
+/**
+ * Multiply Hermite basis with single precision Akima coefficients to evaluate cubic interpolant
+ * at one N-D node in the N-D grid.
+ *
+ * \param[in]  qq         Current linear index into N-D Akima coefficients.
+ * \param[in]  N          Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridNumel  Number of nodes in the grid: <tt>prod(gridSize)</tt>.
+ * \param[in]  C          Akima cubic polynomial coefficients, in single precision.
+ * \param[in]  H          First Hermite basis coefficient.
+ * \param[in]  dH         Second Hermite basis coefficient.
+ * \param[in]  indH       Indices to loop through the Hermite coefficients in the right order.
+ * \param[in]  ndcube     Workspace for N-D polynomial evaluation.
+ *
+ * \return  Interpolation result at one N-D grid node
+ */
+double akimaHermitePolynomialNDSingle_double
+(
+    const MFL_INTERP_UINT         qq,
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT         gridNumel,
+    const float*   C,
+    const double*  H,
+    const double*  dH,
+    const MFL_INTERP_UINT*        indH,
+    double*        ndcube
+);
+
 /**
  * Form Hermite basis for an N-D query point.
  *
@@ -163,6 +201,9 @@ double akimaHermitePolynomialND_double
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out]  H      First Hermite basis coefficient.
  * \param[out]  dH     Second Hermite basis coefficient.
  * \return             Linear index of query point relative to the N-D grid
@@ -180,6 +221,7 @@ MFL_INTERP_UINT akimaHermiteBasisND_double
     const MFL_INTERP_UINT         numVq,
     const double** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_double*          hints,
     double*        hermXq,
     /* OUTPUTS: */
     double*        H,
@@ -48,6 +48,9 @@
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out] Vq  If \p noDerivatives = 1, returns interpolation results at query points \p Xq.
  *                 Else, returns derivatives at query points \p Xq.
  *                 Must be \b pre-allocated.
@@ -66,6 +69,7 @@ void akimaEvaluationViaHermiteBasis_float
     const MFL_INTERP_UINT         numVq,
     const float** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_float*          hints,
     float*        hermXq,
     /* OUTPUTS: */
     float*        Vq
@@ -130,6 +134,30 @@ void akimaEvaluationViaHermiteBasis_float
         }
     }
 
+    /*
+     * The offsets of the corners of the N-D cube from its first corner qq are the same for all
+     * query points:
+     *   0
+     *   1
+     *
+     *     n1
+     *   1+n1
+     *
+     *        n1*n2
+     *   1   +n1*n2
+     *     n1+n1*n2
+     *   1+n1+n1*n2
+     *   ...
+     */
+    for (ii = 0; ii < N; ++ii) {
+        thisStride = gridSizeCumprod[ii];
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) { /* skip jj = 0 */
+            lastStride = strides[jj-ii2];
+            strides[jj] = lastStride + thisStride;
+        }
+    }
+
     /*
      * Evaluate N-D Akima polynomial interpolant.
      */
@@ -149,24 +177,14 @@ void akimaEvaluationViaHermiteBasis_float
                                     numVq,
                                     Xq,
                                     binsXq,
+                                    hints,
                                     hermXq,
                                     H,
                                     dH);
 
         /*
          * Sum interpolation result obtained at each corner of the N-D cube
-         * containing the query point Xq, i.e., sum interpolation results at:
-         *   qq
-         *   qq+1
-         *
-         *   qq  +n1
-         *   qq+1+n1
-         *
-         *   qq     +n1*n2
-         *   qq+1   +n1*n2
-         *   qq  +n1+n1*n2
-         *   qq+1+n1+n1*n2
-         *   ...
+         * containing the query point Xq, i.e., sum interpolation results at qq+strides[jj].
          */
 
         /* Evaluate at a single N-D grid point: qq+strides[0] */
@@ -180,27 +198,18 @@ void akimaEvaluationViaHermiteBasis_float
                                                 indH,
                                                 ndcube);
 
-        for (ii = 0; ii < N; ++ii) {
-
-            thisStride = gridSizeCumprod[ii];
-
-            ii2 = ((MFL_INTERP_UINT)1) << ii;
-            for (jj = ii2; jj < 2*ii2; ++jj) { /* skip jj = 0 */
-
-                lastStride = strides[jj-ii2];
-                strides[jj] = lastStride + thisStride;
-
-                /* Evaluate at a single N-D grid point: qq+strides[jj] */
-                Vq[kk] += akimaHermitePolynomialND_float(
-                                                        qq+strides[jj],
-                                                        N,
-                                                        gridNumel,
-                                                        coefficients,
-                                                        H,
-                                                        dH,
-                                                        indH + jj*N,
-                                                        ndcube);
-            }
+        for (jj = 1; jj < pow2toN; ++jj) {
+
+            /* Evaluate at a single N-D grid point: qq+strides[jj] */
+            Vq[kk] += akimaHermitePolynomialND_float(
+                                                    qq+strides[jj],
+                                                    N,
+                                                    gridNumel,
+                                                    coefficients,
+                                                    H,
+                                                    dH,
+                                                    indH + jj*N,
+                                                    ndcube);
         }
     }
 }
@@ -221,6 +230,8 @@ void akimaEvaluationViaHermiteBasis_float
  * \param[in]  numVq         Number of 1-D query points.
  * \param[in]  xq            1-D query points.
  * \param[in]  bq            Pre-computed bins for the query points. If NULL, compute the bins.
+ * \param[in,out] hint      Bin search cache for \p x, used if \p bq is NULL. If NULL, the search
+ *                          for each query point starts from the bin of the previous one.
  *
  * \param[out] vq  If \p noDerivatives = 1, returns interpolation results at query points \p xq.
  *                 Else, returns derivatives at query points \p xq.
@@ -237,12 +248,21 @@ void akimaEvaluationViaHermiteBasis1D_float
     const MFL_INTERP_UINT        numVq,
     const float* xq,
     const MFL_INTERP_UINT*       bq,
+    akimaBinHint_float*         hint,
     /* OUTPUTS: */
     float*       vq
 )
 {
     MFL_INTERP_UINT kk, b;
     float h1, h2, dh1, dh2;
+    akimaBinHint_float prevBin;
+
+    if (hint == 0) {
+        prevBin.bin = 0;
+        prevBin.x0 = x[0];
+        prevBin.invDx = 0;
+        hint = &prevBin;
+    }
 
     /*
      * Evaluate 1-D Akima polynomial interpolant.
@@ -250,7 +270,7 @@ void akimaEvaluationViaHermiteBasis1D_float
     for (kk = 0; kk < numVq; ++kk) {
 
         /* Compute the bins if needed */
-        b = bq ? bq[kk] : akimaFindGridInterval1D_float(x,nx,xq[kk]);
+        b = bq ? bq[kk] : akimaFindGridIntervalHint1D_float(x,nx,xq[kk],hint);
 
         /*
          * Form Hermite basis for each 1-D query point.
@@ -383,6 +403,9 @@ float akimaHermitePolynomialND_float
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out]  H      First Hermite basis coefficient.
  * \param[out]  dH     Second Hermite basis coefficient.
  * \return             Linear index of query point relative to the N-D grid
@@ -400,6 +423,7 @@ MFL_INTERP_UINT akimaHermiteBasisND_float
     const MFL_INTERP_UINT         numVq,
     const float** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_float*          hints,
     float*        hermXq,
     /* OUTPUTS: */
     float*        H,
@@ -413,6 +437,10 @@ MFL_INTERP_UINT akimaHermiteBasisND_float
     for (jj = 0; jj < N; ++jj) {
 
         b = binsXq ? binsXq[jj][kk]
+                   : hints ? akimaFindGridIntervalHint1D_float(gridVectors[jj],
+                                                                gridSize[jj],
+                                                                Xq[jj][kk],
+                                                                hints+jj)
                    : akimaFindGridInterval1D_float(gridVectors[jj],
                                                                    gridSize[jj],
                                                                    Xq[jj][kk]);
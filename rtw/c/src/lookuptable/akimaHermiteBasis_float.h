@@ -4,6 +4,7 @@
 #define _MFL_INTERP_AKIMAHERMITEBASIS_float_H_
 
 #include "mfl_interp_util.h" /* MFL_INTERP_UINT */
+#include "akimaUtils_float.h" /* akimaBinHint_float */
 
 /**
  * \file
@@ -47,6 +48,9 @@
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out] Vq  If \p noDerivatives = 1, returns interpolation results at query points \p Xq.
  *                 Else, returns derivatives at query points \p Xq.
  *                 Must be \b pre-allocated.
@@ -65,6 +69,7 @@ void akimaEvaluationViaHermiteBasis_float
     const MFL_INTERP_UINT         numVq,
     const float** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_float*          hints,
     float*        hermXq,
     /* OUTPUTS: */
     float*        Vq
@@ -86,6 +91,8 @@ void akimaEvaluationViaHermiteBasis_float
  * \param[in]  numVq         Number of 1-D query points.
  * \param[in]  xq            1-D query points.
  * \param[in]  bq            Pre-computed bins for the query points. If NULL, compute the bins.
+ * \param[in,out] hint      Bin search cache for \p x, used if \p bq is NULL. If NULL, the search
+ *                          for each query point starts from the bin of the previous one.
  *
  * \param[out] vq  If \p noDerivatives = 1, returns interpolation results at query points \p xq.
  *                 Else, returns derivatives at query points \p xq.
@@ -102,6 +109,7 @@ void akimaEvaluationViaHermiteBasis1D_float
     const MFL_INTERP_UINT        numVq,
     const float* xq,
     const MFL_INTERP_UINT*       bq,
+    akimaBinHint_float*         hint,
     /* OUTPUTS: */
     float*       vq
 );
@@ -163,6 +171,9 @@ float akimaHermitePolynomialND_float
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
  *
+ * \param[in,out] hints  Bin search caches for the grid vectors, used if \p binsXq is null.
+ *                       May be null.
+ *
  * \param[out]  H      First Hermite basis coefficient.
  * \param[out]  dH     Second Hermite basis coefficient.
  * \return             Linear index of query point relative to the N-D grid
@@ -180,6 +191,7 @@ MFL_INTERP_UINT akimaHermiteBasisND_float
     const MFL_INTERP_UINT         numVq,
     const float** Xq,
     MFL_INTERP_UINT**             binsXq,
+    akimaBinHint_float*          hints,
     float*        hermXq,
     /* OUTPUTS: */
     float*        H,
@@ -57,6 +57,147 @@ MFL_INTERP_UINT akimaFindGridInterval1D_double
     return b;
 }
 
+/**
+ * Initialize the bin search cache for a vector of 1-D grid coordinates.
+ *
+ * \param[in]  x     Vector of 1-D grid coordinates.
+ * \param[in]  n     <tt>numel(x)</tt>.
+ *
+ * \param[out] hint  Bin search cache for \p x.
+ */
+void akimaBinHintInit_double
+(
+    const double* x,
+    const MFL_INTERP_UINT        n,
+    akimaBinHint_double*         hint
+)
+{
+    MFL_INTERP_UINT jj;
+    double dx;
+
+    hint->bin = 0;
+    hint->x0 = x[0];
+    hint->invDx = 0;
+
+    /*
+     * Use the spacing only if every coordinate lies within a quarter of it from its evenly spaced
+     * position. The bin computed from the spacing is then off by at most one.
+     */
+    dx = (x[n-1] - x[0]) / (double)(n-1);
+    if (dx > 0) { /* false for NaN */
+        for (jj = 1; jj < n-1; ++jj) {
+            if ( !(akimaAbs_double(x[jj] - (x[0] + (double)jj*dx)) <= dx/4) ) {
+                break;
+            }
+        }
+        if (jj >= n-1) {
+            hint->invDx = 1/dx;
+        }
+    }
+}
+
+/**
+ * Find the bins (grid intervals) containing a given 1-D query point, starting the search from a
+ * cached bin.
+ *
+ * \param[in]     x     Vector of 1-D grid coordinates.
+ * \param[in]     n     <tt>numel(x)</tt>.
+ * \param[in]     xq    Query point.
+ * \param[in,out] hint  Bin search cache for \p x, initialized by akimaBinHintInit_double().
+ *
+ * \return  Bin (interval) number of x which contains xq. Bins are 0-based.
+ */
+MFL_INTERP_UINT akimaFindGridIntervalHint1D_double
+(
+    const double* x,
+    const MFL_INTERP_UINT        n,
+    const double  xq,
+    akimaBinHint_double*         hint
+)
+{
+    /*
+     * Same bins as akimaFindGridInterval1D_double: the last bin if x[n-2] <= xq, else the first
+     * bin b with xq <= x[b+1]. The latter is found by galloping away from the start bin in steps
+     * of 1, 2, 4, ... and then bisecting the last step, so a query point k bins away from the
+     * hint costs O(log k) comparisons.
+     */
+
+    MFL_INTERP_UINT b, lo, hi, mid, step;
+    double g;
+
+    if (n < 3) {
+        hint->bin = 0;
+        return 0;
+    }
+    if (x[n-2] <= xq) {
+        hint->bin = n-2;
+        return n-2;
+    }
+
+    /* Start bin in [0, n-3] */
+    if (hint->invDx > 0) {
+        g = (xq - hint->x0) * hint->invDx;
+        b = (g > 0) ? ((g < (double)(n-3)) ? (MFL_INTERP_UINT)g : n-3) : 0; /* NaN goes to 0 */
+    }
+    else {
+        b = (hint->bin < n-3) ? hint->bin : n-3;
+    }
+
+    if (x[b+1] < xq) {
+        /* Gallop up: the bin is in [b+1, n-3] */
+        lo = b+1;
+        step = 1;
+        for (;;) {
+            hi = lo + step;
+            if (hi >= n-3) {
+                hi = n-3;
+                break;
+            }
+            if ( !(x[hi+1] < xq) ) {
+                break;
+            }
+            lo = hi+1;
+            step *= 2;
+        }
+    }
+    else if (b == 0 || x[b] < xq) {
+        /* Hit */
+        hint->bin = b;
+        return b;
+    }
+    else {
+        /* Gallop down: the bin is in [0, b-1] */
+        hi = b-1;
+        step = 1;
+        for (;;) {
+            if (hi < step) {
+                lo = 0;
+                break;
+            }
+            lo = hi - step;
+            if (x[lo+1] < xq) {
+                ++lo;
+                break;
+            }
+            hi = lo;
+            step *= 2;
+        }
+    }
+
+    /* Bisect for the first bin in [lo, hi] with xq <= x[b+1]; hi is known to be one */
+    while (lo < hi) {
+        mid = lo + (hi-lo)/2;
+        if (x[mid+1] < xq) {
+            lo = mid+1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    hint->bin = lo;
+    return lo;
+}
+
 /**
  * Check that 1-D grid coordinates are strictly increasing and finite.
  *
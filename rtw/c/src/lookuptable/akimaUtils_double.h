@@ -10,6 +10,20 @@
  * Interpolation utilities: <tt>abs</tt>, bin search.
  */
 
+/**
+ * Bin search cache for one vector of 1-D grid coordinates.
+ *
+ * Query points that move slowly between calls usually land in the bin found last time, or
+ * next to it, so the search starts there. On grids with evenly spaced coordinates it starts at
+ * the bin computed from the spacing instead. Either way the start is only a hint: the bin
+ * returned is always the one akimaFindGridInterval1D_double() returns.
+ */
+typedef struct akimaBinHint_double_tag {
+    MFL_INTERP_UINT bin;    /* bin found by the last search */
+    double          x0;     /* first grid coordinate */
+    double          invDx;  /* 1/spacing for evenly spaced coordinates, else 0 */
+} akimaBinHint_double;
+
 /**
  * Abs of a floating-point scalar: |a|
  *
@@ -35,6 +49,40 @@ MFL_INTERP_UINT akimaFindGridInterval1D_double
     const double   xq
 );
 
+/**
+ * Initialize the bin search cache for a vector of 1-D grid coordinates.
+ *
+ * \param[in]  x     Vector of 1-D grid coordinates.
+ * \param[in]  n     <tt>numel(x)</tt>.
+ *
+ * \param[out] hint  Bin search cache for \p x.
+ */
+void akimaBinHintInit_double
+(
+    const double*  x,
+    const MFL_INTERP_UINT         n,
+    akimaBinHint_double*          hint
+);
+
+/**
+ * Find the bins (grid intervals) containing a given 1-D query point, starting the search from a
+ * cached bin.
+ *
+ * \param[in]     x     Vector of 1-D grid coordinates.
+ * \param[in]     n     <tt>numel(x)</tt>.
+ * \param[in]     xq    Query point.
+ * \param[in,out] hint  Bin search cache for \p x, initialized by akimaBinHintInit_double().
+ *
+ * \return  Bin (interval) number of x which contains xq.
+ */
+MFL_INTERP_UINT akimaFindGridIntervalHint1D_double
+(
+    const double*  x,
+    const MFL_INTERP_UINT         n,
+    const double   xq,
+    akimaBinHint_double*          hint
+);
+
 /**
  * Check that 1-D grid coordinates are strictly increasing and finite.
  *
@@ -129,6 +129,42 @@ void akimaFixedGrid_interpolateWS
     *numelWorkspaceIndices = N+(N+1)*pow2toN;
 }
 
+/**
+ * Compute the memory, in bytes, that one table keeps between calls to
+ * akimaFixedGrid_interpolate_double(), akimaFixedGrid_interpolateSingle_double() or
+ * akimaFixedGrid_interpolate_float(): its Akima coefficients and the evaluation workspaces.
+ * The temporary workspaces of the precompute step (see akimaFixedGrid_precomputeWS()) are not
+ * included.
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize           Size of the underlying N-D grid. In MATLAB notation:
+ *                                <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                                where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  sizeofFloat        Size of the table's floating-point type.
+ * \param[in]  sizeofCoefficient  Size of a stored coefficient: <tt>sizeof(float)</tt> for
+ *                                akimaFixedGrid_precomputeSingle_double(), else \p sizeofFloat.
+ *
+ * \return  Memory in bytes.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_memoryWS
+(
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT* gridSize,
+    const MFL_INTERP_UINT  sizeofFloat,
+    const MFL_INTERP_UINT  sizeofCoefficient
+)
+{
+    MFL_INTERP_UINT numelCoefficients, numelWorkspaceEvaluation, numelWorkspaceIndices;
+
+    numelCoefficients = akimaProd(gridSize,N) * (((MFL_INTERP_UINT)1) << N);
+    akimaFixedGrid_interpolateWS(N, &numelWorkspaceEvaluation, &numelWorkspaceIndices);
+
+    return numelCoefficients*sizeofCoefficient +
+           numelWorkspaceEvaluation*sizeofFloat +
+           numelWorkspaceIndices*(MFL_INTERP_UINT)sizeof(MFL_INTERP_UINT);
+}
+
 /**
  * Compute workspace size for akimaFixedQuery_precompute_double() and
  * akimaFixedQuery_precompute_float().
@@ -0,0 +1,69 @@
+/*
+ * File: rt_backsubbatchrr_sgl.c
+ *
+ * Abstract:
+ *      Simulink Coder support routine which performs
+ *      backward substitution on a batch of independent systems:
+ *      solving Ux=b for each of them, for real single precision
+ *      float operands.
+ *
+ */
+
+#include "rt_matrixlib.h"
+
+/* Function: rt_BackwardSubstitutionBatchRR_Sgl ================================
+ * Abstract: Backward substitution on M systems of the same size N: solving
+ *           Ux=b for each of them.
+ *           U: real, single
+ *           b: real, single
+ *           U is an upper (or unit upper) triangular full matrix.
+ *           The entries in the lower triangle are ignored.
+ *
+ *           The systems are interleaved as in
+ *           rt_ForwardSubstitutionBatchRR_Sgl.  Unlike
+ *           rt_BackwardSubstitutionRR_Sgl, pU, pb and x point to the first
+ *           entries.
+ *
+ *           Each system gives the same result as
+ *           rt_BackwardSubstitutionRR_Sgl with P = 1.  x and pb must not
+ *           overlap.
+ */
+void rt_BackwardSubstitutionBatchRR_Sgl(const real32_T *pU,
+                                        const real32_T *pb,
+                                        real32_T       *x,
+                                        int_T           N,
+                                        int_T           M,
+                                        boolean_T       unit_upper)
+{
+  int_T i, j, m;
+
+  for(i=N-1; i>=0; i--) {
+    real32_T *xi = x + i*M;
+    const real32_T *bi = pb + i*M;
+
+    /* xi = sum of U(i,j)*xj over j > i, from the last column */
+    for(m=0; m<M; m++) {
+      xi[m] = 0.0F;
+    }
+    for(j=N-1; j>i; j--) {
+      const real32_T *Uij = pU + (i+j*N)*M;
+      const real32_T *xj  = x + j*M;
+      for(m=0; m<M; m++) {
+        xi[m] += Uij[m] * xj[m];
+      }
+    }
+
+    /* xi = (b(i) - xi) / U(i,i) */
+    for(m=0; m<M; m++) {
+      xi[m] = bi[m] - xi[m];
+    }
+    if (!unit_upper) {
+      const real32_T *Uii = pU + (i+i*N)*M;
+      for(m=0; m<M; m++) {
+        xi[m] /= Uii[m];
+      }
+    }
+  }
+}
+
+/* [EOF] rt_backsubbatchrr_sgl.c */
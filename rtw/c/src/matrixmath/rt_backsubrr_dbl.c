@@ -20,6 +20,9 @@
  *           U is a NxN matrix
  *           X is a NxP matrix
  *           B is a NxP matrix
+ *
+ *           The right-hand sides are taken by groups of four, so that a row
+ *           of U is read once for the four of them.
  */
 void rt_BackwardSubstitutionRR_Dbl(real_T          *pU,
                                    const real_T    *pb,
@@ -29,7 +32,40 @@ void rt_BackwardSubstitutionRR_Dbl(real_T          *pU,
                                    boolean_T        unit_upper)
 {
   int_T i,k;
-  for(k=P; k>0; k--) {
+  for(k=P; k>=4; k-=4) {
+    real_T *x3 = x + k*N-1;             /* last entry of each column */
+    real_T *x2 = x3 - N;
+    real_T *x1 = x2 - N;
+    real_T *x0 = x1 - N;
+    for(i=0; i<N; i++) {
+      real_T s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+      real_T *pUrow = pU - i;           /* access current row of U */
+      int_T j;
+
+      for(j=0; j<i; j++) {
+        const real_T Uij = *pUrow;
+        s0 += Uij * x0[-j];
+        s1 += Uij * x1[-j];
+        s2 += Uij * x2[-j];
+        s3 += Uij * x3[-j];
+        pUrow -= N;
+      }
+
+      if (unit_upper) {
+        x3[-i] = pb[-i]     - s3;
+        x2[-i] = pb[-i-N]   - s2;
+        x1[-i] = pb[-i-2*N] - s1;
+        x0[-i] = pb[-i-3*N] - s0;
+      } else {
+        x3[-i] = (pb[-i]     - s3) / *pUrow;
+        x2[-i] = (pb[-i-N]   - s2) / *pUrow;
+        x1[-i] = (pb[-i-2*N] - s1) / *pUrow;
+        x0[-i] = (pb[-i-3*N] - s0) / *pUrow;
+      }
+    }
+    pb -= 4*N;
+  }
+  for(; k>0; k--) {
     real_T *pUcol = pU;
     for(i=0; i<N; i++) {
       real_T *xj = x + k*N-1;
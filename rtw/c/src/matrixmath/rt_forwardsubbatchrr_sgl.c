@@ -0,0 +1,77 @@
+/*
+ * File: rt_forwardsubbatchrr_sgl.c
+ *
+ * Abstract:
+ *      Simulink Coder support routine which performs
+ *      forward substitution on a batch of independent systems:
+ *      solving Lx=b for each of them
+ *
+ */
+
+#include <stddef.h>   /* needed for NULL */
+#include "rt_matrixlib.h"
+
+/* Function: rt_ForwardSubstitutionBatchRR_Sgl =================================
+ * Abstract: Forward substitution on M systems of the same size N: solving
+ *           Lx=b for each of them.
+ *           L: Real, single
+ *           b: Real, single
+ *           L is a lower (or unit lower) triangular full matrix.
+ *           The entries in the upper triangle are ignored.
+ *
+ *           The systems are interleaved: entry (i,j) of L of system m is
+ *           pL[(i+j*N)*M + m], and entry i of b and x of system m is
+ *           pb[i*M + m] and x[i*M + m], so that the inner loops run over the
+ *           batch with unit stride.  piv is interleaved in the same way as b,
+ *           or is NULL when there is no row permutation.
+ *
+ *           Each system gives the same result as rt_ForwardSubstitutionRR_Sgl
+ *           with P = 1.  x and pb must not overlap.
+ */
+void rt_ForwardSubstitutionBatchRR_Sgl(const real32_T *pL,
+                                       const real32_T *pb,
+                                       real32_T       *x,
+                                       int_T           N,
+                                       int_T           M,
+                                       const int32_T  *piv,
+                                       boolean_T       unit_lower)
+{
+  int_T i, j, m;
+
+  for(i=0; i<N; i++) {
+    real32_T *xi = x + i*M;
+
+    /* xi = sum of L(i,j)*xj over j < i */
+    for(m=0; m<M; m++) {
+      xi[m] = 0.0F;
+    }
+    for(j=0; j<i; j++) {
+      const real32_T *Lij = pL + (i+j*N)*M;
+      const real32_T *xj  = x + j*M;
+      for(m=0; m<M; m++) {
+        xi[m] += Lij[m] * xj[m];
+      }
+    }
+
+    /* xi = (b(piv(i)) - xi) / L(i,i) */
+    if (piv != NULL) {
+      const int32_T *pivi = piv + i*M;
+      for(m=0; m<M; m++) {
+        xi[m] = pb[pivi[m]*M + m] - xi[m];
+      }
+    } else {
+      const real32_T *bi = pb + i*M;
+      for(m=0; m<M; m++) {
+        xi[m] = bi[m] - xi[m];
+      }
+    }
+    if (!unit_lower) {
+      const real32_T *Lii = pL + (i+i*N)*M;
+      for(m=0; m<M; m++) {
+        xi[m] /= Lii[m];
+      }
+    }
+  }
+}
+
+/* [EOF] rt_forwardsubbatchrr_sgl.c */
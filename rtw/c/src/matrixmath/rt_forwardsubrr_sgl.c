@@ -19,6 +19,9 @@
  *           L is a NxN matrix
  *           X is a NxP matrix
  *           B is a NxP matrix
+ *
+ *           The right-hand sides are taken by groups of four, so that a row
+ *           of L is read once for the four of them.
  */
 void rt_ForwardSubstitutionRR_Sgl(real32_T       *pL,
                                   const real32_T *pb,
@@ -30,7 +33,41 @@ void rt_ForwardSubstitutionRR_Sgl(real32_T       *pL,
 {
   /* Real inputs: */
   int_T i, k;
-  for(k=0; k<P; k++) {
+  for(k=0; k+4<=P; k+=4) {
+    real32_T *x0 = x + k*N;
+    real32_T *x1 = x0 + N;
+    real32_T *x2 = x1 + N;
+    real32_T *x3 = x2 + N;
+    for(i=0; i<N; i++) {
+      const int_T p = piv[i];
+      real32_T s0 = 0.0F, s1 = 0.0F, s2 = 0.0F, s3 = 0.0F;
+      real32_T *pLrow = pL + i;           /* access current row of L */
+      int_T j;
+
+      for(j=0; j<i; j++) {
+        const real32_T Lij = *pLrow;
+        s0 += Lij * x0[j];
+        s1 += Lij * x1[j];
+        s2 += Lij * x2[j];
+        s3 += Lij * x3[j];
+        pLrow += N;
+      }
+
+      if (unit_lower) {
+        x0[i] = pb[p]     - s0;
+        x1[i] = pb[p+N]   - s1;
+        x2[i] = pb[p+2*N] - s2;
+        x3[i] = pb[p+3*N] - s3;
+      } else {
+        x0[i] = (pb[p]     - s0) / *pLrow;
+        x1[i] = (pb[p+N]   - s1) / *pLrow;
+        x2[i] = (pb[p+2*N] - s2) / *pLrow;
+        x3[i] = (pb[p+3*N] - s3) / *pLrow;
+      }
+    }
+    pb += 4*N;
+  }
+  for(; k<P; k++) {
     real32_T *pLcol = pL;
     for(i=0; i<N; i++) {
       real32_T *xj = x + k*N;
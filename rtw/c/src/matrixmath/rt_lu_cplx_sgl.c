@@ -1,6 +1,6 @@
 /* Copyright 1994-2010 The MathWorks, Inc.
  *
- * File: rt_lu_cplx.c     
+ * File: rt_lu_cplx_sgl.c     
  *
  * Abstract:
  *      Simulink Coder support routine for lu_cplx
@@ -13,93 +13,147 @@
 /* Function: rt_lu_cplx ========================================================
  * Abstract: A is complex.
  *
+ *           Blocked, right-looking, as rt_lu_real.
  */
 #ifdef CREAL_T
 void rt_lu_cplx_sgl(creal32_T *A,     /* in and out                         */
                     const int_T n,  /* number or rows = number of columns */
                     int32_T *piv)   /* pivote vector                      */
 {
-  int_T k;
+  int_T ipiv[RT_LU_BLOCK_SIZE]; /* row swapped with each panel row */
+  int_T j0, k;
 
   /* initialize row-pivot indices: */
   for (k = 0; k < n; k++) {
     piv[k] = k;
   }
 
-  /* Loop over each column: */
-  for (k = 0; k < n; k++) {
-    const int_T kn = k*n;
-    int_T p = k;
-
-    /*
-     * Scan the lower triangular part of this column only
-     * Record row of largest value
-     */
-    {
-      int_T i;
-      real32_T Amax = CQABSSGL(A[p+kn]);     /* approx mag-squared value */
-
-      for (i = k+1; i < n; i++) {
+  /* Loop over each panel of columns j0 to j1-1: */
+  for (j0 = 0; j0 < n; j0 += RT_LU_BLOCK_SIZE) {
+    const int_T j1 = (n - j0 > RT_LU_BLOCK_SIZE) ? j0 + RT_LU_BLOCK_SIZE : n;
+    boolean_T swapped = false;
+
+    /* Loop over each column of the panel: */
+    for (k = j0; k < j1; k++) {
+      const int_T kn = k*n;
+      int_T p = k;
+
+      /*
+       * Scan the lower triangular part of this column only
+       * Record row of largest value
+       */
+      {
+        int_T i;
+        real32_T Amax = CQABSSGL(A[p+kn]);     /* approx mag-squared value */
+
+        for (i = k+1; i < n; i++) {
           real32_T q = rt_Hypot_Sgl(A[i+kn].re, A[i+kn].im);
-        q *= q;
-        if (q > Amax) {p = i; Amax = q;}
+          q *= q;
+          if (q > Amax) {p = i; Amax = q;}
+        }
       }
-    }
 
-    /* swap rows if required */
-    if (p != k) {
-      int_T j;
-      for (j = 0; j < n; j++) {
-        creal32_T c;
-        const int_T pjn = p+j*n;
-        const int_T kjn = k+j*n;
+      /* swap rows within the panel if required */
+      ipiv[k-j0] = p;
+      if (p != k) {
+        int_T j;
+        for (j = j0; j < j1; j++) {
+          creal32_T c;
+          const int_T pjn = p+j*n;
+          const int_T kjn = k+j*n;
+
+          c = A[pjn];
+          A[pjn] = A[kjn];
+          A[kjn] = c;
+        }
 
-        c = A[pjn];
-        A[pjn] = A[kjn];
-        A[kjn] = c;
+        /* Swap pivot row indices */
+        {
+          int32_T t = piv[p]; piv[p] = piv[k]; piv[k] = t;
+        }
+        swapped = true;
       }
 
-      /* Swap pivot row indices */
+      /* column reduction within the panel */
       {
-        int32_T t = piv[p]; piv[p] = piv[k]; piv[k] = t;
-      }
-    }
+        creal32_T Adiag;
+        int_T i, j;
 
-    /* column reduction */
-    {
-      creal32_T Adiag;
-      int_T i, j;
+        Adiag = A[k+kn];
 
-      Adiag = A[k+kn];
+        if (!((Adiag.re == 0.0F) && (Adiag.im == 0.0F))) {
+          /* non-zero diagonal entry */
+          /*
+           * divide lower triangular part of column by max
+           * First, form reciprocal of Adiag:
+           *	    recip = conj(Adiag)/(|Adiag|^2)
+           */
+          rt_ComplexReciprocal_Sgl(&Adiag, Adiag);
 
-      if (!((Adiag.re == 0.0F) && (Adiag.im == 0.0F))) {
-        /* non-zero diagonal entry */
-        /*
-         * divide lower triangular part of column by max
-         * First, form reciprocal of Adiag:
-         *	    recip = conj(Adiag)/(|Adiag|^2)
-         */
-        rt_ComplexReciprocal_Sgl(&Adiag, Adiag);
+          /* Multiply: A[i+kn] *= Adiag: */
+          for (i = k+1; i < n; i++) {
+            rt_ComplexTimes_Sgl(&A[i+kn], A[i+kn], Adiag);
+          }
 
-        /* Multiply: A[i+kn] *= Adiag: */
-        for (i = k+1; i < n; i++) {
-          rt_ComplexTimes_Sgl(&A[i+kn], A[i+kn], Adiag);
+          /* subtract multiple of column from remaining panel columns */
+          for (j = k+1; j < j1; j++) {
+            int_T j_n = j*n;
+            for (i = k+1; i < n; i++) {
+              /* Multiply: c = A[i+kn] * A[k+j_n]: */
+              creal32_T c;
+              rt_ComplexTimes_Sgl(&c, A[i+kn], A[k+j_n]);
+
+              /* Subtract A[i+j_n] -= A[i+kn]*A[k+j_n]: */
+              A[i+j_n].re -= c.re;
+              A[i+j_n].im -= c.im;
+            }
+          }
         }
+      }
+    }
 
-        /* subtract multiple of column from remaining columns */
-        for (j = k+1; j < n; j++) {
-          int_T j_n = j*n;
-          for (i = k+1; i < n; i++) {
-            /* Multiply: c = A[i+kn] * A[k+j_n]: */
-            creal32_T c;
-            rt_ComplexTimes_Sgl(&c, A[i+kn], A[k+j_n]);
+    /* apply the row swaps of the panel to the columns outside of it */
+    if (swapped) {
+      int_T j;
+      for (j = 0; j < n; j++) {
+        const int_T j_n = j*n;
+        if (j >= j0 && j < j1) continue;
+        for (k = j0; k < j1; k++) {
+          const int_T p = ipiv[k-j0];
+          if (p != k) {
+            creal32_T c = A[p+j_n]; A[p+j_n] = A[k+j_n]; A[k+j_n] = c;
+          }
+        }
+      }
+    }
+
+    if (j1 < n) {
+      int_T dims[3];
+      int_T i, j;
 
-            /* Subtract A[i+j_n] -= A[i+kn]*A[k+j_n]: */
-            A[i+j_n].re -= c.re;
-            A[i+j_n].im -= c.im;
+      /* rows of U to the right of the panel: A12 = L11\A12 */
+      for (j = j1; j < n; j++) {
+        const int_T j_n = j*n;
+        for (k = j0; k < j1; k++) {
+          const int_T kn = k*n;
+          if (!((A[k+kn].re == 0.0F) && (A[k+kn].im == 0.0F))) {
+            /* column was reduced */
+            for (i = k+1; i < j1; i++) {
+              creal32_T c;
+              rt_ComplexTimes_Sgl(&c, A[i+kn], A[k+j_n]);
+              A[i+j_n].re -= c.re;
+              A[i+j_n].im -= c.im;
+            }
           }
         }
       }
+
+      /* trailing submatrix: A22 -= L21*A12 */
+      dims[0] = n - j1;
+      dims[1] = j1 - j0;
+      dims[2] = n - j1;
+      rt_MatMultSubBlkCC_Sgl(&A[j1+j1*n], n, &A[j1+j0*n], n,
+                             &A[j0+j1*n], n, dims);
     }
   }
 }
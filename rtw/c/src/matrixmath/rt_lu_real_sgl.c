@@ -13,68 +13,125 @@
 /* Function: rt_lu_real  =======================================================
  * Abstract: A is real.
  *
+ *           Blocked, right-looking: the columns are factored by panels of
+ *           RT_LU_BLOCK_SIZE.  The row swaps of a panel are applied to the
+ *           columns outside of it once the panel is factored, and the
+ *           trailing submatrix is updated with a single matrix product.
+ *           A and piv are returned as by the unblocked factorization, which
+ *           this reduces to when n <= RT_LU_BLOCK_SIZE.
  */
 void rt_lu_real_sgl(real32_T      *A,    /* in and out                         */
                 const int_T n,     /* number or rows = number of columns */
                 int32_T     *piv)  /* pivote vector                      */
 {
-  int_T k;
+  int_T ipiv[RT_LU_BLOCK_SIZE];    /* row swapped with each panel row */
+  int_T j0, k;
 
   /* initialize row-pivot indices: */
   for (k = 0; k < n; k++) {
     piv[k] = k;
   }
 
-  /* Loop over each column: */
-  for (k = 0; k < n; k++) {
-    const int_T kn = k*n;
-    int_T p = k;
+  /* Loop over each panel of columns j0 to j1-1: */
+  for (j0 = 0; j0 < n; j0 += RT_LU_BLOCK_SIZE) {
+    const int_T j1 = (n - j0 > RT_LU_BLOCK_SIZE) ? j0 + RT_LU_BLOCK_SIZE : n;
+    boolean_T swapped = false;
+
+    /* Loop over each column of the panel: */
+    for (k = j0; k < j1; k++) {
+      const int_T kn = k*n;
+      int_T p = k;
+
+      /* Scan the lower triangular part of this column only
+       * Record row of largest value
+       */
+      {
+        int_T i;
+        real32_T Amax = (real32_T) fabs( (real_T)A[p+kn] );      /* assume diag is max */
+        for (i = k+1; i < n; i++) {
+          real32_T q =  (real32_T) fabs( (real_T)A[i+kn] );
+          if (q > Amax) {p = i; Amax = q;}
+        }
+      }
 
-    /* Scan the lower triangular part of this column only
-     * Record row of largest value
-     */
-    {
-      int_T i;
-      real32_T Amax = (real32_T) fabs( (real_T)A[p+kn] );      /* assume diag is max */
-      for (i = k+1; i < n; i++) {
-        real32_T q =  (real32_T) fabs( (real_T)A[i+kn] );
-        if (q > Amax) {p = i; Amax = q;}
+      /* swap rows within the panel if required */
+      ipiv[k-j0] = p;
+      if (p != k) {
+        int_T j;
+        int32_T t1;
+        for (j = j0; j < j1; j++) {
+          real32_T t;
+          const int_T j_n = j*n;
+          t = A[p+j_n]; A[p+j_n] = A[k+j_n]; A[k+j_n] = t;
+        }
+        /* swap pivot row indices */
+        t1 = piv[p]; piv[p] = piv[k]; piv[k] = t1;
+        swapped = true;
+      }
+
+      /* column reduction within the panel */
+      {
+        real32_T Adiag = A[k+kn];
+        int_T i,j;
+        if (Adiag != 0.0F) {               /* non-zero diagonal entry */
+
+          /* divide lower triangular part of column by max */
+          Adiag = 1.0F/Adiag;
+          for (i = k+1; i < n; i++) {
+            A[i+kn] *= Adiag;
+          }
+
+          /* subtract multiple of column from remaining panel columns */
+          for (j = k+1; j < j1; j++) {
+            const int_T j_n = j*n;
+            const real32_T Akj = A[k+j_n];
+            for (i = k+1; i < n; i++) {
+              A[i+j_n] -= A[i+kn]*Akj;
+            }
+          }
+        }
       }
     }
 
-    /* swap rows if required */
-    if (p != k) {
+    /* apply the row swaps of the panel to the columns outside of it */
+    if (swapped) {
       int_T j;
-      int32_T t1;
       for (j = 0; j < n; j++) {
-        real32_T t;
         const int_T j_n = j*n;
-        t = A[p+j_n]; A[p+j_n] = A[k+j_n]; A[k+j_n] = t;
+        if (j >= j0 && j < j1) continue;
+        for (k = j0; k < j1; k++) {
+          const int_T p = ipiv[k-j0];
+          if (p != k) {
+            real32_T t = A[p+j_n]; A[p+j_n] = A[k+j_n]; A[k+j_n] = t;
+          }
+        }
       }
-      /* swap pivot row indices */
-      t1 = piv[p]; piv[p] = piv[k]; piv[k] = t1;
     }
 
-    /* column reduction */
-    {
-      real32_T Adiag = A[k+kn];
-      int_T i,j;
-      if (Adiag != 0.0F) {               /* non-zero diagonal entry */
+    if (j1 < n) {
+      int_T dims[3];
+      int_T i, j;
 
-        /* divide lower triangular part of column by max */
-        Adiag = 1.0F/Adiag;
-        for (i = k+1; i < n; i++) {
-          A[i+kn] *= Adiag;
-        }
-
-        /* subtract multiple of column from remaining columns */
-        for (j = k+1; j < n; j++) {
-          int_T j_n = j*n;
-          for (i = k+1; i < n; i++) {
-            A[i+j_n] -= A[i+kn]*A[k+j_n];
+      /* rows of U to the right of the panel: A12 = L11\A12 */
+      for (j = j1; j < n; j++) {
+        const int_T j_n = j*n;
+        for (k = j0; k < j1; k++) {
+          const int_T kn = k*n;
+          if (A[k+kn] != 0.0F) {          /* column was reduced */
+            const real32_T Akj = A[k+j_n];
+            for (i = k+1; i < j1; i++) {
+              A[i+j_n] -= A[i+kn]*Akj;
+            }
           }
         }
       }
+
+      /* trailing submatrix: A22 -= L21*A12 */
+      dims[0] = n - j1;
+      dims[1] = j1 - j0;
+      dims[2] = n - j1;
+      rt_MatMultSubBlkRR_Sgl(&A[j1+j1*n], n, &A[j1+j0*n], n,
+                             &A[j0+j1*n], n, dims);
     }
   }
 }
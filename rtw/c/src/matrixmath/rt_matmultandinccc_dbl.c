@@ -9,6 +9,7 @@
  *
  */
 
+#include <stddef.h>   /* needed for NULL */
 #include "rt_matrixlib.h"
 
 /*
@@ -24,32 +25,7 @@ void rt_MatMultAndIncCC_Dbl(creal_T       *y,
                             const creal_T *B,
                             const int_T     dims[3])
 {
-  int_T k;
-  for(k=dims[2]; k-- > 0; ) {
-    const creal_T *A1 = A;
-    int_T i;
-    for(i=dims[0]; i-- > 0; ) {
-      const creal_T *A2 = A1;
-      const creal_T *B1 = B;
-      creal_T acc;
-      int_T j;
-      A1++;
-      acc.re = (real_T)0.0;
-      acc.im = (real_T)0.0;
-      for(j=dims[1]; j-- > 0; ) {
-        creal_T c;
-        rt_ComplexTimes_Dbl(&c, *A2, *B1);
-        acc.re += c.re;
-        acc.im += c.im;
-        B1++;
-        A2 += dims[0];
-      }
-      y->re += acc.re;
-      y->im += acc.im;
-      y++;
-    }
-    B += dims[1];
-  }
+  rt_MatMultBlkCplx_Dbl(y, NULL, A, NULL, B, dims, true);
 }
 #endif
 /* [EOF] rt_matmultandinccc_dbl.c */
@@ -22,25 +22,7 @@ void rt_MatMultAndIncRR_Sgl(real32_T       *y,
                             const real32_T *B,
                             const int_T      dims[3])
 {
-  int_T k;
-  for(k=dims[2]; k-- > 0; ) {
-    const real32_T *A1 = A;
-    int_T i;
-    for(i=dims[0]; i-- > 0; ) {
-      const real32_T *A2 = A1;
-      const real32_T *B1 = B;
-      real32_T acc = 0.0F;
-      int_T j;
-      A1++;
-      for(j=dims[1]; j-- > 0; ) {
-        acc += *A2 * *B1;
-        B1++;
-        A2 += dims[0];
-      }
-      *y++ += acc;
-    }
-    B += dims[1];
-  }
+  rt_MatMultBlkRR_Sgl(y, A, B, dims, true);
 }
 
 /* [EOF] rt_matmultandincrr_sgl.c */
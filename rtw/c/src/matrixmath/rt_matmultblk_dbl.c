@@ -0,0 +1,493 @@
+/*
+ * File: rt_matmultblk_dbl.c
+ *
+ * Abstract:
+ *      Simulink Coder support routines for blocked matrix multiplication
+ *      of double precision float operands, used by rt_MatMult*_Dbl and
+ *      rt_MatMultAndInc*_Dbl
+ *
+ *      y is computed by tiles of RT_MATMULT_MR x RT_MATMULT_NR entries
+ *      held in registers, each tile being a sweep over the columns of a
+ *      panel of RT_MATMULT_MR contiguous rows of A.  The tiles of a panel
+ *      of RT_MATMULT_MC rows of A are computed before moving to the next
+ *      panel, so that the panel stays in cache.
+ *
+ *      Every entry of y is still accumulated from zero in order of
+ *      increasing inner index, as in the unblocked loops, so the results
+ *      are the same, except on the SIMD paths with fused multiply-add
+ *      (AVX2 with FMA, NEON) which round once per multiply-add.  Define
+ *      RT_MATMULT_REPRODUCIBLE to keep the separate multiply and add there
+ *      as well.
+ *
+ *      The SIMD path is chosen at compile time from the target macros of
+ *      the compiler (AVX2, SSE2, or NEON on AArch64).  Define
+ *      RT_MATMULT_NO_SIMD to use the portable C tile only.
+ *
+ */
+
+#include <stddef.h>   /* needed for NULL */
+#include "rt_matrixlib.h"
+
+#if !defined(RT_MATMULT_NO_SIMD) && defined(__AVX2__)
+# include <immintrin.h>
+# define RT_MATMULT_AVX2
+# define RT_MATMULT_MR 8
+#elif !defined(RT_MATMULT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+# include <emmintrin.h>
+# define RT_MATMULT_SSE2
+# define RT_MATMULT_MR 4
+#elif !defined(RT_MATMULT_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define RT_MATMULT_NEON
+# define RT_MATMULT_MR 4
+#else
+# define RT_MATMULT_MR 4
+#endif
+
+#define RT_MATMULT_NR 4
+#define RT_MATMULT_MC 64
+
+/* Tiles of complex operands */
+#define RT_MATMULT_CMR 4
+#define RT_MATMULT_CNR 2
+
+/* What a tile does with y */
+#define RT_MATMULT_SET 0      /* y  = A*B */
+#define RT_MATMULT_ADD 1      /* y += A*B */
+#define RT_MATMULT_SUB 2      /* y -= A*B */
+
+/* Function: rt_MatMultTileRR_Dbl ==============================================
+ * Abstract:
+ *      mr x nr tile of y = A*B, y += A*B or y -= A*B (see mode), portable C.
+ *      ldy, lda and ldb are the leading dimensions of y, A and B, and K
+ *      the number of columns of A.
+ */
+static void rt_MatMultTileRR_Dbl(real_T       *y,
+                                 int_T         ldy,
+                                 const real_T *A,
+                                 int_T         lda,
+                                 const real_T *B,
+                                 int_T         ldb,
+                                 int_T         K,
+                                 int_T         mr,
+                                 int_T         nr,
+                                 int_T         mode)
+{
+  real_T acc[RT_MATMULT_MR*RT_MATMULT_NR];
+  int_T i, j, k;
+
+  for (i = 0; i < mr*nr; i++) {
+    acc[i] = 0.0;
+  }
+  for (j = 0; j < K; j++) {
+    const real_T *Aj = A + j*lda;
+    for (k = 0; k < nr; k++) {
+      const real_T bjk = B[j + k*ldb];
+      real_T *acck = acc + k*mr;
+      for (i = 0; i < mr; i++) {
+        acck[i] += Aj[i] * bjk;
+      }
+    }
+  }
+  for (k = 0; k < nr; k++) {
+    real_T *yk = y + k*ldy;
+    const real_T *acck = acc + k*mr;
+    if (mode == RT_MATMULT_ADD) {
+      for (i = 0; i < mr; i++) yk[i] += acck[i];
+    } else if (mode == RT_MATMULT_SUB) {
+      for (i = 0; i < mr; i++) yk[i] -= acck[i];
+    } else {
+      for (i = 0; i < mr; i++) yk[i] = acck[i];
+    }
+  }
+}
+
+#if defined(RT_MATMULT_AVX2)
+
+# if defined(__FMA__) && !defined(RT_MATMULT_REPRODUCIBLE)
+#  define RT_MATMULT_MADD(a,b,c) _mm256_fmadd_pd(a,b,c)
+# else
+#  define RT_MATMULT_MADD(a,b,c) _mm256_add_pd(c,_mm256_mul_pd(a,b))
+# endif
+
+/* Full 8 x 4 tile, AVX2 */
+static void rt_MatMultTileRRFull_Dbl(real_T       *y,
+                                     int_T         ldy,
+                                     const real_T *A,
+                                     int_T         lda,
+                                     const real_T *B,
+                                     int_T         ldb,
+                                     int_T         K,
+                                     int_T         mode)
+{
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  const real_T *B0 = B, *B1 = B+ldb, *B2 = B+2*ldb, *B3 = B+3*ldb;
+  int_T j;
+
+  for (j = 0; j < K; j++) {
+    const __m256d a0 = _mm256_loadu_pd(A + j*lda);
+    const __m256d a1 = _mm256_loadu_pd(A + j*lda + 4);
+    __m256d b;
+    b = _mm256_broadcast_sd(B0 + j);
+    c00 = RT_MATMULT_MADD(a0,b,c00); c01 = RT_MATMULT_MADD(a1,b,c01);
+    b = _mm256_broadcast_sd(B1 + j);
+    c10 = RT_MATMULT_MADD(a0,b,c10); c11 = RT_MATMULT_MADD(a1,b,c11);
+    b = _mm256_broadcast_sd(B2 + j);
+    c20 = RT_MATMULT_MADD(a0,b,c20); c21 = RT_MATMULT_MADD(a1,b,c21);
+    b = _mm256_broadcast_sd(B3 + j);
+    c30 = RT_MATMULT_MADD(a0,b,c30); c31 = RT_MATMULT_MADD(a1,b,c31);
+  }
+  if (mode == RT_MATMULT_ADD) {
+    c00 = _mm256_add_pd(_mm256_loadu_pd(y),         c00);
+    c01 = _mm256_add_pd(_mm256_loadu_pd(y+4),       c01);
+    c10 = _mm256_add_pd(_mm256_loadu_pd(y+ldy),     c10);
+    c11 = _mm256_add_pd(_mm256_loadu_pd(y+ldy+4),   c11);
+    c20 = _mm256_add_pd(_mm256_loadu_pd(y+2*ldy),   c20);
+    c21 = _mm256_add_pd(_mm256_loadu_pd(y+2*ldy+4), c21);
+    c30 = _mm256_add_pd(_mm256_loadu_pd(y+3*ldy),   c30);
+    c31 = _mm256_add_pd(_mm256_loadu_pd(y+3*ldy+4), c31);
+  } else if (mode == RT_MATMULT_SUB) {
+    c00 = _mm256_sub_pd(_mm256_loadu_pd(y),         c00);
+    c01 = _mm256_sub_pd(_mm256_loadu_pd(y+4),       c01);
+    c10 = _mm256_sub_pd(_mm256_loadu_pd(y+ldy),     c10);
+    c11 = _mm256_sub_pd(_mm256_loadu_pd(y+ldy+4),   c11);
+    c20 = _mm256_sub_pd(_mm256_loadu_pd(y+2*ldy),   c20);
+    c21 = _mm256_sub_pd(_mm256_loadu_pd(y+2*ldy+4), c21);
+    c30 = _mm256_sub_pd(_mm256_loadu_pd(y+3*ldy),   c30);
+    c31 = _mm256_sub_pd(_mm256_loadu_pd(y+3*ldy+4), c31);
+  }
+  _mm256_storeu_pd(y,       c00); _mm256_storeu_pd(y+4,       c01);
+  _mm256_storeu_pd(y+ldy,   c10); _mm256_storeu_pd(y+ldy+4,   c11);
+  _mm256_storeu_pd(y+2*ldy, c20); _mm256_storeu_pd(y+2*ldy+4, c21);
+  _mm256_storeu_pd(y+3*ldy, c30); _mm256_storeu_pd(y+3*ldy+4, c31);
+}
+
+#elif defined(RT_MATMULT_SSE2)
+
+/* Full 4 x 4 tile, SSE2 */
+static void rt_MatMultTileRRFull_Dbl(real_T       *y,
+                                     int_T         ldy,
+                                     const real_T *A,
+                                     int_T         lda,
+                                     const real_T *B,
+                                     int_T         ldb,
+                                     int_T         K,
+                                     int_T         mode)
+{
+  __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+  __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+  __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+  __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+  const real_T *B0 = B, *B1 = B+ldb, *B2 = B+2*ldb, *B3 = B+3*ldb;
+  int_T j;
+
+  for (j = 0; j < K; j++) {
+    const __m128d a0 = _mm_loadu_pd(A + j*lda);
+    const __m128d a1 = _mm_loadu_pd(A + j*lda + 2);
+    __m128d b;
+    b = _mm_set1_pd(B0[j]);
+    c00 = _mm_add_pd(c00,_mm_mul_pd(a0,b)); c01 = _mm_add_pd(c01,_mm_mul_pd(a1,b));
+    b = _mm_set1_pd(B1[j]);
+    c10 = _mm_add_pd(c10,_mm_mul_pd(a0,b)); c11 = _mm_add_pd(c11,_mm_mul_pd(a1,b));
+    b = _mm_set1_pd(B2[j]);
+    c20 = _mm_add_pd(c20,_mm_mul_pd(a0,b)); c21 = _mm_add_pd(c21,_mm_mul_pd(a1,b));
+    b = _mm_set1_pd(B3[j]);
+    c30 = _mm_add_pd(c30,_mm_mul_pd(a0,b)); c31 = _mm_add_pd(c31,_mm_mul_pd(a1,b));
+  }
+  if (mode == RT_MATMULT_ADD) {
+    c00 = _mm_add_pd(_mm_loadu_pd(y),         c00);
+    c01 = _mm_add_pd(_mm_loadu_pd(y+2),       c01);
+    c10 = _mm_add_pd(_mm_loadu_pd(y+ldy),     c10);
+    c11 = _mm_add_pd(_mm_loadu_pd(y+ldy+2),   c11);
+    c20 = _mm_add_pd(_mm_loadu_pd(y+2*ldy),   c20);
+    c21 = _mm_add_pd(_mm_loadu_pd(y+2*ldy+2), c21);
+    c30 = _mm_add_pd(_mm_loadu_pd(y+3*ldy),   c30);
+    c31 = _mm_add_pd(_mm_loadu_pd(y+3*ldy+2), c31);
+  } else if (mode == RT_MATMULT_SUB) {
+    c00 = _mm_sub_pd(_mm_loadu_pd(y),         c00);
+    c01 = _mm_sub_pd(_mm_loadu_pd(y+2),       c01);
+    c10 = _mm_sub_pd(_mm_loadu_pd(y+ldy),     c10);
+    c11 = _mm_sub_pd(_mm_loadu_pd(y+ldy+2),   c11);
+    c20 = _mm_sub_pd(_mm_loadu_pd(y+2*ldy),   c20);
+    c21 = _mm_sub_pd(_mm_loadu_pd(y+2*ldy+2), c21);
+    c30 = _mm_sub_pd(_mm_loadu_pd(y+3*ldy),   c30);
+    c31 = _mm_sub_pd(_mm_loadu_pd(y+3*ldy+2), c31);
+  }
+  _mm_storeu_pd(y,       c00); _mm_storeu_pd(y+2,       c01);
+  _mm_storeu_pd(y+ldy,   c10); _mm_storeu_pd(y+ldy+2,   c11);
+  _mm_storeu_pd(y+2*ldy, c20); _mm_storeu_pd(y+2*ldy+2, c21);
+  _mm_storeu_pd(y+3*ldy, c30); _mm_storeu_pd(y+3*ldy+2, c31);
+}
+
+#elif defined(RT_MATMULT_NEON)
+
+# ifdef RT_MATMULT_REPRODUCIBLE
+#  define RT_MATMULT_MADD(c,a,b) vaddq_f64(c,vmulq_f64(a,b))
+# else
+#  define RT_MATMULT_MADD(c,a,b) vfmaq_f64(c,a,b)
+# endif
+
+/* Full 4 x 4 tile, NEON */
+static void rt_MatMultTileRRFull_Dbl(real_T       *y,
+                                     int_T         ldy,
+                                     const real_T *A,
+                                     int_T         lda,
+                                     const real_T *B,
+                                     int_T         ldb,
+                                     int_T         K,
+                                     int_T         mode)
+{
+  float64x2_t c00 = vdupq_n_f64(0.0), c01 = vdupq_n_f64(0.0);
+  float64x2_t c10 = vdupq_n_f64(0.0), c11 = vdupq_n_f64(0.0);
+  float64x2_t c20 = vdupq_n_f64(0.0), c21 = vdupq_n_f64(0.0);
+  float64x2_t c30 = vdupq_n_f64(0.0), c31 = vdupq_n_f64(0.0);
+  const real_T *B0 = B, *B1 = B+ldb, *B2 = B+2*ldb, *B3 = B+3*ldb;
+  int_T j;
+
+  for (j = 0; j < K; j++) {
+    const float64x2_t a0 = vld1q_f64(A + j*lda);
+    const float64x2_t a1 = vld1q_f64(A + j*lda + 2);
+    float64x2_t b;
+    b = vdupq_n_f64(B0[j]);
+    c00 = RT_MATMULT_MADD(c00,a0,b); c01 = RT_MATMULT_MADD(c01,a1,b);
+    b = vdupq_n_f64(B1[j]);
+    c10 = RT_MATMULT_MADD(c10,a0,b); c11 = RT_MATMULT_MADD(c11,a1,b);
+    b = vdupq_n_f64(B2[j]);
+    c20 = RT_MATMULT_MADD(c20,a0,b); c21 = RT_MATMULT_MADD(c21,a1,b);
+    b = vdupq_n_f64(B3[j]);
+    c30 = RT_MATMULT_MADD(c30,a0,b); c31 = RT_MATMULT_MADD(c31,a1,b);
+  }
+  if (mode == RT_MATMULT_ADD) {
+    c00 = vaddq_f64(vld1q_f64(y),         c00);
+    c01 = vaddq_f64(vld1q_f64(y+2),       c01);
+    c10 = vaddq_f64(vld1q_f64(y+ldy),     c10);
+    c11 = vaddq_f64(vld1q_f64(y+ldy+2),   c11);
+    c20 = vaddq_f64(vld1q_f64(y+2*ldy),   c20);
+    c21 = vaddq_f64(vld1q_f64(y+2*ldy+2), c21);
+    c30 = vaddq_f64(vld1q_f64(y+3*ldy),   c30);
+    c31 = vaddq_f64(vld1q_f64(y+3*ldy+2), c31);
+  } else if (mode == RT_MATMULT_SUB) {
+    c00 = vsubq_f64(vld1q_f64(y),         c00);
+    c01 = vsubq_f64(vld1q_f64(y+2),       c01);
+    c10 = vsubq_f64(vld1q_f64(y+ldy),     c10);
+    c11 = vsubq_f64(vld1q_f64(y+ldy+2),   c11);
+    c20 = vsubq_f64(vld1q_f64(y+2*ldy),   c20);
+    c21 = vsubq_f64(vld1q_f64(y+2*ldy+2), c21);
+    c30 = vsubq_f64(vld1q_f64(y+3*ldy),   c30);
+    c31 = vsubq_f64(vld1q_f64(y+3*ldy+2), c31);
+  }
+  vst1q_f64(y,       c00); vst1q_f64(y+2,       c01);
+  vst1q_f64(y+ldy,   c10); vst1q_f64(y+ldy+2,   c11);
+  vst1q_f64(y+2*ldy, c20); vst1q_f64(y+2*ldy+2, c21);
+  vst1q_f64(y+3*ldy, c30); vst1q_f64(y+3*ldy+2, c31);
+}
+
+#else
+
+/* Full tile, portable C */
+static void rt_MatMultTileRRFull_Dbl(real_T       *y,
+                                     int_T         ldy,
+                                     const real_T *A,
+                                     int_T         lda,
+                                     const real_T *B,
+                                     int_T         ldb,
+                                     int_T         K,
+                                     int_T         mode)
+{
+  rt_MatMultTileRR_Dbl(y, ldy, A, lda, B, ldb, K,
+                       RT_MATMULT_MR, RT_MATMULT_NR, mode);
+}
+
+#endif
+
+/* Function: rt_MatMultBlkLdRR_Dbl =============================================
+ * Abstract:
+ *      y = A*B, y += A*B or y -= A*B (see mode), y being M x N, A M x K and
+ *      B K x N, with leading dimensions ldy, lda and ldb.
+ */
+static void rt_MatMultBlkLdRR_Dbl(real_T       *y,
+                                  int_T         ldy,
+                                  const real_T *A,
+                                  int_T         lda,
+                                  const real_T *B,
+                                  int_T         ldb,
+                                  int_T         M,
+                                  int_T         K,
+                                  int_T         N,
+                                  int_T         mode)
+{
+  int_T i0, i, k;
+
+  for (i0 = 0; i0 < M; i0 += RT_MATMULT_MC) {
+    const int_T i1 = (M - i0 > RT_MATMULT_MC) ? i0 + RT_MATMULT_MC : M;
+    for (k = 0; k < N; k += RT_MATMULT_NR) {
+      const int_T nr = (N - k > RT_MATMULT_NR) ? RT_MATMULT_NR : N - k;
+      for (i = i0; i < i1; i += RT_MATMULT_MR) {
+        const int_T mr = (i1 - i > RT_MATMULT_MR) ? RT_MATMULT_MR : i1 - i;
+        if (mr == RT_MATMULT_MR && nr == RT_MATMULT_NR) {
+          rt_MatMultTileRRFull_Dbl(y + i + k*ldy, ldy, A + i, lda,
+                                   B + k*ldb, ldb, K, mode);
+        } else {
+          rt_MatMultTileRR_Dbl(y + i + k*ldy, ldy, A + i, lda,
+                               B + k*ldb, ldb, K, mr, nr, mode);
+        }
+      }
+    }
+  }
+}
+
+/* Function: rt_MatMultBlkRR_Dbl ===============================================
+ * Abstract:
+ *      y = A*B, or y += A*B when inc
+ *      Input 1: Real, double-precision, dims[0] x dims[1]
+ *      Input 2: Real, double-precision, dims[1] x dims[2]
+ */
+void rt_MatMultBlkRR_Dbl(real_T       *y,
+                         const real_T *A,
+                         const real_T *B,
+                         const int_T   dims[3],
+                         boolean_T     inc)
+{
+  rt_MatMultBlkLdRR_Dbl(y, dims[0], A, dims[0], B, dims[1],
+                        dims[0], dims[1], dims[2],
+                        inc ? RT_MATMULT_ADD : RT_MATMULT_SET);
+}
+
+/* Function: rt_MatMultSubBlkRR_Dbl ============================================
+ * Abstract:
+ *      y -= A*B on submatrices of larger matrices, for the trailing update
+ *      of a blocked factorization.  y is dims[0] x dims[2], A dims[0] x
+ *      dims[1] and B dims[1] x dims[2], with leading dimensions ldy, lda
+ *      and ldb.
+ */
+void rt_MatMultSubBlkRR_Dbl(real_T       *y,
+                            int_T         ldy,
+                            const real_T *A,
+                            int_T         lda,
+                            const real_T *B,
+                            int_T         ldb,
+                            const int_T   dims[3])
+{
+  rt_MatMultBlkLdRR_Dbl(y, ldy, A, lda, B, ldb, dims[0], dims[1], dims[2],
+                        RT_MATMULT_SUB);
+}
+
+#ifdef CREAL_T
+/* Function: rt_MatMultBlkLdCplx_Dbl ===========================================
+ * Abstract:
+ *      y = A*B, y += A*B or y -= A*B (see mode) with at least one complex
+ *      operand, y being M x N, A M x K and B K x N, with leading dimensions
+ *      ldy, lda and ldb.  A is given by Ar when real and by Ac when complex
+ *      (the other one is NULL), and likewise for B.  The products are
+ *      formed with rt_ComplexTimes_Dbl, real operands having a zero
+ *      imaginary part.
+ */
+static void rt_MatMultBlkLdCplx_Dbl(creal_T       *y,
+                                    int_T          ldy,
+                                    const real_T  *Ar,
+                                    const creal_T *Ac,
+                                    int_T          lda,
+                                    const real_T  *Br,
+                                    const creal_T *Bc,
+                                    int_T          ldb,
+                                    int_T          M,
+                                    int_T          K,
+                                    int_T          N,
+                                    int_T          mode)
+{
+  int_T i0, k0;
+
+  for (i0 = 0; i0 < M; i0 += RT_MATMULT_CMR) {
+    const int_T mr = (M - i0 > RT_MATMULT_CMR) ? RT_MATMULT_CMR : M - i0;
+    for (k0 = 0; k0 < N; k0 += RT_MATMULT_CNR) {
+      const int_T nr = (N - k0 > RT_MATMULT_CNR) ? RT_MATMULT_CNR : N - k0;
+      creal_T acc[RT_MATMULT_CMR*RT_MATMULT_CNR];
+      int_T i, j, k;
+
+      for (i = 0; i < mr*nr; i++) {
+        acc[i].re = 0.0;
+        acc[i].im = 0.0;
+      }
+      for (j = 0; j < K; j++) {
+        for (k = 0; k < nr; k++) {
+          creal_T b;
+          if (Bc != NULL) {
+            b = Bc[j + (k0+k)*ldb];
+          } else {
+            b.re = Br[j + (k0+k)*ldb];
+            b.im = 0.0;
+          }
+          for (i = 0; i < mr; i++) {
+            creal_T a;
+            creal_T c;
+            if (Ac != NULL) {
+              a = Ac[i0 + i + j*lda];
+            } else {
+              a.re = Ar[i0 + i + j*lda];
+              a.im = 0.0;
+            }
+            rt_ComplexTimes_Dbl(&c, a, b);
+            acc[i + k*mr].re += c.re;
+            acc[i + k*mr].im += c.im;
+          }
+        }
+      }
+      for (k = 0; k < nr; k++) {
+        creal_T *yk = y + i0 + (k0+k)*ldy;
+        for (i = 0; i < mr; i++) {
+          if (mode == RT_MATMULT_ADD) {
+            yk[i].re += acc[i + k*mr].re;
+            yk[i].im += acc[i + k*mr].im;
+          } else if (mode == RT_MATMULT_SUB) {
+            yk[i].re -= acc[i + k*mr].re;
+            yk[i].im -= acc[i + k*mr].im;
+          } else {
+            yk[i] = acc[i + k*mr];
+          }
+        }
+      }
+    }
+  }
+}
+
+/* Function: rt_MatMultBlkCplx_Dbl =============================================
+ * Abstract:
+ *      y = A*B, or y += A*B when inc, with at least one complex operand.
+ *      A is given by Ar when real and by Ac when complex (the other one is
+ *      NULL), and likewise for B.
+ */
+void rt_MatMultBlkCplx_Dbl(creal_T       *y,
+                           const real_T  *Ar,
+                           const creal_T *Ac,
+                           const real_T  *Br,
+                           const creal_T *Bc,
+                           const int_T    dims[3],
+                           boolean_T      inc)
+{
+  rt_MatMultBlkLdCplx_Dbl(y, dims[0], Ar, Ac, dims[0], Br, Bc, dims[1],
+                          dims[0], dims[1], dims[2],
+                          inc ? RT_MATMULT_ADD : RT_MATMULT_SET);
+}
+
+/* Function: rt_MatMultSubBlkCC_Dbl ============================================
+ * Abstract:
+ *      y -= A*B on complex submatrices of larger matrices, see
+ *      rt_MatMultSubBlkRR_Dbl.
+ */
+void rt_MatMultSubBlkCC_Dbl(creal_T       *y,
+                            int_T          ldy,
+                            const creal_T *A,
+                            int_T          lda,
+                            const creal_T *B,
+                            int_T          ldb,
+                            const int_T    dims[3])
+{
+  rt_MatMultBlkLdCplx_Dbl(y, ldy, NULL, A, lda, NULL, B, ldb,
+                          dims[0], dims[1], dims[2], RT_MATMULT_SUB);
+}
+#endif
+
+/* [EOF] rt_matmultblk_dbl.c */
@@ -0,0 +1,493 @@
+/*
+ * File: rt_matmultblk_sgl.c
+ *
+ * Abstract:
+ *      Simulink Coder support routines for blocked matrix multiplication
+ *      of single precision float operands, used by rt_MatMult*_Sgl and
+ *      rt_MatMultAndInc*_Sgl
+ *
+ *      y is computed by tiles of RT_MATMULT_MR x RT_MATMULT_NR entries
+ *      held in registers, each tile being a sweep over the columns of a
+ *      panel of RT_MATMULT_MR contiguous rows of A.  The tiles of a panel
+ *      of RT_MATMULT_MC rows of A are computed before moving to the next
+ *      panel, so that the panel stays in cache.
+ *
+ *      Every entry of y is still accumulated from zero in order of
+ *      increasing inner index, as in the unblocked loops, so the results
+ *      are the same, except on the SIMD paths with fused multiply-add
+ *      (AVX2 with FMA, NEON) which round once per multiply-add.  Define
+ *      RT_MATMULT_REPRODUCIBLE to keep the separate multiply and add there
+ *      as well.
+ *
+ *      The SIMD path is chosen at compile time from the target macros of
+ *      the compiler (AVX2, SSE or NEON).  Define
+ *      RT_MATMULT_NO_SIMD to use the portable C tile only.
+ *
+ */
+
+#include <stddef.h>   /* needed for NULL */
+#include "rt_matrixlib.h"
+
+#if !defined(RT_MATMULT_NO_SIMD) && defined(__AVX2__)
+# include <immintrin.h>
+# define RT_MATMULT_AVX2
+# define RT_MATMULT_MR 16
+#elif !defined(RT_MATMULT_NO_SIMD) && (defined(__SSE__) || defined(_M_X64))
+# include <xmmintrin.h>
+# define RT_MATMULT_SSE
+# define RT_MATMULT_MR 8
+#elif !defined(RT_MATMULT_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+# include <arm_neon.h>
+# define RT_MATMULT_NEON
+# define RT_MATMULT_MR 8
+#else
+# define RT_MATMULT_MR 8
+#endif
+
+#define RT_MATMULT_NR 4
+#define RT_MATMULT_MC 64
+
+/* Tiles of complex operands */
+#define RT_MATMULT_CMR 4
+#define RT_MATMULT_CNR 2
+
+/* What a tile does with y */
+#define RT_MATMULT_SET 0      /* y  = A*B */
+#define RT_MATMULT_ADD 1      /* y += A*B */
+#define RT_MATMULT_SUB 2      /* y -= A*B */
+
+/* Function: rt_MatMultTileRR_Sgl ==============================================
+ * Abstract:
+ *      mr x nr tile of y = A*B, y += A*B or y -= A*B (see mode), portable C.
+ *      ldy, lda and ldb are the leading dimensions of y, A and B, and K
+ *      the number of columns of A.
+ */
+static void rt_MatMultTileRR_Sgl(real32_T       *y,
+                                 int_T           ldy,
+                                 const real32_T *A,
+                                 int_T           lda,
+                                 const real32_T *B,
+                                 int_T           ldb,
+                                 int_T           K,
+                                 int_T           mr,
+                                 int_T           nr,
+                                 int_T           mode)
+{
+  real32_T acc[RT_MATMULT_MR*RT_MATMULT_NR];
+  int_T i, j, k;
+
+  for (i = 0; i < mr*nr; i++) {
+    acc[i] = 0.0F;
+  }
+  for (j = 0; j < K; j++) {
+    const real32_T *Aj = A + j*lda;
+    for (k = 0; k < nr; k++) {
+      const real32_T bjk = B[j + k*ldb];
+      real32_T *acck = acc + k*mr;
+      for (i = 0; i < mr; i++) {
+        acck[i] += Aj[i] * bjk;
+      }
+    }
+  }
+  for (k = 0; k < nr; k++) {
+    real32_T *yk = y + k*ldy;
+    const real32_T *acck = acc + k*mr;
+    if (mode == RT_MATMULT_ADD) {
+      for (i = 0; i < mr; i++) yk[i] += acck[i];
+    } else if (mode == RT_MATMULT_SUB) {
+      for (i = 0; i < mr; i++) yk[i] -= acck[i];
+    } else {
+      for (i = 0; i < mr; i++) yk[i] = acck[i];
+    }
+  }
+}
+
+#if defined(RT_MATMULT_AVX2)
+
+# if defined(__FMA__) && !defined(RT_MATMULT_REPRODUCIBLE)
+#  define RT_MATMULT_MADD(a,b,c) _mm256_fmadd_ps(a,b,c)
+# else
+#  define RT_MATMULT_MADD(a,b,c) _mm256_add_ps(c,_mm256_mul_ps(a,b))
+# endif
+
+/* Full 16 x 4 tile, AVX2 */
+static void rt_MatMultTileRRFull_Sgl(real32_T       *y,
+                                     int_T           ldy,
+                                     const real32_T *A,
+                                     int_T           lda,
+                                     const real32_T *B,
+                                     int_T           ldb,
+                                     int_T           K,
+                                     int_T           mode)
+{
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  const real32_T *B0 = B, *B1 = B+ldb, *B2 = B+2*ldb, *B3 = B+3*ldb;
+  int_T j;
+
+  for (j = 0; j < K; j++) {
+    const __m256 a0 = _mm256_loadu_ps(A + j*lda);
+    const __m256 a1 = _mm256_loadu_ps(A + j*lda + 8);
+    __m256 b;
+    b = _mm256_broadcast_ss(B0 + j);
+    c00 = RT_MATMULT_MADD(a0,b,c00); c01 = RT_MATMULT_MADD(a1,b,c01);
+    b = _mm256_broadcast_ss(B1 + j);
+    c10 = RT_MATMULT_MADD(a0,b,c10); c11 = RT_MATMULT_MADD(a1,b,c11);
+    b = _mm256_broadcast_ss(B2 + j);
+    c20 = RT_MATMULT_MADD(a0,b,c20); c21 = RT_MATMULT_MADD(a1,b,c21);
+    b = _mm256_broadcast_ss(B3 + j);
+    c30 = RT_MATMULT_MADD(a0,b,c30); c31 = RT_MATMULT_MADD(a1,b,c31);
+  }
+  if (mode == RT_MATMULT_ADD) {
+    c00 = _mm256_add_ps(_mm256_loadu_ps(y),         c00);
+    c01 = _mm256_add_ps(_mm256_loadu_ps(y+8),       c01);
+    c10 = _mm256_add_ps(_mm256_loadu_ps(y+ldy),     c10);
+    c11 = _mm256_add_ps(_mm256_loadu_ps(y+ldy+8),   c11);
+    c20 = _mm256_add_ps(_mm256_loadu_ps(y+2*ldy),   c20);
+    c21 = _mm256_add_ps(_mm256_loadu_ps(y+2*ldy+8), c21);
+    c30 = _mm256_add_ps(_mm256_loadu_ps(y+3*ldy),   c30);
+    c31 = _mm256_add_ps(_mm256_loadu_ps(y+3*ldy+8), c31);
+  } else if (mode == RT_MATMULT_SUB) {
+    c00 = _mm256_sub_ps(_mm256_loadu_ps(y),         c00);
+    c01 = _mm256_sub_ps(_mm256_loadu_ps(y+8),       c01);
+    c10 = _mm256_sub_ps(_mm256_loadu_ps(y+ldy),     c10);
+    c11 = _mm256_sub_ps(_mm256_loadu_ps(y+ldy+8),   c11);
+    c20 = _mm256_sub_ps(_mm256_loadu_ps(y+2*ldy),   c20);
+    c21 = _mm256_sub_ps(_mm256_loadu_ps(y+2*ldy+8), c21);
+    c30 = _mm256_sub_ps(_mm256_loadu_ps(y+3*ldy),   c30);
+    c31 = _mm256_sub_ps(_mm256_loadu_ps(y+3*ldy+8), c31);
+  }
+  _mm256_storeu_ps(y,       c00); _mm256_storeu_ps(y+8,       c01);
+  _mm256_storeu_ps(y+ldy,   c10); _mm256_storeu_ps(y+ldy+8,   c11);
+  _mm256_storeu_ps(y+2*ldy, c20); _mm256_storeu_ps(y+2*ldy+8, c21);
+  _mm256_storeu_ps(y+3*ldy, c30); _mm256_storeu_ps(y+3*ldy+8, c31);
+}
+
+#elif defined(RT_MATMULT_SSE)
+
+/* Full 8 x 4 tile, SSE */
+static void rt_MatMultTileRRFull_Sgl(real32_T       *y,
+                                     int_T           ldy,
+                                     const real32_T *A,
+                                     int_T           lda,
+                                     const real32_T *B,
+                                     int_T           ldb,
+                                     int_T           K,
+                                     int_T           mode)
+{
+  __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+  __m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+  __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+  __m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+  const real32_T *B0 = B, *B1 = B+ldb, *B2 = B+2*ldb, *B3 = B+3*ldb;
+  int_T j;
+
+  for (j = 0; j < K; j++) {
+    const __m128 a0 = _mm_loadu_ps(A + j*lda);
+    const __m128 a1 = _mm_loadu_ps(A + j*lda + 4);
+    __m128 b;
+    b = _mm_set1_ps(B0[j]);
+    c00 = _mm_add_ps(c00,_mm_mul_ps(a0,b)); c01 = _mm_add_ps(c01,_mm_mul_ps(a1,b));
+    b = _mm_set1_ps(B1[j]);
+    c10 = _mm_add_ps(c10,_mm_mul_ps(a0,b)); c11 = _mm_add_ps(c11,_mm_mul_ps(a1,b));
+    b = _mm_set1_ps(B2[j]);
+    c20 = _mm_add_ps(c20,_mm_mul_ps(a0,b)); c21 = _mm_add_ps(c21,_mm_mul_ps(a1,b));
+    b = _mm_set1_ps(B3[j]);
+    c30 = _mm_add_ps(c30,_mm_mul_ps(a0,b)); c31 = _mm_add_ps(c31,_mm_mul_ps(a1,b));
+  }
+  if (mode == RT_MATMULT_ADD) {
+    c00 = _mm_add_ps(_mm_loadu_ps(y),         c00);
+    c01 = _mm_add_ps(_mm_loadu_ps(y+4),       c01);
+    c10 = _mm_add_ps(_mm_loadu_ps(y+ldy),     c10);
+    c11 = _mm_add_ps(_mm_loadu_ps(y+ldy+4),   c11);
+    c20 = _mm_add_ps(_mm_loadu_ps(y+2*ldy),   c20);
+    c21 = _mm_add_ps(_mm_loadu_ps(y+2*ldy+4), c21);
+    c30 = _mm_add_ps(_mm_loadu_ps(y+3*ldy),   c30);
+    c31 = _mm_add_ps(_mm_loadu_ps(y+3*ldy+4), c31);
+  } else if (mode == RT_MATMULT_SUB) {
+    c00 = _mm_sub_ps(_mm_loadu_ps(y),         c00);
+    c01 = _mm_sub_ps(_mm_loadu_ps(y+4),       c01);
+    c10 = _mm_sub_ps(_mm_loadu_ps(y+ldy),     c10);
+    c11 = _mm_sub_ps(_mm_loadu_ps(y+ldy+4),   c11);
+    c20 = _mm_sub_ps(_mm_loadu_ps(y+2*ldy),   c20);
+    c21 = _mm_sub_ps(_mm_loadu_ps(y+2*ldy+4), c21);
+    c30 = _mm_sub_ps(_mm_loadu_ps(y+3*ldy),   c30);
+    c31 = _mm_sub_ps(_mm_loadu_ps(y+3*ldy+4), c31);
+  }
+  _mm_storeu_ps(y,       c00); _mm_storeu_ps(y+4,       c01);
+  _mm_storeu_ps(y+ldy,   c10); _mm_storeu_ps(y+ldy+4,   c11);
+  _mm_storeu_ps(y+2*ldy, c20); _mm_storeu_ps(y+2*ldy+4, c21);
+  _mm_storeu_ps(y+3*ldy, c30); _mm_storeu_ps(y+3*ldy+4, c31);
+}
+
+#elif defined(RT_MATMULT_NEON)
+
+# if defined(__ARM_FEATURE_FMA) && !defined(RT_MATMULT_REPRODUCIBLE)
+#  define RT_MATMULT_MADD(c,a,b) vfmaq_f32(c,a,b)
+# else
+#  define RT_MATMULT_MADD(c,a,b) vaddq_f32(c,vmulq_f32(a,b))
+# endif
+
+/* Full 8 x 4 tile, NEON */
+static void rt_MatMultTileRRFull_Sgl(real32_T       *y,
+                                     int_T           ldy,
+                                     const real32_T *A,
+                                     int_T           lda,
+                                     const real32_T *B,
+                                     int_T           ldb,
+                                     int_T           K,
+                                     int_T           mode)
+{
+  float32x4_t c00 = vdupq_n_f32(0.0F), c01 = vdupq_n_f32(0.0F);
+  float32x4_t c10 = vdupq_n_f32(0.0F), c11 = vdupq_n_f32(0.0F);
+  float32x4_t c20 = vdupq_n_f32(0.0F), c21 = vdupq_n_f32(0.0F);
+  float32x4_t c30 = vdupq_n_f32(0.0F), c31 = vdupq_n_f32(0.0F);
+  const real32_T *B0 = B, *B1 = B+ldb, *B2 = B+2*ldb, *B3 = B+3*ldb;
+  int_T j;
+
+  for (j = 0; j < K; j++) {
+    const float32x4_t a0 = vld1q_f32(A + j*lda);
+    const float32x4_t a1 = vld1q_f32(A + j*lda + 4);
+    float32x4_t b;
+    b = vdupq_n_f32(B0[j]);
+    c00 = RT_MATMULT_MADD(c00,a0,b); c01 = RT_MATMULT_MADD(c01,a1,b);
+    b = vdupq_n_f32(B1[j]);
+    c10 = RT_MATMULT_MADD(c10,a0,b); c11 = RT_MATMULT_MADD(c11,a1,b);
+    b = vdupq_n_f32(B2[j]);
+    c20 = RT_MATMULT_MADD(c20,a0,b); c21 = RT_MATMULT_MADD(c21,a1,b);
+    b = vdupq_n_f32(B3[j]);
+    c30 = RT_MATMULT_MADD(c30,a0,b); c31 = RT_MATMULT_MADD(c31,a1,b);
+  }
+  if (mode == RT_MATMULT_ADD) {
+    c00 = vaddq_f32(vld1q_f32(y),         c00);
+    c01 = vaddq_f32(vld1q_f32(y+4),       c01);
+    c10 = vaddq_f32(vld1q_f32(y+ldy),     c10);
+    c11 = vaddq_f32(vld1q_f32(y+ldy+4),   c11);
+    c20 = vaddq_f32(vld1q_f32(y+2*ldy),   c20);
+    c21 = vaddq_f32(vld1q_f32(y+2*ldy+4), c21);
+    c30 = vaddq_f32(vld1q_f32(y+3*ldy),   c30);
+    c31 = vaddq_f32(vld1q_f32(y+3*ldy+4), c31);
+  } else if (mode == RT_MATMULT_SUB) {
+    c00 = vsubq_f32(vld1q_f32(y),         c00);
+    c01 = vsubq_f32(vld1q_f32(y+4),       c01);
+    c10 = vsubq_f32(vld1q_f32(y+ldy),     c10);
+    c11 = vsubq_f32(vld1q_f32(y+ldy+4),   c11);
+    c20 = vsubq_f32(vld1q_f32(y+2*ldy),   c20);
+    c21 = vsubq_f32(vld1q_f32(y+2*ldy+4), c21);
+    c30 = vsubq_f32(vld1q_f32(y+3*ldy),   c30);
+    c31 = vsubq_f32(vld1q_f32(y+3*ldy+4), c31);
+  }
+  vst1q_f32(y,       c00); vst1q_f32(y+4,       c01);
+  vst1q_f32(y+ldy,   c10); vst1q_f32(y+ldy+4,   c11);
+  vst1q_f32(y+2*ldy, c20); vst1q_f32(y+2*ldy+4, c21);
+  vst1q_f32(y+3*ldy, c30); vst1q_f32(y+3*ldy+4, c31);
+}
+
+#else
+
+/* Full tile, portable C */
+static void rt_MatMultTileRRFull_Sgl(real32_T       *y,
+                                     int_T           ldy,
+                                     const real32_T *A,
+                                     int_T           lda,
+                                     const real32_T *B,
+                                     int_T           ldb,
+                                     int_T           K,
+                                     int_T           mode)
+{
+  rt_MatMultTileRR_Sgl(y, ldy, A, lda, B, ldb, K,
+                       RT_MATMULT_MR, RT_MATMULT_NR, mode);
+}
+
+#endif
+
+/* Function: rt_MatMultBlkLdRR_Sgl =============================================
+ * Abstract:
+ *      y = A*B, y += A*B or y -= A*B (see mode), y being M x N, A M x K and
+ *      B K x N, with leading dimensions ldy, lda and ldb.
+ */
+static void rt_MatMultBlkLdRR_Sgl(real32_T       *y,
+                                  int_T           ldy,
+                                  const real32_T *A,
+                                  int_T           lda,
+                                  const real32_T *B,
+                                  int_T           ldb,
+                                  int_T           M,
+                                  int_T           K,
+                                  int_T           N,
+                                  int_T           mode)
+{
+  int_T i0, i, k;
+
+  for (i0 = 0; i0 < M; i0 += RT_MATMULT_MC) {
+    const int_T i1 = (M - i0 > RT_MATMULT_MC) ? i0 + RT_MATMULT_MC : M;
+    for (k = 0; k < N; k += RT_MATMULT_NR) {
+      const int_T nr = (N - k > RT_MATMULT_NR) ? RT_MATMULT_NR : N - k;
+      for (i = i0; i < i1; i += RT_MATMULT_MR) {
+        const int_T mr = (i1 - i > RT_MATMULT_MR) ? RT_MATMULT_MR : i1 - i;
+        if (mr == RT_MATMULT_MR && nr == RT_MATMULT_NR) {
+          rt_MatMultTileRRFull_Sgl(y + i + k*ldy, ldy, A + i, lda,
+                                   B + k*ldb, ldb, K, mode);
+        } else {
+          rt_MatMultTileRR_Sgl(y + i + k*ldy, ldy, A + i, lda,
+                               B + k*ldb, ldb, K, mr, nr, mode);
+        }
+      }
+    }
+  }
+}
+
+/* Function: rt_MatMultBlkRR_Sgl ===============================================
+ * Abstract:
+ *      y = A*B, or y += A*B when inc
+ *      Input 1: Real, single-precision, dims[0] x dims[1]
+ *      Input 2: Real, single-precision, dims[1] x dims[2]
+ */
+void rt_MatMultBlkRR_Sgl(real32_T       *y,
+                         const real32_T *A,
+                         const real32_T *B,
+                         const int_T     dims[3],
+                         boolean_T       inc)
+{
+  rt_MatMultBlkLdRR_Sgl(y, dims[0], A, dims[0], B, dims[1],
+                        dims[0], dims[1], dims[2],
+                        inc ? RT_MATMULT_ADD : RT_MATMULT_SET);
+}
+
+/* Function: rt_MatMultSubBlkRR_Sgl ============================================
+ * Abstract:
+ *      y -= A*B on submatrices of larger matrices, for the trailing update
+ *      of a blocked factorization.  y is dims[0] x dims[2], A dims[0] x
+ *      dims[1] and B dims[1] x dims[2], with leading dimensions ldy, lda
+ *      and ldb.
+ */
+void rt_MatMultSubBlkRR_Sgl(real32_T       *y,
+                            int_T           ldy,
+                            const real32_T *A,
+                            int_T           lda,
+                            const real32_T *B,
+                            int_T           ldb,
+                            const int_T     dims[3])
+{
+  rt_MatMultBlkLdRR_Sgl(y, ldy, A, lda, B, ldb, dims[0], dims[1], dims[2],
+                        RT_MATMULT_SUB);
+}
+
+#ifdef CREAL_T
+/* Function: rt_MatMultBlkLdCplx_Sgl ===========================================
+ * Abstract:
+ *      y = A*B, y += A*B or y -= A*B (see mode) with at least one complex
+ *      operand, y being M x N, A M x K and B K x N, with leading dimensions
+ *      ldy, lda and ldb.  A is given by Ar when real and by Ac when complex
+ *      (the other one is NULL), and likewise for B.  The products are
+ *      formed with rt_ComplexTimes_Sgl, real operands having a zero
+ *      imaginary part.
+ */
+static void rt_MatMultBlkLdCplx_Sgl(creal32_T       *y,
+                                    int_T            ldy,
+                                    const real32_T  *Ar,
+                                    const creal32_T *Ac,
+                                    int_T            lda,
+                                    const real32_T  *Br,
+                                    const creal32_T *Bc,
+                                    int_T            ldb,
+                                    int_T            M,
+                                    int_T            K,
+                                    int_T            N,
+                                    int_T            mode)
+{
+  int_T i0, k0;
+
+  for (i0 = 0; i0 < M; i0 += RT_MATMULT_CMR) {
+    const int_T mr = (M - i0 > RT_MATMULT_CMR) ? RT_MATMULT_CMR : M - i0;
+    for (k0 = 0; k0 < N; k0 += RT_MATMULT_CNR) {
+      const int_T nr = (N - k0 > RT_MATMULT_CNR) ? RT_MATMULT_CNR : N - k0;
+      creal32_T acc[RT_MATMULT_CMR*RT_MATMULT_CNR];
+      int_T i, j, k;
+
+      for (i = 0; i < mr*nr; i++) {
+        acc[i].re = 0.0F;
+        acc[i].im = 0.0F;
+      }
+      for (j = 0; j < K; j++) {
+        for (k = 0; k < nr; k++) {
+          creal32_T b;
+          if (Bc != NULL) {
+            b = Bc[j + (k0+k)*ldb];
+          } else {
+            b.re = Br[j + (k0+k)*ldb];
+            b.im = 0.0F;
+          }
+          for (i = 0; i < mr; i++) {
+            creal32_T a;
+            creal32_T c;
+            if (Ac != NULL) {
+              a = Ac[i0 + i + j*lda];
+            } else {
+              a.re = Ar[i0 + i + j*lda];
+              a.im = 0.0F;
+            }
+            rt_ComplexTimes_Sgl(&c, a, b);
+            acc[i + k*mr].re += c.re;
+            acc[i + k*mr].im += c.im;
+          }
+        }
+      }
+      for (k = 0; k < nr; k++) {
+        creal32_T *yk = y + i0 + (k0+k)*ldy;
+        for (i = 0; i < mr; i++) {
+          if (mode == RT_MATMULT_ADD) {
+            yk[i].re += acc[i + k*mr].re;
+            yk[i].im += acc[i + k*mr].im;
+          } else if (mode == RT_MATMULT_SUB) {
+            yk[i].re -= acc[i + k*mr].re;
+            yk[i].im -= acc[i + k*mr].im;
+          } else {
+            yk[i] = acc[i + k*mr];
+          }
+        }
+      }
+    }
+  }
+}
+
+/* Function: rt_MatMultBlkCplx_Sgl =============================================
+ * Abstract:
+ *      y = A*B, or y += A*B when inc, with at least one complex operand.
+ *      A is given by Ar when real and by Ac when complex (the other one is
+ *      NULL), and likewise for B.
+ */
+void rt_MatMultBlkCplx_Sgl(creal32_T       *y,
+                           const real32_T  *Ar,
+                           const creal32_T *Ac,
+                           const real32_T  *Br,
+                           const creal32_T *Bc,
+                           const int_T      dims[3],
+                           boolean_T        inc)
+{
+  rt_MatMultBlkLdCplx_Sgl(y, dims[0], Ar, Ac, dims[0], Br, Bc, dims[1],
+                          dims[0], dims[1], dims[2],
+                          inc ? RT_MATMULT_ADD : RT_MATMULT_SET);
+}
+
+/* Function: rt_MatMultSubBlkCC_Sgl ============================================
+ * Abstract:
+ *      y -= A*B on complex submatrices of larger matrices, see
+ *      rt_MatMultSubBlkRR_Sgl.
+ */
+void rt_MatMultSubBlkCC_Sgl(creal32_T       *y,
+                            int_T            ldy,
+                            const creal32_T *A,
+                            int_T            lda,
+                            const creal32_T *B,
+                            int_T            ldb,
+                            const int_T      dims[3])
+{
+  rt_MatMultBlkLdCplx_Sgl(y, ldy, NULL, A, lda, NULL, B, ldb,
+                          dims[0], dims[1], dims[2], RT_MATMULT_SUB);
+}
+#endif
+
+/* [EOF] rt_matmultblk_sgl.c */
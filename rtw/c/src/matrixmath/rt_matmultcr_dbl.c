@@ -8,6 +8,7 @@
  *
  */
 
+#include <stddef.h>   /* needed for NULL */
 #include "rt_matrixlib.h"
 
 /*
@@ -23,33 +24,7 @@ void rt_MatMultCR_Dbl(creal_T       *y,
                       const real_T  *B,
                       const int_T     dims[3])
 {
-  int_T k;
-  for(k=dims[2]; k-- > 0; ) {
-    const creal_T *A1 = A;
-    int_T i;
-    for(i=dims[0]; i-- > 0; ) {
-      const creal_T *A2 = A1;
-      const real_T *B1 = B;
-      creal_T acc;
-      int_T j;
-      A1++;
-      acc.re = 0.0;
-      acc.im = 0.0;
-      for(j=dims[1]; j-- > 0; ) {
-        creal_T c;
-        creal_T b1c;
-        b1c.re = *B1;
-        b1c.im = 0.0;
-        rt_ComplexTimes_Dbl(&c, *A2, b1c);
-        acc.re += c.re;
-        acc.im += c.im;
-        B1++;
-        A2 += dims[0];
-      }
-      *y++ = acc;
-    }
-    B += dims[1];
-  }
+  rt_MatMultBlkCplx_Dbl(y, NULL, A, B, NULL, dims, false);
 }
 #endif
 /* [EOF] rt_matmultcr_dbl.c */
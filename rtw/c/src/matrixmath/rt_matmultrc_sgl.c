@@ -8,6 +8,7 @@
  *
  */
 
+#include <stddef.h>   /* needed for NULL */
 #include "rt_matrixlib.h"
 
 /*
@@ -23,33 +24,7 @@ void rt_MatMultRC_Sgl(creal32_T       *y,
                       const creal32_T *B,
                       const int_T       dims[3])
 {
-  int_T k;
-  for(k=dims[2]; k-- > 0; ) {
-    const real32_T *A1 = A;
-    int_T i;
-    for(i=dims[0]; i-- > 0; ) {
-      const real32_T *A2 = A1;
-      const creal32_T *B1 = B;
-      creal32_T acc;
-      int_T j;
-      A1++;
-      acc.re = 0.0F;
-      acc.im = 0.0F;
-      for(j=dims[1]; j-- > 0; ) {
-        creal32_T c;
-        creal32_T a1c;
-        a1c.re = *A2;
-        a1c.im = 0.0F;
-        rt_ComplexTimes_Sgl(&c, a1c, *B1);
-        acc.re += c.re;
-        acc.im += c.im;
-        B1++;
-        A2 += dims[0];
-      }
-      *y++ = acc;
-    }
-    B += dims[1];
-  }
+  rt_MatMultBlkCplx_Sgl(y, A, NULL, NULL, B, dims, false);
 }
 #endif
 /* [EOF] rt_matmultrc_sgl.c */
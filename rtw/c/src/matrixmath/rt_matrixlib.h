@@ -107,9 +107,85 @@ extern void rt_MatMultAndIncCC_Sgl(creal32_T       *y,
                                    const creal32_T *A,
                                    const creal32_T *B,
                                    const int_T   dims[3]);
-#endif 
+#endif
+
+/* Blocked kernels behind the two sets of functions above */
+extern void rt_MatMultBlkRR_Dbl(real_T       *y,
+                                const real_T *A,
+                                const real_T *B,
+                                const int_T   dims[3],
+                                boolean_T     inc);
+
+#ifdef CREAL_T
+extern void rt_MatMultBlkCplx_Dbl(creal_T       *y,
+                                  const real_T  *Ar,
+                                  const creal_T *Ac,
+                                  const real_T  *Br,
+                                  const creal_T *Bc,
+                                  const int_T    dims[3],
+                                  boolean_T      inc);
+#endif
+
+/* y -= A*B on submatrices with leading dimensions ldy, lda and ldb */
+extern void rt_MatMultSubBlkRR_Dbl(real_T       *y,
+                                   int_T         ldy,
+                                   const real_T *A,
+                                   int_T         lda,
+                                   const real_T *B,
+                                   int_T         ldb,
+                                   const int_T   dims[3]);
+
+#ifdef CREAL_T
+extern void rt_MatMultSubBlkCC_Dbl(creal_T       *y,
+                                   int_T          ldy,
+                                   const creal_T *A,
+                                   int_T          lda,
+                                   const creal_T *B,
+                                   int_T          ldb,
+                                   const int_T    dims[3]);
+#endif
+
+extern void rt_MatMultBlkRR_Sgl(real32_T       *y,
+                                const real32_T *A,
+                                const real32_T *B,
+                                const int_T     dims[3],
+                                boolean_T       inc);
+
+#ifdef CREAL_T
+extern void rt_MatMultBlkCplx_Sgl(creal32_T       *y,
+                                  const real32_T  *Ar,
+                                  const creal32_T *Ac,
+                                  const real32_T  *Br,
+                                  const creal32_T *Bc,
+                                  const int_T      dims[3],
+                                  boolean_T        inc);
+#endif
+
+extern void rt_MatMultSubBlkRR_Sgl(real32_T       *y,
+                                   int_T           ldy,
+                                   const real32_T *A,
+                                   int_T           lda,
+                                   const real32_T *B,
+                                   int_T           ldb,
+                                   const int_T     dims[3]);
+
+#ifdef CREAL_T
+extern void rt_MatMultSubBlkCC_Sgl(creal32_T       *y,
+                                   int_T            ldy,
+                                   const creal32_T *A,
+                                   int_T            lda,
+                                   const creal32_T *B,
+                                   int_T            ldb,
+                                   const int_T      dims[3]);
+#endif
 
 /* Matrix Inversion Utility Functions */
+
+/* Number of columns of a panel of the blocked LU factorizations */
+#ifndef RT_LU_BLOCK_SIZE
+#define RT_LU_BLOCK_SIZE 32
+#endif
+
 extern void rt_lu_real(real_T      *A,
                        const int_T n,
                        int32_T     *piv);
@@ -130,6 +206,64 @@ extern void rt_lu_cplx_sgl(creal32_T *A,
                            int32_T *piv);
 #endif
 
+/* Sparse LU Utility Functions */
+
+/* Symbolic analysis of a sparse LU factorization, see rt_sparse_lu.c */
+typedef struct rt_SparseLU_tag {
+    int_T n;
+    int_T *perm;    /* n, pivot order                             */
+    int_T *iperm;   /* n, inverse of perm                         */
+    int_T *Lp;      /* n+1, strictly lower part of L, by columns  */
+    int_T *Li;
+    int_T *Up;      /* n+1, strictly upper part of U, by columns  */
+    int_T *Ui;
+} rt_SparseLU;
+
+/* Smallest pivot accepted, relative to the largest entry below it */
+#ifndef RT_SPARSE_LU_PIVOT_TOL
+#define RT_SPARSE_LU_PIVOT_TOL 1.0e-3
+#endif
+
+extern int_T rt_SparseLUSymbolic(rt_SparseLU   *S,
+                                 const int_T   *Ap,
+                                 const int_T   *Ai,
+                                 boolean_T     *bwork,
+                                 int_T         *iwork);
+
+extern boolean_T rt_SparseLUFactor_Dbl(const rt_SparseLU *S,
+                                       const int_T       *Ap,
+                                       const int_T       *Ai,
+                                       const real_T      *Ax,
+                                       real_T            *Lx,
+                                       real_T            *Ux,
+                                       real_T            *Ud,
+                                       real_T            *work);
+
+extern void rt_SparseLUSolve_Dbl(const rt_SparseLU *S,
+                                 const real_T      *Lx,
+                                 const real_T      *Ux,
+                                 const real_T      *Ud,
+                                 const real_T      *b,
+                                 real_T            *x,
+                                 real_T            *work);
+
+extern boolean_T rt_SparseLUFactor_Sgl(const rt_SparseLU *S,
+                                       const int_T       *Ap,
+                                       const int_T       *Ai,
+                                       const real32_T    *Ax,
+                                       real32_T          *Lx,
+                                       real32_T          *Ux,
+                                       real32_T          *Ud,
+                                       real32_T          *work);
+
+extern void rt_SparseLUSolve_Sgl(const rt_SparseLU *S,
+                                 const real32_T    *Lx,
+                                 const real32_T    *Ux,
+                                 const real32_T    *Ud,
+                                 const real32_T    *b,
+                                 real32_T          *x,
+                                 real32_T          *work);
+
 extern void rt_BackwardSubstitutionRR_Dbl(real_T          *pU,
                                           const real_T    *pb,
                                           real_T          *x,
@@ -137,6 +271,22 @@ extern void rt_BackwardSubstitutionRR_Dbl(real_T          *pU,
                                           int_T            P,
                                           boolean_T        unit_upper);
 
+/* Batches of systems, interleaved, see rt_forwardsubbatchrr_dbl.c */
+extern void rt_BackwardSubstitutionBatchRR_Dbl(const real_T *pU,
+                                               const real_T *pb,
+                                               real_T       *x,
+                                               int_T         N,
+                                               int_T         M,
+                                               boolean_T     unit_upper);
+
+extern void rt_ForwardSubstitutionBatchRR_Dbl(const real_T  *pL,
+                                              const real_T  *pb,
+                                              real_T        *x,
+                                              int_T          N,
+                                              int_T          M,
+                                              const int32_T *piv,
+                                              boolean_T      unit_lower);
+
 #ifdef CREAL_T
 extern void rt_BackwardSubstitutionRC_Dbl(real_T          *pU,
                                           const creal_T   *pb,
@@ -194,6 +344,21 @@ extern void rt_BackwardSubstitutionRR_Sgl(real32_T          *pU,
                                           int_T              P,
                                           boolean_T          unit_upper);
 
+extern void rt_BackwardSubstitutionBatchRR_Sgl(const real32_T *pU,
+                                               const real32_T *pb,
+                                               real32_T       *x,
+                                               int_T           N,
+                                               int_T           M,
+                                               boolean_T       unit_upper);
+
+extern void rt_ForwardSubstitutionBatchRR_Sgl(const real32_T *pL,
+                                              const real32_T *pb,
+                                              real32_T       *x,
+                                              int_T           N,
+                                              int_T           M,
+                                              const int32_T  *piv,
+                                              boolean_T       unit_lower);
+
 #ifdef CREAL_T
 extern void rt_BackwardSubstitutionRC_Sgl(real32_T          *pU,
                                           const creal32_T   *pb,
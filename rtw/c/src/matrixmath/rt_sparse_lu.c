@@ -0,0 +1,126 @@
+/*
+ * File: rt_sparse_lu.c
+ *
+ * Abstract:
+ *      Simulink Coder support routine which performs the symbolic
+ *      analysis of a sparse LU factorization (see rt_sparse_lu_real.c)
+ *
+ */
+
+#include "rt_matrixlib.h"
+
+/* Function: rt_SparseLUSymbolic ===============================================
+ * Abstract: Symbolic analysis of a sparse LU factorization of the n x n
+ *           matrix whose pattern is given in compressed column form by
+ *           Ap (n+1 column starts) and Ai (row indices).  The diagonal is
+ *           always part of the pattern.
+ *
+ *           The pivots are taken from the diagonal, in minimum degree order
+ *           of the graph of A+A'.  Ties are broken by the lowest index.  The
+ *           elimination is carried out on an explicit n x n adjacency
+ *           matrix, which gives the exact fill.  This is meant to be done
+ *           once, before the first numeric factorization.
+ *
+ *           On input S->n is set and S->perm, S->iperm (n), S->Lp, S->Up
+ *           (n+1), S->Li and S->Ui (n*(n-1)/2 in the worst case) point to
+ *           storage.  bwork is n*n and iwork is n.
+ *
+ *           Returns the number of entries in the strictly lower part of L,
+ *           which is also the number of entries in the strictly upper part
+ *           of U.
+ */
+int_T rt_SparseLUSymbolic(rt_SparseLU   *S,
+                          const int_T   *Ap,
+                          const int_T   *Ai,
+                          boolean_T     *bwork,
+                          int_T         *iwork)
+{
+  const int_T n   = S->n;
+  int_T      *deg = iwork;
+  int_T      lnz  = 0;
+  int_T      i, j, k, p;
+
+  /* adjacency matrix of A+A', without the diagonal */
+  for (i = 0; i < n*n; i++) {
+    bwork[i] = false;
+  }
+  for (j = 0; j < n; j++) {
+    for (p = Ap[j]; p < Ap[j+1]; p++) {
+      i = Ai[p];
+      if (i != j) {
+        bwork[i+j*n] = true;
+        bwork[j+i*n] = true;
+      }
+    }
+  }
+  for (j = 0; j < n; j++) {
+    deg[j] = 0;
+    S->iperm[j] = -1;
+    for (i = 0; i < n; i++) {
+      if (bwork[i+j*n]) deg[j]++;
+    }
+  }
+
+  /* minimum degree elimination */
+  S->Lp[0] = 0;
+  for (k = 0; k < n; k++) {
+    int_T piv = -1;
+    int_T *nb = S->Li + lnz;
+    int_T nnb = 0;
+    int_T a, b;
+
+    for (j = 0; j < n; j++) {
+      if (S->iperm[j] < 0 && (piv < 0 || deg[j] < deg[piv])) piv = j;
+    }
+    S->perm[k]    = piv;
+    S->iperm[piv] = k;
+
+    /* the remaining neighbors of the pivot form column k of L */
+    for (i = 0; i < n; i++) {
+      if (S->iperm[i] < 0 && bwork[i+piv*n]) nb[nnb++] = i;
+    }
+
+    /* they become a clique once the pivot is eliminated */
+    for (a = 0; a < nnb; a++) {
+      const int_T ia = nb[a];
+      for (b = a+1; b < nnb; b++) {
+        const int_T ib = nb[b];
+        if (!bwork[ia+ib*n]) {
+          bwork[ia+ib*n] = true;
+          bwork[ib+ia*n] = true;
+          deg[ia]++;
+          deg[ib]++;
+        }
+      }
+      deg[ia]--;
+    }
+    lnz += nnb;
+    S->Lp[k+1] = lnz;
+  }
+
+  /* rows of L in pivot order */
+  for (p = 0; p < lnz; p++) {
+    S->Li[p] = S->iperm[S->Li[p]];
+  }
+
+  /* U is the transpose of L, by columns with increasing row indices */
+  for (k = 0; k <= n; k++) {
+    S->Up[k] = 0;
+  }
+  for (p = 0; p < lnz; p++) {
+    S->Up[S->Li[p]+1]++;
+  }
+  for (k = 0; k < n; k++) {
+    S->Up[k+1] += S->Up[k];
+    iwork[k] = S->Up[k];
+  }
+  for (j = 0; j < n; j++) {
+    for (p = S->Lp[j]; p < S->Lp[j+1]; p++) {
+      S->Ui[iwork[S->Li[p]]++] = j;
+    }
+  }
+
+  return lnz;
+}
+
+/* [EOF] rt_sparse_lu.c */
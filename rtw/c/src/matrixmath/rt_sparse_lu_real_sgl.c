@@ -0,0 +1,139 @@
+/*
+ * File: rt_sparse_lu_real_sgl.c
+ *
+ * Abstract:
+ *      Simulink Coder support routines which perform the numeric
+ *      factorization and the solution of a sparse real single precision
+ *      float LU factorization
+ *
+ */
+
+#include <math.h>
+#include "rt_matrixlib.h"
+
+/* Function: rt_SparseLUFactor_Sgl =============================================
+ * Abstract: Numeric factorization A(perm,perm) = L*U, with the pattern and
+ *           pivot order of the symbolic analysis S (see rt_SparseLUSymbolic).
+ *           A is real, single, in compressed column form with the pattern
+ *           that S was computed for.  Can be called repeatedly as the values
+ *           of A change.
+ *
+ *           L is unit lower triangular, its strictly lower part is stored in
+ *           Lx along S->Lp/S->Li.  The strictly upper part of U is stored in
+ *           Ux along S->Up/S->Ui and its diagonal in Ud.  work is n.
+ *
+ *           The pivots are not chosen again: returns false when a pivot is
+ *           smaller than RT_SPARSE_LU_PIVOT_TOL times the largest entry below
+ *           it, in which case the factorization should not be used.
+ */
+boolean_T rt_SparseLUFactor_Sgl(const rt_SparseLU *S,
+                                const int_T       *Ap,
+                                const int_T       *Ai,
+                                const real32_T      *Ax,
+                                real32_T            *Lx,
+                                real32_T            *Ux,
+                                real32_T            *Ud,
+                                real32_T            *work)
+{
+  const int_T n = S->n;
+  int_T i, k, p, q;
+
+  for (i = 0; i < n; i++) {
+    work[i] = 0.0F;
+  }
+
+  /* Left-looking: column k of L and U from column perm[k] of A */
+  for (k = 0; k < n; k++) {
+    const int_T j = S->perm[k];
+    real32_T Adiag;
+    real32_T Amax = 0.0F;
+
+    for (p = Ap[j]; p < Ap[j+1]; p++) {
+      work[S->iperm[Ai[p]]] = Ax[p];
+    }
+
+    /* solve with the columns of L to the left, in increasing order */
+    for (p = S->Up[k]; p < S->Up[k+1]; p++) {
+      const int_T r = S->Ui[p];
+      const real32_T ur = work[r];
+      Ux[p] = ur;
+      work[r] = 0.0F;
+      if (ur != 0.0F) {
+        for (q = S->Lp[r]; q < S->Lp[r+1]; q++) {
+          work[S->Li[q]] -= Lx[q]*ur;
+        }
+      }
+    }
+
+    Adiag = work[k];
+    work[k] = 0.0F;
+    for (p = S->Lp[k]; p < S->Lp[k+1]; p++) {
+      real32_T q1 = (real32_T) fabs( (real_T)work[S->Li[p]] );
+      if (q1 > Amax) Amax = q1;
+    }
+    if (Adiag == 0.0F || (real32_T) fabs( (real_T)Adiag ) <
+        (real32_T)RT_SPARSE_LU_PIVOT_TOL*Amax) {
+      for (p = S->Lp[k]; p < S->Lp[k+1]; p++) {
+        work[S->Li[p]] = 0.0F;
+      }
+      return false;
+    }
+    Ud[k] = Adiag;
+
+    /* divide lower triangular part of column by the pivot */
+    Adiag = 1.0F/Adiag;
+    for (p = S->Lp[k]; p < S->Lp[k+1]; p++) {
+      Lx[p] = work[S->Li[p]]*Adiag;
+      work[S->Li[p]] = 0.0F;
+    }
+  }
+  return true;
+}
+
+/* Function: rt_SparseLUSolve_Sgl ==============================================
+ * Abstract: Solves A*x = b with the factorization of rt_SparseLUFactor_Sgl.
+ *           b: real, single, n
+ *           x: real, single, n, may be the same as b
+ *           work is n.
+ */
+void rt_SparseLUSolve_Sgl(const rt_SparseLU *S,
+                          const real32_T      *Lx,
+                          const real32_T      *Ux,
+                          const real32_T      *Ud,
+                          const real32_T      *b,
+                          real32_T            *x,
+                          real32_T            *work)
+{
+  const int_T n = S->n;
+  int_T k, p;
+
+  for (k = 0; k < n; k++) {
+    work[k] = b[S->perm[k]];
+  }
+
+  /* Ly = b */
+  for (k = 0; k < n; k++) {
+    const real32_T yk = work[k];
+    if (yk != 0.0F) {
+      for (p = S->Lp[k]; p < S->Lp[k+1]; p++) {
+        work[S->Li[p]] -= Lx[p]*yk;
+      }
+    }
+  }
+
+  /* Ux = y */
+  for (k = n-1; k >= 0; k--) {
+    const real32_T xk = (work[k] /= Ud[k]);
+    if (xk != 0.0F) {
+      for (p = S->Up[k]; p < S->Up[k+1]; p++) {
+        work[S->Ui[p]] -= Ux[p]*xk;
+      }
+    }
+  }
+
+  for (k = 0; k < n; k++) {
+    x[S->perm[k]] = work[k];
+  }
+}
+
+/* [EOF] rt_sparse_lu_real_sgl.c */
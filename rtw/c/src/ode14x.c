@@ -3,9 +3,36 @@
  *
  * File: ode14x.c        
  *
+ * Abstract:
+ *   Extrapolation solver based on the linearly implicit Euler method.
+ *
+ *   The iteration matrices I - (h/N(j))*J are factored once per Jacobian
+ *   and the factors are kept across steps while the simplified Newton
+ *   iterations keep converging.  The Jacobian is refreshed when the step
+ *   size or the extrapolation order changes, when the contraction rate of
+ *   the Newton corrections exceeds RT_ODE14X_NEWTON_RATE, and at least
+ *   every RT_ODE14X_JACOBIAN_MAXAGE steps.  With a single Newton iteration
+ *   the convergence can not be monitored and the Jacobian is refreshed at
+ *   every step.
+ *
+ *   The Jacobian is approximated by finite differences, one derivative
+ *   evaluation per state.  Define RT_ODE14X_JPATTERN when the model
+ *   exports the sparsity pattern of the Jacobian in compressed column form
+ *   (MdlJacobianPatternJc/MdlJacobianPatternIr); columns that do not share
+ *   a row are then perturbed together, one derivative evaluation per
+ *   column group.  Define RT_ODE14X_ANALYTIC_JACOBIAN when the model
+ *   provides MdlJacobian, which fills the nx x nx column-major Jacobian at
+ *   the current time and states; it takes precedence over the finite
+ *   differences.
+ *
+ *   With RT_ODE14X_SPARSE_LU (requires RT_ODE14X_JPATTERN) the iteration
+ *   matrices are factored by the sparse LU of rt_matrixlib.h, with the
+ *   pivot order computed once from the pattern.  An iteration matrix whose
+ *   diagonal pivots turn out too small is factored densely instead.
  */
 
 #include <math.h>
+#include <float.h>
 #include <string.h>
 #include "tmwtypes.h"
 #ifdef USE_RTMODEL
@@ -18,8 +45,76 @@
 
 #define MAXORDER 4
 
+#ifndef RT_ODE14X_JACOBIAN_MAXAGE
+# define RT_ODE14X_JACOBIAN_MAXAGE  20
+#endif
+#ifndef RT_ODE14X_NEWTON_RATE
+# define RT_ODE14X_NEWTON_RATE      0.25
+#endif
+
+#ifdef RT_ODE14X_ANALYTIC_JACOBIAN
+# ifdef RT_MALLOC
+#  define JACOBIAN(si,dfdx) MdlJacobian(rtsiGetRTModelPtr(si),dfdx)
+   extern void MdlJacobian(void *rtModel, real_T *dfdx);
+# else
+#  define JACOBIAN(si,dfdx) MdlJacobian(dfdx)
+   extern void MdlJacobian(real_T *dfdx);
+# endif
+#endif
+
+#ifdef RT_ODE14X_JPATTERN
+  /* dF/dx pattern in compressed column form, nx+1 column starts */
+  extern const int_T MdlJacobianPatternJc[];
+  extern const int_T MdlJacobianPatternIr[];
+#endif
+
+#ifdef RT_ODE14X_SPARSE_LU
+# ifndef RT_ODE14X_JPATTERN
+#  error "RT_ODE14X_SPARSE_LU requires RT_ODE14X_JPATTERN"
+# endif
+/* perm, iperm, Lp, Up, Wp, scratch, Li, Ui and Wi */
+# define ODE14X_SPARSE_ISIZE(n) (6*(n)+3 + (n)*((n)-1) + (n)*(n))
+#endif
+
 static int_T rt_ODE14x_N[MAXORDER] = {12, 8, 6, 4};
 
+#ifdef RT_ODE14X_JPATTERN
+/* Curtis-Powell-Reid grouping of the columns of the Jacobian pattern: no
+ * two columns of a group have a nonzero in the same row, so all columns
+ * of a group can be perturbed with a single derivative evaluation.  The
+ * groups are filled greedily, taking the columns in order. */
+static int_T local_cpr_color(int_T        nx,
+			     const int_T  *jc,
+			     const int_T  *ir,
+			     int_T        *color,
+			     int_T        *rowMark)
+{
+    int_T nColors = 0;
+    int_T nLeft   = nx;
+    int_T i,j,k;
+
+    for (j = 0; j < nx; j++) color[j] = -1;
+    for (i = 0; i < nx; i++) rowMark[i] = -1;
+
+    while (nLeft > 0) {
+        for (j = 0; j < nx; j++) {
+            if (color[j] >= 0) continue;
+            for (k = jc[j]; k < jc[j+1]; k++) {
+                if (rowMark[ir[k]] == nColors) break;
+            }
+            if (k < jc[j+1]) continue;
+
+            for (k = jc[j]; k < jc[j+1]; k++) rowMark[ir[k]] = nColors;
+            color[j] = nColors;
+            nLeft--;
+        }
+        nColors++;
+    }
+    return nColors;
+
+} /* end local_cpr_color */
+#endif
+
 typedef struct IntgData_tag {
     /* ode14x: */
     real_T  *x0;
@@ -34,10 +129,79 @@ typedef struct IntgData_tag {
     real_T  *DFDX; /* nx x nx */
 
     /* LU: */
-    real_T  *W;    /* nx x nx */
-    int32_T *pivots; /* nx */
+    real_T  *W;    /* maxorder x nx x nx */
+    int32_T *pivots; /* maxorder x nx */
+
+    /* Jacobian reuse: */
+    time_T  hJac;       /* step size W was factored for                */
+    int_T   nFactored;  /* number of factored iteration matrices in W  */
+    int_T   jacAge;     /* steps taken with the current Jacobian       */
+    boolean_T jacStale; /* Newton iterations stopped converging        */
+
+#ifdef RT_ODE14X_JPATTERN
+    /* column groups: */
+    real_T  *del;   /* nx */
+    real_T  *Fdel;  /* nx */
+    int_T   *color; /* nx, followed by nx scratch */
+    int_T   nColors;
+#endif
+
+#ifdef RT_ODE14X_SPARSE_LU
+    /* sparse LU: */
+    rt_SparseLU slu;
+    int_T   *Wp;    /* nx+1, pattern of I - hN*J */
+    int_T   *Wi;
+    real_T  *Wx;    /* nx x nx */
+    int_T   *iwork; /* nx */
+    int_T   lnz;    /* factors of order j are stored at W+j*nx*nx as
+                       L (lnz), U (lnz) and diag(U) (nx)             */
+    boolean_T sparseOK[MAXORDER];
+#endif
 } IntgData;
 
+#ifdef RT_ODE14X_SPARSE_LU
+/* Pattern of I - hN*J (the Jacobian pattern plus the diagonal) and
+ * symbolic analysis of its LU factorization.  W is not in use yet and
+ * serves as the nx x nx workspace of the analysis. */
+static void local_sparse_lu_init(IntgData *id, int_T nx, int_T *iw)
+{
+    const int_T *jc = MdlJacobianPatternJc;
+    const int_T *ir = MdlJacobianPatternIr;
+    int_T       i,j,k,nz;
+
+    id->slu.n     = nx;
+    id->slu.perm  = iw;
+    id->slu.iperm = id->slu.perm  + nx;
+    id->slu.Lp    = id->slu.iperm + nx;
+    id->slu.Up    = id->slu.Lp    + nx + 1;
+    id->Wp        = id->slu.Up    + nx + 1;
+    id->iwork     = id->Wp        + nx + 1;
+    id->slu.Li    = id->iwork     + nx;
+    id->slu.Ui    = id->slu.Li    + nx*(nx-1)/2;
+    id->Wi        = id->slu.Ui    + nx*(nx-1)/2;
+
+    for (nz = 0, j = 0; j < nx; j++) {
+        boolean_T hasDiag = 0;
+
+        id->Wp[j] = nz;
+        for (k = jc[j]; k < jc[j+1]; k++) {
+            i = ir[k];
+            if (i == j) hasDiag = 1;
+            id->Wi[nz++] = i;
+        }
+        if (!hasDiag) id->Wi[nz++] = j;
+    }
+    id->Wp[nx] = nz;
+
+    id->lnz = rt_SparseLUSymbolic(&id->slu, id->Wp, id->Wi,
+                                  (boolean_T *) id->W, id->iwork);
+    for (k = 0; k < MAXORDER; k++) {
+        id->sparseOK[k] = 0;
+    }
+
+} /* end local_sparse_lu_init */
+#endif
+
 #ifndef RT_MALLOC
   /* statically declare data */
   static real_T   rt_ODE14x_X0[NCSTATES];
@@ -48,8 +212,17 @@ typedef struct IntgData_tag {
   static real_T   rt_ODE14x_E[MAXORDER*NCSTATES];
   static real_T   rt_ODE14x_FAC[NCSTATES];
   static real_T   rt_ODE14x_DFDX[NCSTATES*NCSTATES];
-  static real_T   rt_ODE14x_W[NCSTATES*NCSTATES];
-  static int32_T  rt_ODE14x_PIVOTS[NCSTATES];
+  static real_T   rt_ODE14x_W[MAXORDER*NCSTATES*NCSTATES];
+  static int32_T  rt_ODE14x_PIVOTS[MAXORDER*NCSTATES];
+#ifdef RT_ODE14X_JPATTERN
+  static real_T   rt_ODE14x_DEL[NCSTATES];
+  static real_T   rt_ODE14x_FDEL[NCSTATES];
+  static int_T    rt_ODE14x_COLOR[2*NCSTATES];
+#endif
+#ifdef RT_ODE14X_SPARSE_LU
+  static real_T   rt_ODE14x_WX[NCSTATES*NCSTATES];
+  static int_T    rt_ODE14x_SPARSE[ODE14X_SPARSE_ISIZE(NCSTATES)];
+#endif
 
   static IntgData rt_ODE14x_IntgData = {rt_ODE14x_X0,
                                         rt_ODE14x_F0,
@@ -60,7 +233,19 @@ typedef struct IntgData_tag {
 					rt_ODE14x_FAC,
 					rt_ODE14x_DFDX,
                                         rt_ODE14x_W,
-                                        rt_ODE14x_PIVOTS};
+                                        rt_ODE14x_PIVOTS,
+                                        0.0,
+                                        0,
+                                        0,
+                                        1
+#ifdef RT_ODE14X_JPATTERN
+                                        ,
+                                        rt_ODE14x_DEL,
+                                        rt_ODE14x_FDEL,
+                                        rt_ODE14x_COLOR,
+                                        0
+#endif
+                                        };
 					
   void rt_ODECreateIntegrationData(RTWSolverInfo *si)
   {
@@ -70,6 +255,18 @@ typedef struct IntgData_tag {
 	  for (i = 0; i < NCSTATES; i++) {
 	      rt_ODE14x_IntgData.fac[i] = SQRT_EPS;
 	  } 
+#ifdef RT_ODE14X_JPATTERN
+	  rt_ODE14x_IntgData.nColors =
+	      local_cpr_color(NCSTATES,
+			      MdlJacobianPatternJc,
+			      MdlJacobianPatternIr,
+			      rt_ODE14x_IntgData.color,
+			      rt_ODE14x_IntgData.color + NCSTATES);
+#endif
+#ifdef RT_ODE14X_SPARSE_LU
+	  rt_ODE14x_IntgData.Wx = rt_ODE14x_WX;
+	  local_sparse_lu_init(&rt_ODE14x_IntgData, NCSTATES, rt_ODE14x_SPARSE);
+#endif
       }
 
       rtsiSetSolverData(si,(void *)&rt_ODE14x_IntgData);
@@ -83,7 +280,14 @@ typedef struct IntgData_tag {
       int_T nx    = rtsiGetNumContStates(si);
       int_T vsize = nx * sizeof(real_T);
       int_T msize = nx * vsize;
-      int_T size  = (6+MAXORDER)*vsize + 2*msize + nx*sizeof(int_T); 
+      int_T size  = (6+MAXORDER)*vsize + (1+MAXORDER)*msize +
+                    MAXORDER*nx*sizeof(int32_T); 
+#ifdef RT_ODE14X_JPATTERN
+      size += 2*vsize + 2*nx*sizeof(int_T);
+#endif
+#ifdef RT_ODE14X_SPARSE_LU
+      size += msize + ODE14X_SPARSE_ISIZE(nx)*sizeof(int_T);
+#endif
 
       IntgData *id = (IntgData *) malloc(sizeof(IntgData));
       if(id == NULL) {
@@ -103,8 +307,27 @@ typedef struct IntgData_tag {
       id->E       = id->Delta   + nx;
       id->fac     = id->E       + MAXORDER * nx;
       id->DFDX    = id->fac     + nx;
+#if defined(RT_ODE14X_SPARSE_LU)
+      id->del     = id->DFDX    + nx * nx;
+      id->Fdel    = id->del     + nx;
+      id->Wx      = id->Fdel    + nx;
+      id->W       = id->Wx      + nx * nx;
+      id->pivots  = (int32_T *) (id->W + MAXORDER * nx * nx);
+      id->color   = (int_T *) (id->pivots + MAXORDER * nx);
+#elif defined(RT_ODE14X_JPATTERN)
+      id->del     = id->DFDX    + nx * nx;
+      id->Fdel    = id->del     + nx;
+      id->W       = id->Fdel    + nx;
+      id->pivots  = (int32_T *) (id->W + MAXORDER * nx * nx);
+      id->color   = (int_T *) (id->pivots + MAXORDER * nx);
+#else
       id->W       = id->DFDX    + nx * nx;
-      id->pivots  = (int32_T *) (id->W + nx * nx);
+      id->pivots  = (int32_T *) (id->W + MAXORDER * nx * nx);
+#endif
+      id->hJac      = 0.0;
+      id->nFactored = 0;
+      id->jacAge    = 0;
+      id->jacStale  = 1;
 
       { /* Initialize */
 	  real_T SQRT_EPS = 1.5e-8;   /* sqrt(utGetEps()); */
@@ -112,6 +335,16 @@ typedef struct IntgData_tag {
 	  for (i = 0; i < nx; i++) {
 	      id->fac[i] = SQRT_EPS;
 	  } 
+#ifdef RT_ODE14X_JPATTERN
+	  id->nColors = local_cpr_color(nx,
+					MdlJacobianPatternJc,
+					MdlJacobianPatternIr,
+					id->color,
+					id->color + nx);
+#endif
+#ifdef RT_ODE14X_SPARSE_LU
+	  local_sparse_lu_init(id, nx, id->color + 2*nx);
+#endif
       }
 
       rtsiSetSolverData(si, (void *)id);
@@ -239,6 +472,218 @@ void local_numjac(RTWSolverInfo   *si,
 } /* end local_numjac */
 
 
+#ifdef RT_ODE14X_JPATTERN
+/* Same as local_numjac, perturbing one group of structurally orthogonal
+ * columns (see local_cpr_color) per derivative evaluation. */
+static void local_sparse_numjac(RTWSolverInfo   *si,
+				IntgData        *id,
+				real_T          *y,
+				const real_T    *Fty,
+				real_T          *fac,
+				real_T          *dFdy)
+{
+    /* constants */
+    real_T THRESH = 1e-6;
+    real_T EPS    = 2.2e-16;  /* utGetEps(); */
+    real_T BL     = pow(EPS, 0.75);
+    real_T BU     = pow(EPS, 0.25);
+    real_T FACMIN = pow(EPS, 0.78);
+    real_T FACMAX = 0.1;
+
+#ifdef NCSTATES
+    int_T     nx = NCSTATES;
+#else
+    int_T     nx = rtsiGetNumContStates(si);
+#endif
+
+    const int_T *jc   = MdlJacobianPatternJc;
+    const int_T *ir   = MdlJacobianPatternIr;
+    real_T    *x      = rtsiGetContStates(si);
+    real_T    *del    = id->del;
+    real_T    *Fdel   = id->Fdel;
+    int_T     *color  = id->color;
+    real_T    difmax;
+    real_T    FdelRowmax;
+    real_T    temp;
+    real_T    Fdiff;
+    real_T    maybe;
+    real_T    xscale;
+    real_T    fscale;
+    int_T     rowmax;
+    int_T     c,i,j,k;
+
+    if (x != y) (void)memcpy(x,y,nx*sizeof(real_T));
+    (void)memset(dFdy,0,nx*nx*sizeof(real_T));
+
+    for (c = 0; c < id->nColors; c++) {
+
+        /* Select the increments and perturb all columns of the group. */
+        for (j = 0; j < nx; j++) {
+            if (color[j] != c) continue;
+
+            xscale = fabs(y[j]);
+            if (xscale < THRESH) xscale = THRESH;
+            temp   = (y[j] + fac[j]*xscale);
+            del[j] = temp - y[j];
+            while (del[j] == 0.0) {
+                if (fac[j] < FACMAX) {
+                    fac[j] *= 100.0;
+                    if (fac[j] > FACMAX) fac[j] = FACMAX;
+                    temp   = (y[j] + fac[j]*xscale);
+                    del[j] = temp - y[j];
+                } else {
+                    del[j] = THRESH; /* thresh is nonzero */
+                    break;
+                }
+            }
+            /* Keep del pointing into region. */
+            if (Fty[j] >= 0.0) del[j] = fabs(del[j]);
+            else del[j] = -fabs(del[j]);
+
+            x[j] = y[j] + del[j];
+        }
+
+        rtsiSetdX(si,Fdel);
+        OUTPUTS(si,0);
+        DERIVATIVES(si);
+
+        /* Form the difference approximations to the columns of the group. */
+        for (j = 0; j < nx; j++) {
+            if (color[j] != c) continue;
+
+            x[j] = y[j];
+            if (jc[j] == jc[j+1]) continue;
+
+            difmax = 0.0;
+            rowmax = ir[jc[j]];
+            FdelRowmax = Fdel[rowmax];
+            temp = 1.0 / del[j];
+            for (k = jc[j]; k < jc[j+1]; k++) {
+                i = ir[k];
+                Fdiff = Fdel[i] - Fty[i];
+                maybe = fabs(Fdiff);
+                if (maybe > difmax) {
+                    difmax = maybe;
+                    rowmax = i;
+                    FdelRowmax = Fdel[i];
+                }
+                dFdy[j*nx+i] = temp * Fdiff;
+            }
+
+            /* Adjust fac for next call to numjac. */
+            if (((FdelRowmax != 0.0) && (Fty[rowmax] != 0.0)) || (difmax == 0.0)) {
+                fscale = fabs(FdelRowmax);
+                if (fscale < fabs(Fty[rowmax])) fscale = fabs(Fty[rowmax]);
+
+                if (difmax <= BL*fscale) {
+                    /* The difference is small, so increase the increment. */
+                    fac[j] *= 10.0;
+                    if (fac[j] > FACMAX) fac[j] = FACMAX;
+
+                } else if (difmax > BU*fscale) {
+                    /* The difference is large, so reduce the increment. */
+                    fac[j] *= 0.1;
+                    if (fac[j] < FACMIN) fac[j] = FACMIN;
+
+                }
+            }
+        }
+    }
+
+} /* end local_sparse_numjac */
+#endif
+
+
+static real_T local_norm(const real_T *v, int_T nx)
+{
+    real_T vnorm = 0.0;
+    int_T  i;
+
+    for (i = 0; i < nx; i++) {
+        if (fabs(v[i]) > vnorm) vnorm = fabs(v[i]);
+    }
+    return vnorm;
+
+} /* end local_norm */
+
+
+/* Monitor the simplified Newton iterations: flag the Jacobian as stale
+ * when the second correction is not much smaller than the first one. */
+static void local_newton_rate(IntgData      *id,
+			      const real_T  *Delta,
+			      const real_T  *x,
+			      real_T        dnorm0,
+			      int_T         nx)
+{
+    real_T dnorm = local_norm(Delta, nx);
+    real_T xnorm = local_norm(x, nx);
+
+    if (dnorm > RT_ODE14X_NEWTON_RATE*dnorm0 &&
+        dnorm > 16.0*DBL_EPSILON*xnorm) {
+        id->jacStale = 1;
+    }
+
+} /* end local_newton_rate */
+
+
+/* [L,U] = lu(I - hN*J) for extrapolation order j, work is nx */
+static void local_lu_factor(IntgData *id, int_T j, real_T hN, int_T nx,
+			    real_T *work)
+{
+    real_T *Wj   = id->W + j*nx*nx;
+    real_T *dfdx = id->DFDX;
+    real_T *p;
+    int_T  i;
+
+#ifdef RT_ODE14X_SPARSE_LU
+    {
+        int_T c, q;
+
+        for (c = 0; c < nx; c++) {
+            for (q = id->Wp[c]; q < id->Wp[c+1]; q++) {
+                i = id->Wi[q];
+                id->Wx[q] = -hN*dfdx[c*nx+i];
+                if (i == c) id->Wx[q] += 1.0;
+            }
+        }
+        id->sparseOK[j] = rt_SparseLUFactor_Dbl(&id->slu, id->Wp, id->Wi,
+                                                id->Wx, Wj, Wj + id->lnz,
+                                                Wj + 2*id->lnz, work);
+        if (id->sparseOK[j]) return;
+    }
+#else
+    (void)work;
+#endif
+
+    (void) memcpy(Wj, dfdx, nx*nx*sizeof(real_T));
+    for (p = Wj, i = 0; i < nx*nx; i++, p++) *p *= (-hN);
+    for (p = Wj, i = 0; i < nx; i++, p += (nx+1)) *p += 1.0;
+    rt_lu_real(Wj,nx,id->pivots + j*nx);
+
+} /* end local_lu_factor */
+
+
+/* Delta = (U \ (L \ Delta)) for extrapolation order j, work is nx */
+static void local_lu_solve(IntgData *id, int_T j, real_T *Delta, int_T nx,
+			   real_T *work)
+{
+    real_T *Wj = id->W + j*nx*nx;
+
+#ifdef RT_ODE14X_SPARSE_LU
+    if (id->sparseOK[j]) {
+        rt_SparseLUSolve_Dbl(&id->slu, Wj, Wj + id->lnz, Wj + 2*id->lnz,
+                             Delta, Delta, work);
+        return;
+    }
+#endif
+
+    /* Modeled after rt_matdivrr_dbl.c */
+    rt_ForwardSubstitutionRR_Dbl(Wj,Delta,work,nx,1,id->pivots + j*nx,1);
+    rt_BackwardSubstitutionRR_Dbl(Wj+nx*nx-1,work+nx-1,Delta,nx,1,0);
+
+} /* end local_lu_solve */
+
+
 void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
 {
     time_T    t0         = rtsiGetT(si);
@@ -257,9 +702,8 @@ void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
     real_T    *E         = id->E;
     real_T    *fac       = id->fac;
     real_T    *dfdx      = id->DFDX;
-    real_T    *W         = id->W;
-    int_T     *pivots    = id->pivots;
     int_T     *N         = &(rt_ODE14x_N[0]); 
+    real_T    dnorm0     = 0.0;
     int_T     i,j,k,iter;
 
 #ifdef NCSTATES
@@ -278,28 +722,39 @@ void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
     rtsiSetdX(si, f0);
     DERIVATIVES(si);
 
-    /* Compute the Jacobian */
-    local_numjac(si,x0,f0,fac,dfdx);
+    /* Compute the Jacobian and the iteration matrices, unless the ones of
+       the previous steps can be reused. */
+    if (numIter < 2 || id->jacStale || id->jacAge >= RT_ODE14X_JACOBIAN_MAXAGE ||
+        id->hJac != h || id->nFactored < order) {
+
+#if defined(RT_ODE14X_ANALYTIC_JACOBIAN)
+	JACOBIAN(si,dfdx);
+#elif defined(RT_ODE14X_JPATTERN)
+	local_sparse_numjac(si,id,x0,f0,fac,dfdx);
+#else
+	local_numjac(si,x0,f0,fac,dfdx);
+#endif
+
+	for (j = 0; j < order; j++) {
+	    local_lu_factor(id,j,h / N[j],nx,f1);
+	}
+	id->hJac      = h;
+	id->nFactored = order;
+	id->jacAge    = 0;
+	id->jacStale  = 0;
+    }
+    id->jacAge++;
 
     for (j = 0; j < order; j++) {
 	
-	real_T *p;
 	real_T hN = h / N[j];
-	
-	/* Get the iteration matrix and solution at t0 */
-
-	/* [L,U] = lu(I - hN*J) */
-        (void) memcpy(W, dfdx, nx*nx*sizeof(real_T));
-        for (p = W, i = 0; i < nx*nx; i++, p++) *p *= (-hN);
-        for (p = W, i = 0; i < nx; i++, p += (nx+1)) *p += 1.0;
-	rt_lu_real(W,nx,pivots);
 
 	/* First Newton's iteration at t0. */
 	/* rhs = hN*f0  */
 	for (i = 0; i < nx; i++) Delta[i] = hN*f0[i];
 	/* Delta = (U \ (L \ rhs)) */
-	rt_ForwardSubstitutionRR_Dbl(W,Delta,f1,nx,1,pivots,1);
-	rt_BackwardSubstitutionRR_Dbl(W+nx*nx-1,f1+nx-1,Delta,nx,1,0);
+	local_lu_solve(id,j,Delta,nx,f1);
+	dnorm0 = local_norm(Delta, nx);
 	/* ytmp = y0 + Delta */ 
 	(void)memcpy(x1, x0, nx*sizeof(real_T));
 	for (i = 0; i < nx; i++) x1[i] += Delta[i];
@@ -320,10 +775,10 @@ void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
 
 	    for (i = 0; i < nx; i++) Delta[i] = (x0[i]-x1[i]) + hN*f1[i];
 
-	    rt_ForwardSubstitutionRR_Dbl(W,Delta,f1,nx,1,pivots,1);
-	    rt_BackwardSubstitutionRR_Dbl(W+nx*nx-1,f1+nx-1,Delta,nx,1,0);
+	    local_lu_solve(id,j,Delta,nx,f1);
 
 	    for (i = 0; i < nx; i++) x1[i] += Delta[i];
+	    if (iter == 1) local_newton_rate(id,Delta,x1,dnorm0,nx);
 	}
 
 	/* Subintegration of N(j) steps for extrapolation 
@@ -354,11 +809,15 @@ void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
 		    for (i = 0; i < nx; i++) Delta[i] = (x1start[i]-x1[i]) + hN*f1[i];
 		}
 
-		/* Modeled after rt_matdivrr_dbl.c, use f1 as a temp storage */
-		rt_ForwardSubstitutionRR_Dbl(W,Delta,f1,nx,1,pivots,1);
-		rt_BackwardSubstitutionRR_Dbl(W+nx*nx-1,f1+nx-1,Delta,nx,1,0);
+		/* use f1 as a temp storage */
+		local_lu_solve(id,j,Delta,nx,f1);
 
 		for (i = 0; i < nx; i++) x1[i] += Delta[i];
+		if (iter == 0) {
+		    dnorm0 = local_norm(Delta, nx);
+		} else if (iter == 1) {
+		    local_newton_rate(id,Delta,x1,dnorm0,nx);
+		}
 	    }   
 	}
 
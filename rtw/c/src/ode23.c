@@ -0,0 +1,83 @@
+/*
+ * File: ode23.c
+ *
+ * Abstract:
+ *   Bogacki-Shampine 3(2) embedded Runge-Kutta pair with local error
+ *   control, for use with the fixed-step timing engine of rsim and rapid
+ *   accelerator.  Works like ode45.c (same driver in odeerk.h, tolerances,
+ *   step size control and handling of the solver stop time) with three new
+ *   derivative evaluations per internal step instead of six, which pays off
+ *   at crude tolerances and in the presence of mild stiffness.
+ *
+ *   The continuous extension used at the solver stop time is the cubic
+ *   Hermite interpolant through the end points of the step.
+ */
+
+#include <math.h>
+#include "tmwtypes.h"
+#ifdef USE_RTMODEL
+# include "simstruc_types.h"
+#else
+# include "simstruc.h"
+#endif
+
+#define ODE_ERK_NSTAGES 4
+#include "odeerk.h"
+
+static const real_T rt_ODE23_A[3] = {
+    1.0/2.0, 3.0/4.0, 1.0
+};
+
+static const real_T rt_ODE23_B[3][3] = {
+    {1.0/2.0, 0.0, 0.0},
+    {0.0, 3.0/4.0, 0.0},
+    {2.0/9.0, 1.0/3.0, 4.0/9.0}
+};
+
+/* difference between the 3rd and 2nd order weights */
+static const real_T rt_ODE23_E[4] = {
+    -5.0/72.0, 1.0/12.0, 1.0/9.0, -1.0/8.0
+};
+
+static void rt_ODE23Interpolate(real_T       *x,
+                                const real_T *y,
+                                real_T *const *f,
+                                int_T        nXc,
+                                time_T       h,
+                                real_T       s)
+{
+    int_T i;
+
+    for (i = 0; i < nXc; i++) {
+        real_T ydiff = x[i] - y[i];
+        real_T hf0   = h*f[0][i];
+        real_T hf3   = h*f[3][i];
+
+        x[i] = y[i] + s*(hf0 + s*((3.0*ydiff - 2.0*hf0 - hf3) +
+                                  s*(hf0 + hf3 - 2.0*ydiff)));
+    }
+}
+
+static const rt_ODEERKTableau rt_ODE23_Tableau = {
+    "ode23",
+    "ode23: unable to meet the integration tolerances without reducing "
+    "the step size below the smallest value allowed",
+    rt_ODE23_A,
+    &rt_ODE23_B[0][0],
+    rt_ODE23_E,
+    1.0/3.0 - 0.75*ODE_ERK_BETA,
+    rt_ODE23Interpolate
+};
+
+void rt_ODECreateIntegrationData(RTWSolverInfo *si)
+{
+    rt_ODEERKCreateIntegrationData(si, &rt_ODE23_Tableau);
+}
+
+void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
+{
+    rt_ODEERKUpdateContinuousStates(si, &rt_ODE23_Tableau);
+}
+
+
+/* [EOF] ode23.c */
@@ -0,0 +1,95 @@
+/*
+ * File: ode45.c
+ *
+ * Abstract:
+ *   Dormand-Prince 5(4) embedded Runge-Kutta pair with local error control,
+ *   for use with the fixed-step timing engine of rsim and rapid accelerator.
+ *   The step size control and the handling of the solver stop time are in
+ *   odeerk.h; the continuous extension used at the solver stop time is of
+ *   order 4.
+ */
+
+#include <math.h>
+#include "tmwtypes.h"
+#ifdef USE_RTMODEL
+# include "simstruc_types.h"
+#else
+# include "simstruc.h"
+#endif
+
+#define ODE_ERK_NSTAGES 7
+#include "odeerk.h"
+
+static const real_T rt_ODE45_A[6] = {
+    1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0
+};
+
+static const real_T rt_ODE45_B[6][6] = {
+    {1.0/5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {3.0/40.0, 9.0/40.0, 0.0, 0.0, 0.0, 0.0},
+    {44.0/45.0, -56.0/15.0, 32.0/9.0, 0.0, 0.0, 0.0},
+    {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0, 0.0, 0.0},
+    {9017.0/3168.0,-355.0/33.0,46732.0/5247.0,49.0/176.0,-5103.0/18656.0,0.0},
+    {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0}
+};
+
+/* difference between the 5th and 4th order weights */
+static const real_T rt_ODE45_E[7] = {
+    71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0,
+    22.0/525.0, -1.0/40.0
+};
+
+/* continuous extension of order 4 (Hairer, Norsett & Wanner) */
+static const real_T rt_ODE45_D[7] = {
+    -12715105075.0/11282082432.0, 0.0, 87487479700.0/32700410799.0,
+    -10690763975.0/1880347072.0, 701980252875.0/199316789632.0,
+    -1453857185.0/822651844.0, 69997945.0/29380423.0
+};
+
+static void rt_ODE45Interpolate(real_T       *x,
+                                const real_T *y,
+                                real_T *const *f,
+                                int_T        nXc,
+                                time_T       h,
+                                real_T       s)
+{
+    real_T s1 = 1.0 - s;
+    int_T  i, j;
+
+    for (i = 0; i < nXc; i++) {
+        real_T ydiff = x[i] - y[i];
+        real_T bspl  = h*f[0][i] - ydiff;
+        real_T r4    = ydiff - h*f[6][i] - bspl;
+        real_T r5    = 0.0;
+
+        for (j = 0; j < 7; j++) {
+            r5 += rt_ODE45_D[j]*f[j][i];
+        }
+        r5 *= h;
+        x[i] = y[i] + s*(ydiff + s1*(bspl + s*(r4 + s1*r5)));
+    }
+}
+
+static const rt_ODEERKTableau rt_ODE45_Tableau = {
+    "ode45",
+    "ode45: unable to meet the integration tolerances without reducing "
+    "the step size below the smallest value allowed",
+    rt_ODE45_A,
+    &rt_ODE45_B[0][0],
+    rt_ODE45_E,
+    0.2 - 0.75*ODE_ERK_BETA,
+    rt_ODE45Interpolate
+};
+
+void rt_ODECreateIntegrationData(RTWSolverInfo *si)
+{
+    rt_ODEERKCreateIntegrationData(si, &rt_ODE45_Tableau);
+}
+
+void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
+{
+    rt_ODEERKUpdateContinuousStates(si, &rt_ODE45_Tableau);
+}
+
+
+/* [EOF] ode45.c */
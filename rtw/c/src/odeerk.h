@@ -0,0 +1,263 @@
+/*
+ * File: odeerk.h
+ *
+ * Abstract:
+ *   Driver shared by the embedded Runge-Kutta solvers with local error
+ *   control (ode45.c, ode23.c), for use with the fixed-step timing engine
+ *   of rsim and rapid accelerator.  A solver supplies its tableau and
+ *   defines ODE_ERK_NSTAGES, its number of stages, before including this
+ *   file.
+ *
+ *   Each major step from rtsiGetT to rtsiGetSolverStopTime is covered by as
+ *   many internal steps as the error tolerances (RT_ODE_RELTOL and
+ *   RT_ODE_ABSTOL) require.  The internal step size is carried across major
+ *   steps by a PI controller, so quiet stretches take a single internal step
+ *   per major step while fast transients are refined automatically.
+ *
+ *   The last stage of a step is evaluated at the new states and is the
+ *   first stage of the next one (FSAL).  An internal step is not truncated
+ *   at the solver stop time: when it goes past it, the states at the stop
+ *   time are computed from the continuous extension of the step.  The
+ *   stages past the stop time see the discrete signals as they were before
+ *   the sample hit, and only the interpolated states at the hit are kept.
+ *
+ *   Not suitable for hard real-time targets since the number of derivative
+ *   evaluations per major step is not bounded.
+ */
+
+#ifndef __ODE_ERK__
+#define __ODE_ERK__
+
+#include <float.h>
+#include <string.h>
+#include "odesup.h"
+
+#ifndef ODE_ERK_NSTAGES
+# error "must define ODE_ERK_NSTAGES"
+#endif
+
+#ifndef RT_ODE_RELTOL
+# define RT_ODE_RELTOL  1.0e-3
+#endif
+#ifndef RT_ODE_ABSTOL
+# define RT_ODE_ABSTOL  1.0e-6
+#endif
+
+/* PI step size controller */
+#define ODE_ERK_SAFETY   0.9
+#define ODE_ERK_FACMIN   0.2     /* largest decrease of the step size */
+#define ODE_ERK_FACMAX   10.0    /* largest increase of the step size */
+#define ODE_ERK_BETA     0.04
+#define ODE_ERK_ERRMIN   1.0e-4
+
+typedef struct rt_ODEERKTableau_tag {
+    const char_T *name;
+    const char_T *minStepError;
+    /* nodes and coefficients of stages 2 to ODE_ERK_NSTAGES, the
+     * coefficients row by row, ODE_ERK_NSTAGES-1 to a row */
+    const real_T *A;
+    const real_T *B;
+    const real_T *E;      /* difference between the weights of the pair  */
+    real_T       alpha;   /* exponent of the error norm in the controller */
+    /* continuous extension: on entry x holds the new states of the step
+     * of size h from y, on exit the states at the fraction s of it */
+    void (*interpolate)(real_T *x, const real_T *y, real_T *const *f,
+                        int_T nXc, time_T h, real_T s);
+} rt_ODEERKTableau;
+
+typedef struct IntgData_tag {
+    real_T *y;
+    real_T *f[ODE_ERK_NSTAGES];
+    time_T hNext;     /* internal step size for the next step, 0 if unknown */
+    real_T errOld;    /* error norm of the last accepted step              */
+} IntgData;
+
+#ifndef RT_MALLOC
+  /* statically declare data */
+  static real_T   rt_ODEERK_Y[NCSTATES];
+  static real_T   rt_ODEERK_F[ODE_ERK_NSTAGES][NCSTATES];
+  static IntgData rt_ODEERK_IntgData;
+
+  static void rt_ODEERKCreateIntegrationData(RTWSolverInfo          *si,
+                                             const rt_ODEERKTableau *tab)
+  {
+      int_T i;
+
+      rt_ODEERK_IntgData.y = rt_ODEERK_Y;
+      for (i = 0; i < ODE_ERK_NSTAGES; i++) {
+          rt_ODEERK_IntgData.f[i] = rt_ODEERK_F[i];
+      }
+      rt_ODEERK_IntgData.hNext  = 0.0;
+      rt_ODEERK_IntgData.errOld = ODE_ERK_ERRMIN;
+
+      rtsiSetSolverData(si,(void *)&rt_ODEERK_IntgData);
+      rtsiSetSolverName(si,tab->name);
+  }
+#else
+  /* dynamically allocated data */
+
+  static void rt_ODEERKCreateIntegrationData(RTWSolverInfo          *si,
+                                             const rt_ODEERKTableau *tab)
+  {
+      int_T    i;
+      IntgData *id = (IntgData *) malloc(sizeof(IntgData));
+      if(id == NULL) {
+          rtsiSetErrorStatus(si, RT_MEMORY_ALLOCATION_ERROR);
+          return;
+      }
+
+      id->y = (real_T *) malloc((ODE_ERK_NSTAGES+1)*rtsiGetNumContStates(si) *
+                                sizeof(real_T));
+      if(id->y == NULL) {
+          rtsiSetErrorStatus(si, RT_MEMORY_ALLOCATION_ERROR);
+          return;
+      }
+      id->f[0] = id->y + rtsiGetNumContStates(si);
+      for (i = 1; i < ODE_ERK_NSTAGES; i++) {
+          id->f[i] = id->f[i-1] + rtsiGetNumContStates(si);
+      }
+      id->hNext  = 0.0;
+      id->errOld = ODE_ERK_ERRMIN;
+
+      rtsiSetSolverData(si, (void *)id);
+      rtsiSetSolverName(si,tab->name);
+  }
+
+  void rt_ODEDestroyIntegrationData(RTWSolverInfo *si)
+  {
+      IntgData *id = rtsiGetSolverData(si);
+
+      if (id != NULL) {
+          if (id->y != NULL) {
+              free(id->y);
+          }
+          free(id);
+          rtsiSetSolverData(si, NULL);
+      }
+  }
+#endif
+
+static void rt_ODEERKUpdateContinuousStates(RTWSolverInfo          *si,
+                                            const rt_ODEERKTableau *tab)
+{
+    time_T    t          = rtsiGetT(si);
+    time_T    tnew       = rtsiGetSolverStopTime(si);
+    time_T    tspan      = tnew - t;
+    time_T    tInt       = t;
+    time_T    h;
+    time_T    hmax       = rtsiGetStepSize(si);
+    real_T    *x         = rtsiGetContStates(si);
+    IntgData  *id        = rtsiGetSolverData(si);
+    real_T    *y         = id->y;
+    real_T    **f        = id->f;
+    int_T     i, j, k;
+
+#ifdef NCSTATES
+    int_T     nXc        = NCSTATES;
+#else
+    int_T     nXc        = rtsiGetNumContStates(si);
+#endif
+
+    if (tspan <= 0.0) return;
+
+    /* overshoot tnew by at most one major step */
+    if (hmax < tspan) hmax = tspan;
+    h = (id->hNext > 0.0 && id->hNext < hmax) ? id->hNext :
+        (id->hNext > 0.0) ? hmax : tspan;
+
+    rtsiSetSimTimeStep(si,MINOR_TIME_STEP);
+
+    /* Save the state values at time t in y, we'll use x as ynew. */
+    (void)memcpy(y, x, nXc*sizeof(real_T));
+
+    /* Assumes that rtsiSetT and ModelOutputs are up-to-date */
+    /* f0 = f(t,y) */
+    rtsiSetdX(si, f[0]);
+    DERIVATIVES(si);
+
+    for (;;) {
+        real_T err = 0.0;
+        real_T fac;
+        time_T hmin = 16.0*DBL_EPSILON*((fabs(tInt) > tspan) ? fabs(tInt) :
+                                                               tspan);
+
+        /* stages 2 to ODE_ERK_NSTAGES, the last one computes ynew */
+        for (k = 0; k < ODE_ERK_NSTAGES-1; k++) {
+            const real_T *b = tab->B + k*(ODE_ERK_NSTAGES-1);
+
+            for (i = 0; i < nXc; i++) {
+                real_T sum = 0.0;
+                for (j = 0; j <= k; j++) {
+                    sum += b[j]*f[j][i];
+                }
+                x[i] = y[i] + h*sum;
+            }
+            rtsiSetT(si, tInt + h*tab->A[k]);
+            rtsiSetdX(si, f[k+1]);
+            OUTPUTS(si,0);
+            DERIVATIVES(si);
+        }
+
+        /* rms norm of the local error estimate */
+        for (i = 0; i < nXc; i++) {
+            real_T sum = 0.0;
+            real_T sc  = RT_ODE_ABSTOL +
+                RT_ODE_RELTOL*((fabs(y[i]) > fabs(x[i])) ? fabs(y[i]) :
+                                                           fabs(x[i]));
+            for (j = 0; j < ODE_ERK_NSTAGES; j++) {
+                sum += tab->E[j]*f[j][i];
+            }
+            sum *= h/sc;
+            err += sum*sum;
+        }
+        err = (nXc > 0) ? sqrt(err/nXc) : 0.0;
+
+        if (err > 1.0) {
+            /* reject the step and retry with a smaller one */
+            fac = ODE_ERK_SAFETY*pow(err, -tab->alpha);
+            h *= (fac < ODE_ERK_FACMIN) ? ODE_ERK_FACMIN : fac;
+            if (h <= hmin) {
+                rtsiSetErrorStatus(si, tab->minStepError);
+                break;
+            }
+            continue;
+        }
+
+        /* accept the step, PI control of the next step size */
+        if (err < ODE_ERK_ERRMIN) err = ODE_ERK_ERRMIN;
+        fac = ODE_ERK_SAFETY*pow(err, -tab->alpha)*
+                                        pow(id->errOld, ODE_ERK_BETA);
+        fac = (fac < ODE_ERK_FACMIN) ? ODE_ERK_FACMIN :
+              (fac > ODE_ERK_FACMAX) ? ODE_ERK_FACMAX : fac;
+        id->errOld = err;
+        id->hNext  = h*fac;
+
+        if (tInt + h >= tnew) {
+            if (tInt + h > tnew) {
+                /* dense output at tnew, x currently holds ynew */
+                tab->interpolate(x, y, f, nXc, h, (tnew - tInt)/h);
+            }
+            break;
+        }
+
+        /* advance, reusing the last stage (FSAL) */
+        tInt += h;
+        (void)memcpy(y, x, nXc*sizeof(real_T));
+        {
+            real_T *tmp = f[0];
+            f[0] = f[ODE_ERK_NSTAGES-1];
+            f[ODE_ERK_NSTAGES-1] = tmp;
+        }
+        h = (id->hNext < hmax) ? id->hNext : hmax;
+    }
+    rtsiSetT(si, tnew);
+
+    PROJECTION(si);
+    REDUCTION(si);
+
+    rtsiSetSimTimeStep(si,MAJOR_TIME_STEP);
+}
+
+#endif /* __ODE_ERK__ */
+
+/* [EOF] odeerk.h */
@@ -11,6 +11,11 @@
  ******************************************************************/
 
 /* INCLUDES */
+#if defined(RT_FROMFILE_MMAP) && !defined(_POSIX_C_SOURCE)
+/* mkstemp, fchmod and st_mtim, before any include */
+# define _POSIX_C_SOURCE 200809L
+#endif
+
 #include  <stdio.h>
 #include  <stdlib.h>
 
@@ -19,6 +24,14 @@
 #include  <float.h>
 #include  <ctype.h>
 
+#ifdef RT_FROMFILE_MMAP
+#include  <limits.h>
+#include  <fcntl.h>
+#include  <unistd.h>
+#include  <sys/mman.h>
+#include  <sys/stat.h>
+#endif
+
 /*
  * We want access to the real mx* routines in this file and not their RTW
  * variants in rt_matrx.h, the defines below prior to including simstruc.h
@@ -1298,6 +1311,353 @@ static void FreeFNamePairList(FNamePair *list, int_T len)
 } /* end FreeFFnameList */
 
 
+/* Function: TransposeTUMatrix ================================================
+ * Abstract:
+ *      Transpose the nrows x ncols (column-major) TU matrix src into dst, so
+ *      that the time vector and then each U vector are contiguous in dst.
+ *      The matrix is processed by blocks of FRF_TRANSPOSE_ROWS rows and
+ *      FRF_TRANSPOSE_COLS columns which stay in the cache, so that src is
+ *      read from memory once however many rows it has.
+ */
+#define FRF_TRANSPOSE_ROWS (32)
+#define FRF_TRANSPOSE_COLS (256)
+
+static void TransposeTUMatrix(double       *dst,
+                              const double *src,
+                              int          nrows,
+                              int          ncols)
+{
+    int r0, c0, r, c;
+
+    for (c0 = 0; c0 < ncols; c0 += FRF_TRANSPOSE_COLS) {
+        int c1 = (ncols - c0 > FRF_TRANSPOSE_COLS) ? c0+FRF_TRANSPOSE_COLS : ncols;
+        for (r0 = 0; r0 < nrows; r0 += FRF_TRANSPOSE_ROWS) {
+            int r1 = (nrows - r0 > FRF_TRANSPOSE_ROWS) ? r0+FRF_TRANSPOSE_ROWS : nrows;
+            for (r = r0; r < r1; r++) {
+                double       *d = dst + (size_t)r*ncols;
+                const double *u = src + r;
+                for (c = c0; c < c1; c++) {
+                    d[c] = u[(size_t)c*nrows];
+                }
+            }
+        }
+    }
+} /* end TransposeTUMatrix */
+
+
+#ifdef RT_FROMFILE_MMAP
+/*
+ * Streaming From File input (POSIX targets).
+ *
+ * When RT_FROMFILE_MMAP is defined, the transposed TU matrix of a From File
+ * block is read from a sidecar file "<MAT-file>.frf": a FrFSidecarHeader
+ * followed by the matrix, which is memory-mapped instead of being loaded.
+ * Reading it is O(1) and the pages of the matrix are paged in by the OS
+ * as the simulation reaches them.  No window is kept around the current
+ * time: the pages are file-backed and clean, so the resident part of the
+ * matrix is bounded only by the page cache, which reclaims them under
+ * memory pressure.
+ *
+ * The sidecar is (re)built when it is missing or was built from a MAT-file
+ * of another size, inode or modification time (to the nanosecond),
+ * straight from a mapping of the MAT-file when this is an uncompressed
+ * version 5 MAT-file (saved with -v6), whose first variable is a real
+ * double matrix.  Other MAT-files are loaded through the MAT-file API as
+ * without RT_FROMFILE_MMAP.  It is written to a temporary file which is
+ * renamed over the sidecar once complete, so that a simulation reading the
+ * sidecar, or an interrupted build, never sees a partial one.
+ *
+ * A tuDataMatrix which was mapped must be released with
+ * rt_RapidFreeFromFileBlockData, not free.  The From File code generated
+ * for the model still frees tuDataMatrix itself, so it must be changed to
+ * call rt_RapidFreeFromFileBlockData before RT_FROMFILE_MMAP can be used.
+ */
+#define FRF_SIDECAR_EXT   ".frf"
+#define FRF_SIDECAR_MAGIC "RTWFRF02"
+
+#if defined(__APPLE__)
+# define FRF_MTIME_NSEC(st) ((st)->st_mtimespec.tv_nsec)
+#else
+# define FRF_MTIME_NSEC(st) ((st)->st_mtim.tv_nsec)
+#endif
+
+typedef struct {
+    char     magic[8];
+    int32_T  nrows;
+    int32_T  ncols;
+    real_T   matSize;      /* size, modification time and inode of the */
+    real_T   matMTime;     /* MAT-file the sidecar was built from      */
+    real_T   matMTimeNsec;
+    real_T   matIno;
+    char     pad[16];      /* the matrix is aligned on 64 bytes        */
+} FrFSidecarHeader;
+
+/* Version 5 MAT-file data types and array class, see the MAT-file format */
+#define MAT5_miUINT32        (6)
+#define MAT5_miINT32         (5)
+#define MAT5_miDOUBLE        (9)
+#define MAT5_miMATRIX        (14)
+#define MAT5_mxDOUBLE_CLASS  (6)
+#define MAT5_COMPLEX_FLAG    (0x0800)
+
+
+/* Function: FrFMat5DataOffset ================================================
+ * Abstract:
+ *      If the MAT-file is an uncompressed version 5 MAT-file of the native
+ *      byte order whose first variable is a real double 2-D matrix, return
+ *      the offset of the matrix data in the file and its dimensions.
+ *      Return -1 otherwise, and if the matrix data does not lie within the
+ *      fileSize bytes of the file.
+ */
+static long FrFMat5DataOffset(FILE *fp, off_t fileSize, int *nrows, int *ncols)
+{
+    unsigned char hdr[128];
+    uint32_T      tag[2];
+    uint32_T      sub[4];
+    uint16_T      version, endian;
+    long          pos;
+    size_t        nbytes;
+
+    if (fread(hdr, 1, sizeof(hdr), fp) != sizeof(hdr)) return -1;
+    (void)memcpy(&version, hdr+124, sizeof(version));
+    (void)memcpy(&endian,  hdr+126, sizeof(endian));
+    if (version != 0x0100 || endian != (('M' << 8) | 'I')) return -1;
+
+    /* the first variable */
+    if (fread(tag, sizeof(uint32_T), 2, fp) != 2) return -1;
+    if (tag[0] != MAT5_miMATRIX) return -1;
+
+    /* array flags */
+    if (fread(sub, sizeof(uint32_T), 4, fp) != 4) return -1;
+    if (sub[0] != MAT5_miUINT32 || (sub[2] & 0xFF) != MAT5_mxDOUBLE_CLASS ||
+        (sub[2] & MAT5_COMPLEX_FLAG) != 0) return -1;
+
+    /* dimensions */
+    if (fread(sub, sizeof(uint32_T), 4, fp) != 4) return -1;
+    if (sub[0] != MAT5_miINT32 || sub[1] != 2*sizeof(int32_T)) return -1;
+    if (sub[2] > INT_MAX || sub[3] > INT_MAX ||
+        (sub[3] != 0 &&
+         sub[2] > (size_t)fileSize / sizeof(double) / sub[3])) return -1;
+    *nrows = (int)sub[2];
+    *ncols = (int)sub[3];
+    nbytes = (size_t)*nrows * *ncols * sizeof(double);
+
+    /* array name, in the small data element format if 4 bytes or less */
+    if (fread(tag, sizeof(uint32_T), 2, fp) != 2) return -1;
+    pos = ftell(fp);
+    if ((tag[0] >> 16) == 0) {
+        pos += (long)((tag[1] + 7) & ~7U);
+    }
+
+    /* real part, which must be stored as doubles */
+    if (fseek(fp, pos, SEEK_SET) != 0 ||
+        fread(tag, sizeof(uint32_T), 2, fp) != 2) return -1;
+    if (tag[0] != MAT5_miDOUBLE || (size_t)tag[1] != nbytes) return -1;
+
+    pos += 2*(long)sizeof(uint32_T);
+    if ((off_t)pos > fileSize || (size_t)(fileSize - pos) < nbytes) return -1;
+    return pos;
+} /* end FrFMat5DataOffset */
+
+
+/* Function: FrFMapSidecar =====================================================
+ * Abstract:
+ *      Map the sidecar file if it is valid for the MAT-file and set the
+ *      FrFInfo fields.  Return 1 on success, 0 otherwise.
+ */
+static int FrFMapSidecar(const char        *sidecar,
+                         const struct stat *matStat,
+                         FrFInfo           *frFInfo)
+{
+    FrFSidecarHeader hdr;
+    struct stat      st;
+    void             *map;
+    int              fd = open(sidecar, O_RDONLY);
+
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 ||
+        read(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr) ||
+        memcmp(hdr.magic, FRF_SIDECAR_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.nrows != frFInfo->originalWidth || hdr.ncols < 0 ||
+        hdr.matSize != (real_T)matStat->st_size ||
+        hdr.matMTime != (real_T)matStat->st_mtime ||
+        hdr.matMTimeNsec != (real_T)FRF_MTIME_NSEC(matStat) ||
+        hdr.matIno != (real_T)matStat->st_ino ||
+        (size_t)st.st_size != sizeof(hdr) +
+        (size_t)hdr.nrows * hdr.ncols * sizeof(double)) {
+        (void)close(fd);
+        return 0;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    frFInfo->nptsPerSignal = hdr.ncols;
+    frFInfo->nptsTotal     = hdr.nrows * hdr.ncols;
+    frFInfo->tuDataMatrix  = (double *)((char *)map + sizeof(hdr));
+    frFInfo->tuDataMap     = map;
+    frFInfo->tuDataMapSize = (size_t)st.st_size;
+    return 1;
+} /* end FrFMapSidecar */
+
+
+/* Function: FrFBuildSidecar ===================================================
+ * Abstract:
+ *      Build the sidecar file from a mapping of the MAT-file, when it is an
+ *      uncompressed version 5 MAT-file.  The sidecar is written to a unique
+ *      temporary file, synced and renamed over the sidecar.  If it cannot
+ *      be written, tuDataMatrix is allocated and transposed from the mapping
+ *      instead.
+ *
+ * Returns:
+ *      1 if the sidecar was built, tuDataMatrix was allocated or an error
+ *        message was set,
+ *      0 if the MAT-file must be read through the MAT-file API.
+ */
+static int FrFBuildSidecar(const char        *matFile,
+                           const char        *sidecar,
+                           const struct stat *matStat,
+                           FrFInfo           *frFInfo,
+                           char              *errmsg)
+{
+    FILE         *fp;
+    long         offset;
+    int          nrows, ncols, i;
+    int          fd;
+    void         *matMap;
+    const double *matData;
+    size_t       nbytes;
+    char         *tmpName;
+
+    if ((fp = fopen(matFile, "rb")) == NULL) return 0;
+    offset = FrFMat5DataOffset(fp, matStat->st_size, &nrows, &ncols);
+    (void)fclose(fp);
+    if (offset < 0) return 0;
+
+    if (nrows<2) {
+        (void)sprintf(errmsg,"\"From File\" matrix variable from MAT-file "
+                      "'%s' must contain at least 2 rows", matFile);
+        return 1;
+    }
+    if (frFInfo->originalWidth != nrows) {
+        (void)sprintf(errmsg,"\"From File\" number of rows in MAT-file "
+                      "'%s' must match original number of rows", matFile);
+        return 1;
+    }
+
+    if ((fd = open(matFile, O_RDONLY)) < 0) return 0;
+    matMap = mmap(NULL, (size_t)matStat->st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (matMap == MAP_FAILED) return 0;
+    matData = (const double *)((const char *)matMap + offset);
+
+    for (i=1; i<ncols; i++) {
+        if (matData[(size_t)i*nrows] < matData[(size_t)(i-1)*nrows]) {
+            (void)sprintf(errmsg,"Time in \"From File\" MAT-file "
+                          "'%s' must be monotonically increasing",
+                          matFile);
+            goto EXIT_POINT;
+        }
+    }
+
+    frFInfo->nptsPerSignal = ncols;
+    frFInfo->nptsTotal     = nrows * ncols;
+    nbytes = (size_t)nrows * ncols * sizeof(double);
+
+    /* Write the sidecar under a temporary name, then rename it. */
+    tmpName = (char *)malloc(strlen(sidecar) + sizeof(".XXXXXX"));
+    fd      = -1;
+    if (tmpName != NULL) {
+        (void)strcpy(tmpName, sidecar);
+        (void)strcat(tmpName, ".XXXXXX");
+        fd = mkstemp(tmpName);
+    }
+    if (fd >= 0) {
+        FrFSidecarHeader hdr;
+        void             *map = MAP_FAILED;
+
+        if (fchmod(fd, 0644) == 0 &&
+            ftruncate(fd, (off_t)(sizeof(hdr) + nbytes)) == 0) {
+            map = mmap(NULL, sizeof(hdr) + nbytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+        }
+        if (map != MAP_FAILED) {
+            TransposeTUMatrix((double *)((char *)map + sizeof(hdr)), matData,
+                              nrows, ncols);
+
+            (void)memset(&hdr, 0, sizeof(hdr));
+            (void)memcpy(hdr.magic, FRF_SIDECAR_MAGIC, sizeof(hdr.magic));
+            hdr.nrows        = nrows;
+            hdr.ncols        = ncols;
+            hdr.matSize      = (real_T)matStat->st_size;
+            hdr.matMTime     = (real_T)matStat->st_mtime;
+            hdr.matMTimeNsec = (real_T)FRF_MTIME_NSEC(matStat);
+            hdr.matIno       = (real_T)matStat->st_ino;
+            (void)memcpy(map, &hdr, sizeof(hdr));
+
+            if (msync(map, sizeof(hdr) + nbytes, MS_SYNC) == 0 &&
+                fsync(fd) == 0 && rename(tmpName, sidecar) == 0) {
+                frFInfo->tuDataMatrix  = (double *)((char *)map + sizeof(hdr));
+                frFInfo->tuDataMap     = map;
+                frFInfo->tuDataMapSize = sizeof(hdr) + nbytes;
+            } else {
+                (void)munmap(map, sizeof(hdr) + nbytes);
+            }
+        }
+        (void)close(fd);
+        if (frFInfo->tuDataMap == NULL) (void)unlink(tmpName);
+    }
+    free(tmpName);
+
+    if (frFInfo->tuDataMap == NULL) {
+        /* no sidecar: still avoid loading the whole MAT-file variable */
+        if ((frFInfo->tuDataMatrix = (double*)malloc(nbytes)) == NULL) {
+            (void)sprintf(errmsg,"memory allocation error "
+                          "(rt_RapidReadFromFileBlockMatFile %s)", matFile);
+            goto EXIT_POINT;
+        }
+        TransposeTUMatrix(frFInfo->tuDataMatrix, matData, nrows, ncols);
+    }
+
+EXIT_POINT:
+    (void)munmap(matMap, (size_t)matStat->st_size);
+    return 1;
+} /* end FrFBuildSidecar */
+
+
+/* Function: FrFStreamMatFile ==================================================
+ * Abstract:
+ *      Map the transposed TU matrix of the MAT-file from its sidecar,
+ *      building the sidecar first if needed.
+ *
+ * Returns:
+ *      1 if tuDataMatrix was set or an error message was set,
+ *      0 if the MAT-file must be read through the MAT-file API.
+ */
+static int FrFStreamMatFile(FrFInfo *frFInfo, char *errmsg)
+{
+    const char  *matFile = frFInfo->newFileName;
+    char        *sidecar;
+    struct stat matStat;
+    int         done;
+
+    if (stat(matFile, &matStat) != 0) return 0; /* reported by matOpen */
+
+    sidecar = (char *)malloc(strlen(matFile) + sizeof(FRF_SIDECAR_EXT));
+    if (sidecar == NULL) return 0;
+    (void)strcpy(sidecar, matFile);
+    (void)strcat(sidecar, FRF_SIDECAR_EXT);
+
+    done = FrFMapSidecar(sidecar, &matStat, frFInfo) ||
+        FrFBuildSidecar(matFile, sidecar, &matStat, frFInfo, errmsg);
+
+    free(sidecar);
+    return done;
+} /* end FrFStreamMatFile */
+#endif /* RT_FROMFILE_MMAP */
+
+
 /*==================*
  * Visible routines *
  *==================*/
@@ -1331,10 +1691,14 @@ const char *rt_RapidReadFromFileBlockMatFile(const char *origFileName,
     const double *matData;
     size_t       nbytes;
     int          nrows, ncols;
-    int          rowIdx, colIdx;
     const char   *matFile;
 
     errmsg[0] = '\0'; /* assume success */
+    pmat      = NULL;
+
+    frFInfo->tuDataMatrix  = NULL;
+    frFInfo->tuDataMap     = NULL;
+    frFInfo->tuDataMapSize = 0;
 
     /******************************************************************
      * Remap the "original" MAT-filename if told to do by user via a *
@@ -1357,6 +1721,10 @@ const char *rt_RapidReadFromFileBlockMatFile(const char *origFileName,
         }
     }
 
+#ifdef RT_FROMFILE_MMAP
+    if (FrFStreamMatFile(frFInfo, errmsg)) goto EXIT_POINT;
+#endif
+
     if ((pmat=matOpen(matFile=frFInfo->newFileName,"r")) == NULL) {
         (void)sprintf(errmsg,"could not open MAT-file '%s' containing "
                       "From File Block data", matFile);
@@ -1412,7 +1780,7 @@ const char *rt_RapidReadFromFileBlockMatFile(const char *origFileName,
      * have the same signal length as in the original model. They
      * can be substantially larger if desired.
      */
-    nbytes = (size_t)(nrows * ncols * (size_t)sizeof(double));
+    nbytes = (size_t)nrows * ncols * sizeof(double);
 
     if ((frFInfo->tuDataMatrix = (double*)malloc(nbytes)) == NULL) {
         (void)sprintf(errmsg,"memory allocation error "
@@ -1421,12 +1789,7 @@ const char *rt_RapidReadFromFileBlockMatFile(const char *origFileName,
     }
 
     /* Copy and transpose data into "tuDataMatrix" */
-    for (rowIdx=0; rowIdx<frFInfo->originalWidth; rowIdx++) {
-        for (colIdx=0; colIdx<frFInfo->nptsPerSignal; colIdx++) {
-            frFInfo->tuDataMatrix[colIdx + rowIdx*frFInfo->nptsPerSignal] =
-                matData[rowIdx + colIdx*frFInfo->originalWidth];
-        }
-    }
+    TransposeTUMatrix(frFInfo->tuDataMatrix, matData, nrows, ncols);
 
 
 EXIT_POINT:
@@ -1445,6 +1808,26 @@ EXIT_POINT:
 } /* end rt_RapidReadFromFileBlockMatFile */
 
 
+/* Function: rt_RapidFreeFromFileBlockData =====================================
+ * Abstract:
+ *      Release the TU matrix read by rt_RapidReadFromFileBlockMatFile.
+ */
+void rt_RapidFreeFromFileBlockData(FrFInfo *frFInfo)
+{
+#ifdef RT_FROMFILE_MMAP
+    if (frFInfo->tuDataMap != NULL) {
+        (void)munmap(frFInfo->tuDataMap, frFInfo->tuDataMapSize);
+        frFInfo->tuDataMap     = NULL;
+        frFInfo->tuDataMapSize = 0;
+    } else
+#endif
+    {
+        free(frFInfo->tuDataMatrix);
+    }
+    frFInfo->tuDataMatrix = NULL;
+} /* end rt_RapidFreeFromFileBlockData */
+
+
 /* Function:  Interpolate_Datatype================================
  * Abstract:
  *      Performs Lagrange interpolation on a pair of data values of
@@ -44,6 +44,7 @@ extern "C" {
 #endif
 
 #include <math.h>
+#include <stddef.h>
 
 
     /*==========*
@@ -73,6 +74,8 @@ extern "C" {
     int         nptsTotal;
     int         nptsPerSignal;
     double      *tuDataMatrix;
+    void        *tuDataMap;     /* mapping holding tuDataMatrix, or NULL  */
+    size_t      tuDataMapSize;  /* (see RT_FROMFILE_MMAP in common_utils.c) */
 } FrFInfo;
 
 
@@ -112,6 +115,8 @@ extern "C" {
                                                         int originalWidth,
                                                         FrFInfo *frFInfo);
 
+    extern void rt_RapidFreeFromFileBlockData(FrFInfo *frFInfo);
+
     extern void *rt_GetOSigstreamManager(void);
 
     extern void **rt_GetOSigstreamManagerAddr(void);
@@ -10,6 +10,24 @@
  *      major time step and finally written to a MAT-file at the end of the
  *      simulation.
  *
+ *      When RT_LOGGING_STREAM is defined, log variables that would otherwise
+ *      grow in memory (or wrap with an infinite stop time) keep only a buffer
+ *      of RT_LOGGING_STREAM_CHUNK_SIZE bytes.  Each time the buffer fills, the
+ *      chunk is appended to an anonymous spool file and the buffer is reused.
+ *      At the end of the simulation the spooled chunks are copied into the
+ *      MAT-file, so peak logging memory no longer depends on the simulation
+ *      length.
+ *
+ *      When RT_LOGGING_ASYNC is defined (POSIX targets), rt_UpdateTXYLogVars
+ *      only copies the raw time, state and output data into a lock-free
+ *      queue of RT_LOGGING_ASYNC_SLOTS steps and a writer thread does the
+ *      actual logging.  RT_LOGGING_ASYNC_POLICY selects what a step does when
+ *      the queue is full:
+ *         RT_LOGGING_ASYNC_BLOCK        wait for the writer (default)
+ *         RT_LOGGING_ASYNC_DROP_OLDEST  discard the oldest queued step
+ *         RT_LOGGING_ASYNC_DROP_NEWEST  discard the current step
+ *      Dropped steps are counted and reported at the end of the simulation.
+ *
  *      This file handles redefining the following standard MathWorks types
  *      (see tmwtypes.h):
  *         [u]int8_T     to be int32_T (logged as Matlab [u]int32)
@@ -24,6 +42,11 @@
 #include <limits.h>
 #include <math.h>
 
+#ifdef RT_LOGGING_ASYNC
+#include <pthread.h>
+#include <time.h>
+#endif
+
 
 #if !defined(MAT_FILE) || (defined(MAT_FILE) && MAT_FILE == 1)
 
@@ -67,6 +90,30 @@
 #define DEFAULT_BUFFER_SIZE      1024  /* used if maxRows=0 and Tfinal=0.0    */
 #endif
 
+#ifndef RT_LOGGING_STREAM_CHUNK_SIZE
+#define RT_LOGGING_STREAM_CHUNK_SIZE  (1L << 20) /* bytes per streamed chunk */
+#endif
+
+#define RT_LOGGING_ASYNC_BLOCK         0
+#define RT_LOGGING_ASYNC_DROP_OLDEST   1
+#define RT_LOGGING_ASYNC_DROP_NEWEST   2
+
+#ifndef RT_LOGGING_ASYNC_POLICY
+#define RT_LOGGING_ASYNC_POLICY  RT_LOGGING_ASYNC_BLOCK
+#endif
+
+#ifndef RT_LOGGING_ASYNC_SLOTS
+#define RT_LOGGING_ASYNC_SLOTS   256   /* must be a power of two */
+#endif
+
+#ifndef RT_LOGGING_ASYNC_POLL_USEC
+#define RT_LOGGING_ASYNC_POLL_USEC  1000  /* idle poll period of the writer */
+#endif
+
+#if (RT_LOGGING_ASYNC_SLOTS & (RT_LOGGING_ASYNC_SLOTS - 1)) != 0
+#error "RT_LOGGING_ASYNC_SLOTS must be a power of two"
+#endif
+
 #define FREE(m) if (m != NULL) free(m)
 
 /* Logical definitions */
@@ -83,6 +130,50 @@
  * typedefs *
  *==========*/
 
+#ifdef RT_LOGGING_ASYNC
+typedef struct AsyncLogEntry_Tag {
+    int_T        idx;                  /* index into the signal pointers      */
+    size_t       nBytes;               /* bytes copied from that pointer      */
+} AsyncLogEntry;
+
+typedef struct AsyncLogSigs_Tag {
+    int_T         nEntries;            /* number of signals copied per step   */
+    int_T         nPtrs;               /* length of the shadow pointer array  */
+    AsyncLogEntry *entries;
+} AsyncLogSigs;
+
+typedef struct AsyncSlot_Tag {
+    time_T       t;                    /* time of the step                    */
+    boolean_T    updateTXY;            /* else only update xFinal             */
+                                       /* followed by the X then Y data       */
+} AsyncSlot;
+
+typedef struct AsyncLog_Tag {
+    unsigned long head;                /* next slot to fill (producer)        */
+    char_T        pad[64];             /* keep head and tail on separate
+                                        * cache lines                         */
+    unsigned long tail;                /* next slot to drain (writer)         */
+    int_T         stop;                /* ask the writer to drain and exit    */
+    const char_T  *errMsg;             /* first error seen by the writer      */
+
+    unsigned long mask;                /* RT_LOGGING_ASYNC_SLOTS - 1          */
+    size_t        slotBytes;           /* bytes per slot, 8-byte aligned      */
+    char_T        *slots;              /* the ring                            */
+    AsyncLogSigs  xSigs;               /* state data copied per step          */
+    AsyncLogSigs  ySigs;               /* output data copied per step         */
+
+    RTWLogInfo    li;                  /* copy of the log info used by the
+                                        * writer, pointing at the shadows     */
+    const int8_T  **xShadow;           /* state pointers into a slot          */
+    const int8_T  **yShadow;           /* output pointers into a slot         */
+
+    pthread_t     writer;
+    boolean_T     running;
+    unsigned long nPushed;             /* steps queued                        */
+    unsigned long nDropped;            /* steps lost to a full queue          */
+} AsyncLog;
+#endif
+
 typedef struct LogInfo_Tag {
     LogVar       *t;                   /* Time log variable                   */
     void         *x;                   /* State log variable                  */
@@ -94,8 +185,24 @@ typedef struct LogInfo_Tag {
     StructLogVar *structLogVarsList;   /* Linked list of all StructLogVars    */
 
     boolean_T   haveLogVars;           /* Are logging one or more vars?       */
+#ifdef RT_LOGGING_ASYNC
+    AsyncLog    *async;                /* Writer thread for T,X,Y and xFinal  */
+#endif
 } LogInfo;
 
+struct LogSpool_Tag {
+    FILE      *fp;             /* anonymous file holding the flushed chunks  */
+    int_T     chunkRows;       /* number of rows in each flushed chunk       */
+    int_T     nChunks;         /* number of chunks written to fp             */
+    int_T     tailRows;        /* rows still in memory when the file closes  */
+    int_T     nSegs;           /* segments per chunk: nCols if the data is
+                                * transposed for MATLAB, 1 otherwise         */
+    size_t    segRowBytes;     /* bytes of one row within a segment          */
+    char_T    *scratch;        /* one chunk part, used to transpose and copy */
+    boolean_T failed;          /* a write failed, keep the rest in memory    */
+    boolean_T full;            /* at the MAT-file size limit, log no more    */
+};
+
 typedef struct MatItem_tag {
   int32_T    type;
   uint32_T    nbytes;
@@ -607,6 +714,258 @@ static int_T rt_GetMatIdFromMxId(mxClassID mxID)
 } /* end rt_GetMatIdFromMxId */
 
 
+/* Function: rt_GatherLogSpoolSegment ==========================================
+ * Abstract:
+ *      Copy segBytes from each of nRows rows that are rowBytes apart in src
+ *      into the contiguous buffer dst.
+ */
+static void rt_GatherLogSpoolSegment(char_T       *dst,
+                                     const char_T *src,
+                                     int_T        nRows,
+                                     size_t       rowBytes,
+                                     size_t       segBytes)
+{
+    int_T r;
+
+    for (r = 0; r < nRows; r++) {
+        (void)memcpy(dst, src, segBytes);
+        dst += segBytes;
+        src += rowBytes;
+    }
+
+} /* end rt_GatherLogSpoolSegment */
+
+
+/* Function: rt_LogVarTooBig ===================================================
+ * Abstract:
+ *      Whether nPoints rows of a log variable exceed what a version 5
+ *      MAT-file can hold: the data elements are sized with 32 bits.
+ */
+static boolean_T rt_LogVarTooBig(const MatrixData *data, double nPoints)
+{
+    return((boolean_T)(nPoints > INT_MAX ||
+                       nPoints * data->nCols * data->elSize *
+                       (data->complex ? 2 : 1) >= UINT_MAX));
+
+} /* end rt_LogVarTooBig */
+
+
+/* Function: rt_SkipLogSpool ===================================================
+ * Abstract:
+ *      Move the position of a spool file nBytes (at most a chunk) forward.
+ *      The spool is only ever moved relative to the current position, so no
+ *      offset larger than a chunk is formed whatever the size of the file
+ *      (a long is 32 bits on some 64-bit hosts).
+ */
+static int_T rt_SkipLogSpool(FILE *fp, size_t nBytes)
+{
+    if (nBytes == 0) return(0);
+#if defined(_WIN32)
+    return(_fseeki64(fp, (__int64)nBytes, SEEK_CUR) != 0);
+#else
+    return(fseek(fp, (long)nBytes, SEEK_CUR) != 0);
+#endif
+
+} /* end rt_SkipLogSpool */
+
+
+/* Function: rt_DestroyLogSpool ================================================
+ * Abstract:
+ *      Close the spool file (which removes it) and free the spool.
+ */
+static void rt_DestroyLogSpool(LogSpool *spool)
+{
+    if (spool != NULL) {
+        if (spool->fp != NULL) {
+            (void)fclose(spool->fp);
+        }
+        FREE(spool->scratch);
+        free(spool);
+    }
+
+} /* end rt_DestroyLogSpool */
+
+
+#ifdef RT_LOGGING_STREAM
+/* Function: rt_CreateLogSpool =================================================
+ * Abstract:
+ *      Create the disk spool for a log variable whose buffer holds exactly one
+ *      chunk (var->data.nRows rows).  Each chunk is stored as the real part
+ *      followed by the imaginary part.  Data that rt_FixupLogVar would
+ *      transpose is stored column by column within each part so that the
+ *      MAT-file can later be written with contiguous reads.
+ *
+ * Returns:
+ *	~= NULL  => success
+ *	== NULL  => failure, the variable is logged in memory instead
+ */
+static LogSpool *rt_CreateLogSpool(const LogVar *var)
+{
+    LogSpool *spool    = calloc(1, sizeof(LogSpool));
+    size_t   rowBytes  = var->data.nCols * var->data.elSize;
+
+    if (spool == NULL) goto ERROR_EXIT;
+
+    spool->chunkRows = var->data.nRows;
+    if (var->data.nDims < 2 && var->data.nCols > 1) {
+        spool->nSegs       = var->data.nCols;
+        spool->segRowBytes = var->data.elSize;
+    } else {
+        spool->nSegs       = 1;
+        spool->segRowBytes = rowBytes;
+    }
+    if ((spool->scratch = malloc(spool->chunkRows*rowBytes)) == NULL) {
+        goto ERROR_EXIT;
+    }
+    if ((spool->fp = tmpfile()) == NULL) goto ERROR_EXIT;
+
+    return(spool); /* NORMAL_EXIT */
+
+  ERROR_EXIT:
+    (void)fprintf(stderr, "*** Unable to create a spool file for log variable "
+                  "%s, logging it in memory\n", var->data.name);
+    rt_DestroyLogSpool(spool);
+    return(NULL);
+
+} /* end rt_CreateLogSpool */
+#endif /* RT_LOGGING_STREAM */
+
+
+/* Function: rt_SpoolLogVarChunk ===============================================
+ * Abstract:
+ *      Append the full buffer of a log variable to its spool file and rewind
+ *      the buffer.  A chunk is only flushed if the variable can still take
+ *      another full buffer after it without exceeding the MAT-file limits;
+ *      otherwise the variable is full and keeps the buffer as it is.
+ *
+ *      Return values is
+ *          == 0 : upon success
+ *          >  0 : the spool is unusable, the caller must grow the buffer
+ *          <  0 : the variable is full, the caller must drop the point
+ */
+static int_T rt_SpoolLogVarChunk(LogVar *var)
+{
+    LogSpool     *spool    = var->data.spool;
+    int_T        chunkRows = spool->chunkRows;
+    size_t       rowBytes  = var->data.nCols * var->data.elSize;
+    size_t       segBytes  = chunkRows * spool->segRowBytes;
+    size_t       partBytes = chunkRows * rowBytes;
+    const char_T *parts[2];
+    int_T        nParts    = var->data.complex ? 2 : 1;
+    int_T        p;
+
+    if (spool->full) return(-1);
+    if (spool->failed || var->data.nRows != chunkRows) return(1);
+
+    if (rt_LogVarTooBig(&var->data,
+                        ((double)spool->nChunks + 2) * chunkRows)) {
+        (void)fprintf(stderr, "*** Log variable %s has reached the MAT-file "
+                      "size limit, no more data is logged for it\n",
+                      var->data.name);
+        spool->full = 1;
+        return(-1);
+    }
+
+    parts[0] = var->data.re;
+    parts[1] = var->data.im;
+    for (p = 0; p < nParts; p++) {
+        const char_T *src = parts[p];
+
+        if (spool->nSegs > 1) {
+            int_T s;
+            for (s = 0; s < spool->nSegs; s++) {
+                rt_GatherLogSpoolSegment(spool->scratch + s*segBytes,
+                                         src + s*spool->segRowBytes,
+                                         chunkRows, rowBytes,
+                                         spool->segRowBytes);
+            }
+            src = spool->scratch;
+        }
+        if (fwrite(src, 1, partBytes, spool->fp) != partBytes) {
+            (void)fprintf(stderr, "*** Error writing log variable %s to its "
+                          "spool file, logging the remaining data in memory\n",
+                          var->data.name);
+            spool->failed = 1;
+            return(1);
+        }
+    }
+    ++spool->nChunks;
+    var->rowIdx = 0;
+    return(0);
+
+} /* end rt_SpoolLogVarChunk */
+
+
+/* Function: rt_WriteSpooledMatData ============================================
+ * Abstract:
+ *      Write the real (imagPart == 0) or imaginary part of a spooled log
+ *      variable as a mat data element.  The spooled chunks are copied first,
+ *      followed by the tailRows rows that are still in memory.
+ *
+ *      Return values is
+ *          == 0 : upon success
+ *          <> 0 : upon failure
+ */
+static int_T rt_WriteSpooledMatData(FILE             *fp,
+                                    const MatItem    *pItem,
+                                    const MatrixData *var,
+                                    int_T            imagPart)
+{
+    const LogSpool *spool     = var->spool;
+    const char_T   *tail      = imagPart ? var->im : var->re;
+    size_t         rowBytes   = var->nCols * var->elSize;
+    size_t         segBytes   = spool->chunkRows * spool->segRowBytes;
+    size_t         partBytes  = spool->chunkRows * rowBytes;
+    size_t         chunkBytes = var->complex ? 2*partBytes : partBytes;
+    int32_T        nAlignBytes;
+    int_T          s;
+
+    if (fwrite(pItem, 1, matTAG_SIZE, fp) != matTAG_SIZE) return(1);
+
+    for (s = 0; s < spool->nSegs; s++) {
+        int_T k;
+
+        /* segment s of each chunk, chunkBytes apart */
+        if (fseek(spool->fp, 0L, SEEK_SET) != 0 ||
+            rt_SkipLogSpool(spool->fp, imagPart*partBytes + s*segBytes)) {
+            return(1);
+        }
+        for (k = 0; k < spool->nChunks; k++) {
+            if ((k > 0 && rt_SkipLogSpool(spool->fp, chunkBytes - segBytes)) ||
+                fread(spool->scratch, 1, segBytes, spool->fp) != segBytes ||
+                fwrite(spool->scratch, 1, segBytes, fp) != segBytes) {
+                return(1);
+            }
+        }
+        if (spool->nSegs > 1) {
+            const char_T *src = tail + s*spool->segRowBytes;
+            int_T        r;
+
+            for (r = 0; r < spool->tailRows; r++, src += rowBytes) {
+                if (fwrite(src, 1, spool->segRowBytes, fp) !=
+                                                        spool->segRowBytes) {
+                    return(1);
+                }
+            }
+        } else {
+            size_t tailBytes = spool->tailRows * rowBytes;
+            if (fwrite(tail, 1, tailBytes, fp) != tailBytes) return(1);
+        }
+    }
+
+    /* Add offset for 8-byte alignment */
+    nAlignBytes = matINT64_ALIGN(pItem->nbytes) - pItem->nbytes;
+    if (nAlignBytes > 0) {
+        int pad[2] = {0, 0};
+        if ( fwrite(pad,1,nAlignBytes,fp) != ((size_t) nAlignBytes) ) {
+            return(1);
+        }
+    }
+    return(0);
+
+} /* end rt_WriteSpooledMatData */
+
+
 /* Forward declaration */
 static int_T rt_WriteItemToMatFile(FILE         *fp,
                                    MatItem      *pItem,
@@ -750,7 +1109,12 @@ static int_T rt_ProcessMatItem(FILE         *fp,
         if (cmd) {
             item.type = matID;
             item.data = var->re;
-            if (rt_WriteItemToMatFile(fp, &item, DATA_ITEM)) {
+            if (var->spool != NULL) {
+                if (rt_WriteSpooledMatData(fp, &item, var, 0)) {
+                    retStat = 1;
+                    goto EXIT_POINT;
+                }
+            } else if (rt_WriteItemToMatFile(fp, &item, DATA_ITEM)) {
                 retStat = 1;
                 goto EXIT_POINT;
             }
@@ -764,7 +1128,12 @@ static int_T rt_ProcessMatItem(FILE         *fp,
             if (cmd) {
                 item.type = matID;
                 item.data = var->im;
-                if (rt_WriteItemToMatFile(fp, &item, DATA_ITEM)) {
+                if (var->spool != NULL) {
+                    if (rt_WriteSpooledMatData(fp, &item, var, 1)) {
+                        retStat = 1;
+                        goto EXIT_POINT;
+                    }
+                } else if (rt_WriteItemToMatFile(fp, &item, DATA_ITEM)) {
                     retStat = 1;
                     goto EXIT_POINT;
                 }
@@ -941,6 +1310,7 @@ static int_T rt_ProcessMatItem(FILE         *fp,
                       tempData.complex = 0;
                       tempData.frameData = 0;
                       tempData.frameSize = 1;
+                      tempData.spool = NULL;
 
                       item.type = matMATRIX;                    
                       item.data = &tempData; /*values->valDims;*/
@@ -1207,6 +1577,32 @@ static const char_T *rt_FixupLogVar(LogVar *var,int verbose)
     size_t elSize  = var->data.elSize;
     int_T  nRows   = (var->wrapped ?  maxRows : var->rowIdx);
 
+    if (var->data.spool != NULL) {
+        LogSpool *spool = var->data.spool;
+
+        if (spool->nChunks == 0) {
+            /* everything fit in one chunk, write it from memory */
+            rt_DestroyLogSpool(spool);
+            var->data.spool = NULL;
+        } else {
+            /*
+             * The spooled chunks are already in MATLAB order and the rows in
+             * memory are reordered as they are written out, so just record
+             * the total number of rows.
+             */
+            double nPoints = (double)spool->nChunks * spool->chunkRows +
+                                                                 var->rowIdx;
+
+            if (rt_LogVarTooBig(&var->data, nPoints)) {
+                return("log variable is too big to be saved in a MAT-file\n");
+            }
+            spool->tailRows  = var->rowIdx;
+            var->nDataPoints = (int_T)nPoints;
+            var->data.nRows  = var->nDataPoints;
+            return(NULL);
+        }
+    }
+
     var->nDataPoints = var->rowIdx + var->wrapped * maxRows;
 
     if (var->wrapped > 1 || (var->wrapped == 1 && var->rowIdx != 0)) {
@@ -1488,6 +1884,7 @@ static void rt_DestroyLogVar(LogVar *head)
         head = var->next;
         FREE(var->data.re);
         FREE(var->data.im);
+        rt_DestroyLogSpool(var->data.spool);
         if (var->data.dims != var->data._dims) {
             FREE(var->data.dims);
         }
@@ -2557,10 +2954,16 @@ const char_T *rt_UpdateLogVarWithDiscontiguousData(LogVar                 *var,
     var->numHits = 0;
 
     /*
-     * Reallocate or wrap the LogVar
+     * Spool, reallocate or wrap the LogVar
      */
     if (var->rowIdx == var->data.nRows) {
-        if (var->okayToRealloc == 1) {
+        int_T spooled = (var->data.spool != NULL) ?
+                                            rt_SpoolLogVarChunk(var) : 1;
+        if (spooled < 0) {
+            return(NULL); /* at the MAT-file size limit */
+        } else if (spooled == 0) {
+            /* buffer flushed to disk, rowIdx has been reset */
+        } else if (var->okayToRealloc == 1) {
             rt_ReallocLogVar(var, false);
         } else {
             /* Circular buffer */
@@ -2643,6 +3046,422 @@ const char_T *rt_UpdateLogVarWithDiscontiguousData(LogVar                 *var,
 } /* end rt_UpdateLogVarWithDiscontinuousData */
 
 
+/* Forward declaration */
+static const char_T *rt_LogTXXFYData(RTWLogInfo *li,
+                                     time_T     *tPtr,
+                                     boolean_T  updateTXY);
+
+#ifdef RT_LOGGING_ASYNC
+
+/*
+ * Asynchronous logging of the T, X, Y and xFinal variables.
+ *
+ * rt_UpdateTXXFYLogVars only copies the raw time, state and output data of
+ * the current step into a slot of a single-producer/single-consumer ring.
+ * A writer thread pops the slots and does the decimation, data type
+ * conversion and buffer (or spool) updates by running the synchronous
+ * logging code on the copy.  The producer never takes a lock; when the ring
+ * is full RT_LOGGING_ASYNC_POLICY selects what happens to the step.
+ */
+
+/* Function: rt_GetLogVarInputBytes ============================================
+ * Abstract:
+ *      Number of bytes of model data consumed by one call to rt_UpdateLogVar
+ *      for this log variable, i.e., one (frame of the) signal before any
+ *      data type conversion.
+ */
+static size_t rt_GetLogVarInputBytes(const LogVar *var)
+{
+    const RTWLogDataTypeConvert *cvt = &var->data.dataTypeConvertInfo;
+    size_t pointSize;
+
+    if (cvt->conversionNeeded && cvt->numOfChunk > 1) {
+        pointSize = (size_t)(cvt->bitsPerChunk * cvt->numOfChunk / 8);
+        if (var->data.complex) pointSize *= 2;
+    } else {
+        BuiltInDTypeId dTypeID = cvt->conversionNeeded ?
+            (BuiltInDTypeId)cvt->dataTypeIdOriginal : var->data.dTypeID;
+
+        pointSize = var->data.complex ? rt_GetSizeofComplexType(dTypeID) :
+                                        rt_GetSizeofDataType(dTypeID);
+    }
+    return(pointSize * var->data.nCols * var->data.frameSize);
+
+} /* end rt_GetLogVarInputBytes */
+
+
+/* Function: rt_AddAsyncLogEntry ===============================================
+ * Abstract:
+ *      Record that entry idx of a signal pointer array holds nBytes of data
+ *      to be copied at each step.
+ */
+static void rt_AddAsyncLogEntry(AsyncLogSigs *sigs, int_T idx, size_t nBytes)
+{
+    AsyncLogEntry *entry = &sigs->entries[sigs->nEntries++];
+
+    entry->idx    = idx;
+    entry->nBytes = nBytes;
+    if (idx >= sigs->nPtrs) sigs->nPtrs = idx + 1;
+
+} /* end rt_AddAsyncLogEntry */
+
+
+/* Function: rt_InitAsyncLogSigs ===============================================
+ * Abstract:
+ *      Work out which entries of the X and Y signal pointer arrays are read
+ *      by rt_LogTXXFYData and how many bytes each of them points to.  This
+ *      mirrors the traversal in rt_LogTXXFYData.
+ *
+ * Returns:
+ *	== NULL  => success
+ *	~= NULL  => the data cannot be logged asynchronously, reason returned
+ */
+static const char_T *rt_InitAsyncLogSigs(RTWLogInfo   *li,
+                                         AsyncLogSigs *xSigs,
+                                         AsyncLogSigs *ySigs)
+{
+    LogInfo                *logInfo     = rtliGetLogInfo(li);
+    int_T                  matrixFormat = (rtliGetLogFormat(li) == 0);
+    const RTWLogSignalInfo *xInfo       = rtliGetLogXSignalInfo(li);
+    int_T                  i;
+
+    /* states */
+    if (logInfo->x != NULL || logInfo->xFinal != NULL) {
+        int_T nsig = xInfo->numSignals;
+
+        if ((xSigs->entries = calloc(nsig, sizeof(AsyncLogEntry))) == NULL) {
+            return(rtMemAllocError);
+        }
+        if (matrixFormat) {
+            const LogVar *var = (logInfo->x != NULL) ? logInfo->x :
+                                                       logInfo->xFinal;
+            size_t pointSize = (var->data.nCols > 0) ?
+                rt_GetLogVarInputBytes(var) / var->data.nCols : 0;
+
+            for (i = 0; i < nsig; i++) {
+                rt_AddAsyncLogEntry(xSigs, i, pointSize*xInfo->numCols[i]);
+            }
+        } else {
+            const StructLogVar *svar = (logInfo->x != NULL) ? logInfo->x :
+                                                              logInfo->xFinal;
+            const LogVar       *val  = svar->signals.values;
+
+            for (i = 0; i < nsig; i++, val = val->next) {
+                rt_AddAsyncLogEntry(xSigs, i, rt_GetLogVarInputBytes(val));
+            }
+        }
+    }
+
+    /* outputs */
+    if (logInfo->y != NULL) {
+        LogSignalPtrsType data = rtliGetLogYSignalPtrs(li);
+        int_T             ny   = logInfo->ny;
+        int_T             dataIdx;
+
+        if (matrixFormat) {
+            LogVar **var = (LogVar**) (logInfo->y);
+
+            if ((ySigs->entries = calloc(ny, sizeof(AsyncLogEntry))) == NULL) {
+                return(rtMemAllocError);
+            }
+            for (i = 0, dataIdx = 0; i < ny; i++) {
+                if (data[i] != NULL) {
+                    rt_AddAsyncLogEntry(ySigs, i,
+                                        rt_GetLogVarInputBytes(var[dataIdx++]));
+                }
+            }
+        } else {
+            StructLogVar **var = (StructLogVar**) (logInfo->y);
+            int_T        nsig  = (ny == 1) ? var[0]->signals.numSignals : ny;
+
+            if ((ySigs->entries = calloc(nsig, sizeof(AsyncLogEntry))) == NULL) {
+                return(rtMemAllocError);
+            }
+            for (i = 0, dataIdx = 0; i < nsig; i++) {
+                const StructLogVar *svar = (ny == 1) ? var[0] : var[i];
+                const LogVar       *val;
+                int_T              k;
+
+                if (svar == NULL) break;
+                val = svar->signals.values;
+                if (ny == 1) {
+                    for (k = 0; k < i; k++) val = val->next;
+                }
+                if (svar->signals.isVarDims[(ny == 1) ? i : 0]) {
+                    return("variable-size outputs are logged synchronously");
+                }
+                while (data[dataIdx] == NULL) {
+                    ++dataIdx;
+                }
+                rt_AddAsyncLogEntry(ySigs, dataIdx++,
+                                    rt_GetLogVarInputBytes(val));
+            }
+        }
+    }
+    return(NULL);
+
+} /* end rt_InitAsyncLogSigs */
+
+
+/* Function: rt_AsyncLogSleep ==================================================
+ * Abstract:
+ *      Sleep for RT_LOGGING_ASYNC_POLL_USEC microseconds.
+ */
+static void rt_AsyncLogSleep(void)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = RT_LOGGING_ASYNC_POLL_USEC / 1000000L;
+    ts.tv_nsec = (RT_LOGGING_ASYNC_POLL_USEC % 1000000L) * 1000L;
+    (void)nanosleep(&ts, NULL);
+
+} /* end rt_AsyncLogSleep */
+
+
+/* Function: rt_CopyAsyncLogSigs ===============================================
+ * Abstract:
+ *      Gather the signals described by sigs from the model into dst.
+ */
+static char_T *rt_CopyAsyncLogSigs(char_T             *dst,
+                                   const AsyncLogSigs *sigs,
+                                   LogSignalPtrsType  ptrs)
+{
+    int_T i;
+
+    for (i = 0; i < sigs->nEntries; i++) {
+        const AsyncLogEntry *entry = &sigs->entries[i];
+
+        (void)memcpy(dst, ptrs[entry->idx], entry->nBytes);
+        dst += matINT64_ALIGN(entry->nBytes);
+    }
+    return(dst);
+
+} /* end rt_CopyAsyncLogSigs */
+
+
+/* Function: rt_PointAsyncLogSigs ==============================================
+ * Abstract:
+ *      Point the shadow signal pointer array at the copies in src.
+ */
+static const char_T *rt_PointAsyncLogSigs(const char_T       *src,
+                                          const AsyncLogSigs *sigs,
+                                          const int8_T       **ptrs)
+{
+    int_T i;
+
+    for (i = 0; i < sigs->nEntries; i++) {
+        const AsyncLogEntry *entry = &sigs->entries[i];
+
+        ptrs[entry->idx] = (const int8_T *)src;
+        src += matINT64_ALIGN(entry->nBytes);
+    }
+    return(src);
+
+} /* end rt_PointAsyncLogSigs */
+
+
+/* Function: rt_AsyncLogWriter =================================================
+ * Abstract:
+ *      Body of the writer thread.  Each slot is copied out of the ring before
+ *      it is released, so that a producer using the drop-oldest policy can
+ *      reclaim it at any time; a slot that was reclaimed while being copied
+ *      is discarded.  Runs until stopped and the ring is empty.
+ */
+static void *rt_AsyncLogWriter(void *arg)
+{
+    AsyncLog  *al = (AsyncLog *)arg;
+    AsyncSlot *local;
+
+    local = (AsyncSlot *)malloc(al->slotBytes);
+    if (local == NULL) {
+        al->errMsg = rtMemAllocError;
+        return(NULL);
+    }
+    for (;;) {
+        unsigned long tail = __atomic_load_n(&al->tail, __ATOMIC_ACQUIRE);
+        unsigned long head = __atomic_load_n(&al->head, __ATOMIC_ACQUIRE);
+
+        if (tail == head) {
+            if (__atomic_load_n(&al->stop, __ATOMIC_ACQUIRE)) break;
+            rt_AsyncLogSleep();
+            continue;
+        }
+
+        (void)memcpy(local, al->slots + (tail & al->mask)*al->slotBytes,
+                     al->slotBytes);
+        if (!__atomic_compare_exchange_n(&al->tail, &tail, tail+1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue; /* reclaimed by the producer */
+        }
+
+        if (al->errMsg == NULL) {
+            const char_T *src = (const char_T *)(local + 1);
+            const char_T *msg;
+
+            src = rt_PointAsyncLogSigs(src, &al->xSigs, al->xShadow);
+            (void)rt_PointAsyncLogSigs(src, &al->ySigs, al->yShadow);
+            msg = rt_LogTXXFYData(&al->li, &local->t, local->updateTXY);
+            if (msg != NULL) {
+                __atomic_store_n(&al->errMsg, msg, __ATOMIC_RELEASE);
+            }
+        }
+    }
+    free(local);
+    return(NULL);
+
+} /* end rt_AsyncLogWriter */
+
+
+/* Function: rt_DestroyAsyncLog ================================================
+ * Abstract:
+ *      Stop the writer thread once it has drained the ring, report dropped
+ *      steps and free the asynchronous logging state.
+ */
+static void rt_DestroyAsyncLog(AsyncLog *al)
+{
+    if (al == NULL) return;
+
+    if (al->running) {
+        __atomic_store_n(&al->stop, 1, __ATOMIC_RELEASE);
+        (void)pthread_join(al->writer, NULL);
+    }
+    if (al->nDropped > 0) {
+        (void)fprintf(stdout,
+                      "*** Asynchronous logging dropped %lu of %lu time steps\n"
+                      "    because the logging queue of %d steps was full\n",
+                      al->nDropped, al->nPushed + al->nDropped,
+                      RT_LOGGING_ASYNC_SLOTS);
+    }
+    FREE(al->xSigs.entries);
+    FREE(al->ySigs.entries);
+    FREE(al->xShadow);
+    FREE(al->yShadow);
+    FREE(al->slots);
+    free(al);
+
+} /* end rt_DestroyAsyncLog */
+
+
+/* Function: rt_CreateAsyncLog =================================================
+ * Abstract:
+ *      Set up the ring and start the writer thread for the T, X, Y and
+ *      xFinal variables of li.
+ *
+ * Returns:
+ *	~= NULL  => success
+ *	== NULL  => failure, the variables are logged synchronously
+ */
+static AsyncLog *rt_CreateAsyncLog(RTWLogInfo *li)
+{
+    AsyncLog     *al  = calloc(1, sizeof(AsyncLog));
+    const char_T *msg = rtMemAllocError;
+    int_T        i;
+
+    if (al == NULL) goto ERROR_EXIT;
+
+    if ((msg = rt_InitAsyncLogSigs(li, &al->xSigs, &al->ySigs)) != NULL) {
+        goto ERROR_EXIT;
+    }
+    msg = rtMemAllocError;
+
+    al->slotBytes = matINT64_ALIGN(sizeof(AsyncSlot));
+    for (i = 0; i < al->xSigs.nEntries; i++) {
+        al->slotBytes += matINT64_ALIGN(al->xSigs.entries[i].nBytes);
+    }
+    for (i = 0; i < al->ySigs.nEntries; i++) {
+        al->slotBytes += matINT64_ALIGN(al->ySigs.entries[i].nBytes);
+    }
+    al->mask = RT_LOGGING_ASYNC_SLOTS - 1;
+    if ((al->slots = malloc(RT_LOGGING_ASYNC_SLOTS * al->slotBytes)) == NULL) {
+        goto ERROR_EXIT;
+    }
+
+    /* the writer thread logs through a copy of li using shadow pointers */
+    al->li = *li;
+    if (al->xSigs.nPtrs > 0) {
+        if ((al->xShadow = calloc(al->xSigs.nPtrs, sizeof(int8_T*))) == NULL) {
+            goto ERROR_EXIT;
+        }
+        rtliSetLogXSignalPtrs(&al->li, (LogSignalPtrsType)al->xShadow);
+    }
+    if (al->ySigs.nPtrs > 0) {
+        if ((al->yShadow = calloc(al->ySigs.nPtrs, sizeof(int8_T*))) == NULL) {
+            goto ERROR_EXIT;
+        }
+        rtliSetLogYSignalPtrs(&al->li, (LogSignalPtrsType)al->yShadow);
+    }
+
+    if (pthread_create(&al->writer, NULL, rt_AsyncLogWriter, al) != 0) {
+        msg = "unable to create the writer thread";
+        goto ERROR_EXIT;
+    }
+    al->running = 1;
+    return(al); /* NORMAL_EXIT */
+
+  ERROR_EXIT:
+    (void)fprintf(stdout, "*** Logging synchronously: %s\n", msg);
+    rt_DestroyAsyncLog(al);
+    return(NULL);
+
+} /* end rt_CreateAsyncLog */
+
+
+/* Function: rt_PushAsyncLog ===================================================
+ * Abstract:
+ *      Copy the data of the current step into the ring.  Called from the
+ *      model step only; never takes a lock.
+ *
+ * Returns:
+ *	== NULL  => success, or the step was dropped and counted
+ *	~= NULL  => the writer thread failed, error message returned
+ */
+static const char_T *rt_PushAsyncLog(AsyncLog   *al,
+                                     RTWLogInfo *li,
+                                     time_T     *tPtr,
+                                     boolean_T  updateTXY)
+{
+    unsigned long head = al->head;
+    unsigned long tail = __atomic_load_n(&al->tail, __ATOMIC_ACQUIRE);
+    AsyncSlot     *slot;
+    char_T        *dst;
+
+    while (head - tail > al->mask) {  /* ring is full */
+#if RT_LOGGING_ASYNC_POLICY == RT_LOGGING_ASYNC_BLOCK
+        rt_AsyncLogSleep();
+        tail = __atomic_load_n(&al->tail, __ATOMIC_ACQUIRE);
+#elif RT_LOGGING_ASYNC_POLICY == RT_LOGGING_ASYNC_DROP_OLDEST
+        if (__atomic_compare_exchange_n(&al->tail, &tail, tail+1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            ++al->nDropped;
+            --al->nPushed;
+            break;
+        }
+#else  /* RT_LOGGING_ASYNC_DROP_NEWEST */
+        ++al->nDropped;
+        return(__atomic_load_n(&al->errMsg, __ATOMIC_ACQUIRE));
+#endif
+    }
+
+    slot = (AsyncSlot *)(al->slots + (head & al->mask)*al->slotBytes);
+    slot->t         = *tPtr;
+    slot->updateTXY = updateTXY;
+    dst = (char_T *)(slot + 1);
+    if (al->xSigs.nEntries > 0) {
+        dst = rt_CopyAsyncLogSigs(dst, &al->xSigs, rtliGetLogXSignalPtrs(li));
+    }
+    if (al->ySigs.nEntries > 0) {
+        (void)rt_CopyAsyncLogSigs(dst, &al->ySigs, rtliGetLogYSignalPtrs(li));
+    }
+    __atomic_store_n(&al->head, head+1, __ATOMIC_RELEASE);
+    ++al->nPushed;
+
+    return(__atomic_load_n(&al->errMsg, __ATOMIC_ACQUIRE));
+
+} /* end rt_PushAsyncLog */
+
+#endif /* RT_LOGGING_ASYNC */
+
+
 /*==================*
  * Visible routines *
  *==================*/
@@ -2698,6 +3517,9 @@ LogVar *rt_CreateLogVarWithConvert(
     int_T          frameSize;
     int_T          nRows;
     int_T          nColumns;
+#ifdef RT_LOGGING_STREAM
+    boolean_T      streamToDisk;
+#endif
 
     /*===================================================================*
      * Determine the frame size if the data is frame based               *
@@ -2782,11 +3604,16 @@ LogVar *rt_CreateLogVarWithConvert(
             nRows = maxRows+1;
             okayToRealloc = 1;
         } else {                    /* Use a default value for nRows          */
+#ifdef RT_LOGGING_STREAM
+            nRows = DEFAULT_BUFFER_SIZE;
+            okayToRealloc = 1;  /* Streamed to disk, never wraps */
+#else
             usingDefaultBufSize = 1;
             nRows = DEFAULT_BUFFER_SIZE;
             okayToRealloc = 0;  /* No realloc with infinite stop time */
             (void)fprintf(stdout, "*** Using a default buffer of size %d for "
                           "logging variable %s\n", nRows, varName);
+#endif
         }
     }
 
@@ -2799,6 +3626,29 @@ LogVar *rt_CreateLogVarWithConvert(
      */
     nColumns = frameData ? dims[1] : nCols;
 
+#ifdef RT_LOGGING_STREAM
+    /*
+     * Variables that would grow in memory are streamed to disk instead, so
+     * only one chunk is allocated.  Variable-size signals keep the growing
+     * buffer since their valueDimensions are stored in the same rows.
+     */
+    streamToDisk = (okayToRealloc == 1 &&
+                    logValDimsStat != LOGVALDIMS_VARDIMS &&
+                    elementSize*nColumns > 0);
+    if (streamToDisk) {
+        long chunkRows = RT_LOGGING_STREAM_CHUNK_SIZE /
+                                           (long)(elementSize*nColumns);
+
+        if (chunkRows < 8) chunkRows = 8;
+        if (chunkRows > INT_MAX) chunkRows = INT_MAX;
+
+        /* keep a smaller exact-size buffer, it just never gets flushed */
+        if (nRows < 8 || nRows > chunkRows) {
+            nRows = (int_T)chunkRows;
+        }
+    }
+#endif
+
     /*
      * Error out if the size of the circular buffer is absurdly large, this
      * error message is more informative than the one we get when we try to
@@ -2985,6 +3835,13 @@ LogVar *rt_CreateLogVarWithConvert(
         }
     }
 
+#ifdef RT_LOGGING_STREAM
+    if (streamToDisk) {
+        /* NULL => the spool could not be created, grow in memory instead */
+        var->data.spool = rt_CreateLogSpool(var);
+    }
+#endif
+
     var->rowIdx               = 0;
     var->wrapped              = 0;
     var->nDataPoints          = 0;
@@ -3275,6 +4132,11 @@ const char_T *rt_StartDataLoggingWithStartTime(RTWLogInfo   *li,
                                               stepSize,errStatus);
     if (*errStatus != NULL)  goto ERROR_EXIT;
 
+#ifdef RT_LOGGING_ASYNC
+    /* NULL => log synchronously */
+    logInfo->async = rt_CreateAsyncLog(li);
+#endif
+
     return(NULL); /* NORMAL_EXIT */
 
  ERROR_EXIT:
@@ -3376,7 +4238,13 @@ void rt_UpdateLogVar(LogVar *var, const void *data, boolean_T isVarDims)
         var->numHits = 0;
 
         if (var->rowIdx == var->data.nRows) {
-            if (var->okayToRealloc == 1) {
+            int_T spooled = (var->data.spool != NULL) ?
+                                            rt_SpoolLogVarChunk(var) : 1;
+            if (spooled < 0) {
+                continue; /* at the MAT-file size limit */
+            } else if (spooled == 0) {
+                /* buffer flushed to disk, rowIdx has been reset */
+            } else if (var->okayToRealloc == 1) {
                 rt_ReallocLogVar(var, isVarDims);
             } else {
                 /* Circular buffer */
@@ -3942,6 +4810,24 @@ const char_T *rt_UpdateTXYLogVars(RTWLogInfo *li, time_T *tPtr)
  *	Update xFinal and/or the T,X,Y variables that are being logged
  */
 const char_T *rt_UpdateTXXFYLogVars(RTWLogInfo *li, time_T *tPtr, boolean_T updateTXY)
+{
+#ifdef RT_LOGGING_ASYNC
+    LogInfo *logInfo = rtliGetLogInfo(li);
+
+    if (logInfo->async != NULL) {
+        return(rt_PushAsyncLog(logInfo->async, li, tPtr, updateTXY));
+    }
+#endif
+    return(rt_LogTXXFYData(li, tPtr, updateTXY));
+
+} /* end rt_UpdateTXXFYLogVars */
+
+
+/* Function: rt_LogTXXFYData ===================================================
+ * Abstract:
+ *	Log the xFinal and/or T,X,Y data of the current step.
+ */
+static const char_T *rt_LogTXXFYData(RTWLogInfo *li, time_T *tPtr, boolean_T updateTXY)
 {
     LogInfo *logInfo     = rtliGetLogInfo(li);
     int_T   matrixFormat = (rtliGetLogFormat(li) == 0);
@@ -4110,7 +4996,7 @@ const char_T *rt_UpdateTXXFYLogVars(RTWLogInfo *li, time_T *tPtr, boolean_T upda
         }
     }
     return(NULL);
-} /* end rt_UpdateTXXFYLogVars */
+} /* end rt_LogTXXFYData */
 
 
 #ifdef __cplusplus
@@ -4143,6 +5029,12 @@ void rt_StopDataLoggingImpl(const char_T *file, RTWLogInfo *li, boolean_T isRacc
     boolean_T     errFlag      = 0;
     const char_T  *msg;
 
+#ifdef RT_LOGGING_ASYNC
+    /* let the writer thread finish logging the queued steps */
+    rt_DestroyAsyncLog(logInfo->async);
+    logInfo->async = NULL;
+#endif
+
     /*******************************
      * Create MAT file with header *
      *******************************/
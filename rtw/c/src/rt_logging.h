@@ -38,6 +38,7 @@
 typedef double MatReal;                /* "real" data type used in model.mat  */
 typedef struct LogVar_Tag LogVar;
 typedef struct StructLogVar_Tag StructLogVar;
+typedef struct LogSpool_Tag LogSpool;
 
 typedef struct MatrixData_Tag {
   char_T         name[mxMAXNAM];     /* Name of the variable                  */
@@ -67,6 +68,9 @@ typedef struct MatrixData_Tag {
   uint32_T       complex;            /* is this a complex matrix?             */
   uint32_T       frameData;          /* is this data frame based?             */
   uint32_T       frameSize;          /* is this data frame based?             */
+  LogSpool       *spool;             /* rows already streamed to disk when
+                                        RT_LOGGING_STREAM is defined, NULL
+                                        if all the data is held in memory     */
 } MatrixData;
 
 typedef struct ValDimsData_Tag {
@@ -8,6 +8,19 @@
  *   The tasking mode is controlled by the MULTITASKING #define.
  *
  *   The data allocation type is controlled by the RT_MALLOC #define.
+ *
+ *   Time is kept as an integer count of base rate ticks.  A task's period
+ *   and offset are whole numbers of ticks, and its time is the tick of its
+ *   hit times the step size.  Times do not drift on long runs, and tasks
+ *   that hit together get the same time.  A task is due when the tick
+ *   reaches its next hit tick, so steps where no task is due cost only a
+ *   comparison per task.
+ *
+ *   Single tasking, non-real-time targets can define RT_SIM_SKIP_EMPTY_STEPS
+ *   to go straight from one hit of the discrete rates to the next.  Use it
+ *   only for models whose base rate has no blocks of its own (the fixed
+ *   step is a common divisor of the rates) and no continuous states;
+ *   otherwise every base rate step is taken.
  */
 
 
@@ -27,6 +40,16 @@
  * Struct's *
  *==========*/
 
+/*
+ * Base rate tick count.  Without 64-bit integers, a flint is exact for
+ * 2^53 ticks.
+ */
+#ifdef INT64_T
+typedef int64_T rtTick_T;
+#else
+typedef real_T  rtTick_T;
+#endif
+
 /*
  * TimingData
  */
@@ -35,24 +58,26 @@
 
 /* dynamically allocate data */
 typedef struct TimingData_Tag {
-    real_T *period;       /* Task periods in seconds                   */
-    real_T *offset;       /* Task offsets in seconds                   */
-    real_T *clockTick;    /* Flint task time tick counter              */
-    int_T  *taskTick;     /* Counter for determining task hits         */
-    int_T  *nTaskTicks;   /* Number base rate ticks for a task hit     */
-    int_T  firstDiscIdx;  /* First discrete task index                 */
+    real_T   stepSize;      /* Base rate period in seconds               */
+    rtTick_T baseTick;      /* Base rate tick counter                    */
+    rtTick_T *clockTick;    /* Task hit counter (multitasking)           */
+    rtTick_T *nextHit;      /* Base rate tick of the next task hit       */
+    rtTick_T *nTaskTicks;   /* Number base rate ticks for a task hit     */
+    rtTick_T *offsetTicks;  /* Base rate tick of the first task hit      */
+    int_T    firstDiscIdx;  /* First discrete task index                 */
 } TimingData;
 
 #else
 
 /* statically allocate data */
 typedef struct TimingData_Tag {
-    real_T period[NUMST];       /* Task periods in seconds                   */
-    real_T offset[NUMST];       /* Task offsets in seconds                   */
-    real_T clockTick[NUMST];    /* Flint task time tick counter              */
-    int_T  taskTick[NUMST];     /* Counter for determining task hits         */
-    int_T  nTaskTicks[NUMST];   /* Number base rate ticks for a task hit     */
-    int_T  firstDiscIdx;        /* First discrete task index                 */
+    real_T   stepSize;           /* Base rate period in seconds              */
+    rtTick_T baseTick;           /* Base rate tick counter                   */
+    rtTick_T clockTick[NUMST];   /* Task hit counter (multitasking)          */
+    rtTick_T nextHit[NUMST];     /* Base rate tick of the next task hit      */
+    rtTick_T nTaskTicks[NUMST];  /* Number base rate ticks for a task hit    */
+    rtTick_T offsetTicks[NUMST]; /* Base rate tick of the first task hit     */
+    int_T    firstDiscIdx;       /* First discrete task index                */
 } TimingData;
 
 #endif
@@ -68,6 +93,24 @@ typedef struct TimingData_Tag {
 static TimingData td_struct;
 #endif
 
+#if !defined(USE_RTMODEL) && !defined(MULTITASKING) && \
+    defined(RT_SIM_SKIP_EMPTY_STEPS)
+/* Function: NextHitTick =======================================================
+ * Abstract:
+ *      Earliest next hit tick of the discrete tasks after the base rate.
+ */
+static rtTick_T NextHitTick(const TimingData *td, int_T numSampTimes)
+{
+    int_T    i;
+    rtTick_T tick = td->nextHit[1];
+
+    for (i = 2; i < numSampTimes; i++) {
+        if (td->nextHit[i] < tick) tick = td->nextHit[i];
+    }
+    return(tick);
+} /* end NextHitTick */
+#endif
+
 /*==================*
  * Visible routines *
  *==================*/
@@ -135,28 +178,23 @@ const char *rt_SimInitTimingEngine(int_T       rtmNumSampTimes,
         return(malloc_error);
     }
 
-    td->period = (real_T *) malloc(numst * sizeof(real_T));
-    if (!td->period) {
-        return(malloc_error);
-    }
-
-    td->offset = (real_T *) malloc(numst * sizeof(real_T));
-    if (!td->offset) {
+    td->clockTick = (rtTick_T *) malloc(numst * sizeof(rtTick_T));
+    if (!td->clockTick) {
         return(malloc_error);
     }
 
-    td->clockTick = (real_T *) malloc(numst * sizeof(real_T));
-    if (!td->clockTick) {
+    td->nextHit = (rtTick_T *) malloc(numst * sizeof(rtTick_T));
+    if (!td->nextHit) {
         return(malloc_error);
     }
 
-    td->taskTick = (int_T *) malloc(numst * sizeof(int_T));
-    if (!td->taskTick) {
+    td->nTaskTicks = (rtTick_T *) malloc(numst * sizeof(rtTick_T));
+    if (!td->nTaskTicks) {
         return(malloc_error);
     }
 
-    td->nTaskTicks = (int_T *) malloc(numst * sizeof(int_T));
-    if (!td->nTaskTicks) {
+    td->offsetTicks = (rtTick_T *) malloc(numst * sizeof(rtTick_T));
+    if (!td->offsetTicks) {
         return(malloc_error);
     }
     if (rtmTStart != 0.0) {
@@ -180,28 +218,29 @@ const char *rt_SimInitTimingEngine(int_T       rtmNumSampTimes,
 
     *rtmSimTimeStepPtr = MAJOR_TIME_STEP;
 
-    *rtmTimingDataPtr = (void*)&td;
+    *rtmTimingDataPtr = (void*)td;
+
+    td->stepSize = stepSize;
+    td->baseTick = 0;
 
     for (i = 0; i < rtmNumSampTimes; i++) {
-        tsMap[i]         = i;
-        td->period[i]     = period[i];
-        td->offset[i]     = offset[i];
-        td->nTaskTicks[i] = (int_T)floor(period[i]/stepSize + 0.5);
-        if (td->period[i] == CONTINUOUS_SAMPLE_TIME ||
-            td->offset[i] == 0.0) {
-            td->taskTick[i]  = 0;
-            td->clockTick[i] = 0.0;
-            sampleHit[i]    = 1;
+        tsMap[i]          = i;
+        td->nTaskTicks[i] = (rtTick_T)floor(period[i]/stepSize + 0.5);
+        if (period[i] == CONTINUOUS_SAMPLE_TIME ||
+            offset[i] == 0.0) {
+            td->offsetTicks[i] = 0;
+            td->clockTick[i]   = 0;
+            sampleHit[i]       = 1;
         } else {
-            td->taskTick[i]  = (int_T)floor((td->period[i]-td->offset[i]) /
-                                            stepSize+0.5);
-            td->clockTick[i] = -1.0;
-            sampleHit[i]    = 0;
+            td->offsetTicks[i] = td->nTaskTicks[i] -
+                (rtTick_T)floor((period[i]-offset[i])/stepSize + 0.5);
+            td->clockTick[i]   = -1;
+            sampleHit[i]       = 0;
         }
+        td->nextHit[i] = td->offsetTicks[i];
     }
 
     /* Correct first sample time if continuous task */
-    td->period[0]     = stepSize;
     td->nTaskTicks[0] = 1; 
 
     /* Set first discrete task index */
@@ -234,25 +273,21 @@ void rt_SimDestroyTimingEngine(void *rtmTimingData)
     td = (TimingData *)rtmTimingData;
 
     if (td) {
-        if (td->period) {
-            free(td->period);
-        }
-        
-        if (td->offset) {
-            free(td->offset);
-        }
-        
         if (td->clockTick) {
             free(td->clockTick);
         }
         
-        if (td->taskTick) {
-            free(td->taskTick);
+        if (td->nextHit) {
+            free(td->nextHit);
         }
         
         if (td->nTaskTicks) {
             free(td->nTaskTicks);
         }
+        
+        if (td->offsetTicks) {
+            free(td->offsetTicks);
+        }
         free(td);
     }
 #endif /* !USE_RTMODEL */
@@ -269,6 +304,9 @@ void rt_SimDestroyTimingEngine(void *rtmTimingData)
 /* Function: rt_SimGetNextSampleHit ============================================
  * Abstract:
  *      For a single tasking real-time system, return time of next sample hit.
+ *      The tasks that hit at the current tick are done: their next hits
+ *      move one period on.  With RT_SIM_SKIP_EMPTY_STEPS, the next sample
+ *      hit is the earliest of those of the discrete tasks.
  */
 /* This function has a different signature in the RT_MALLOC case */
 #ifdef RT_MALLOC
@@ -290,7 +328,7 @@ time_T rt_SimGetNextSampleHit(void)
 
 #else /* must be !USE_RTMODEL */
 
-    time_T timeOfNextHit;
+    int_T i;
 #ifdef RT_MALLOC
     TimingData *td;
     td = (TimingData *)rtmTimingData;
@@ -300,20 +338,20 @@ time_T rt_SimGetNextSampleHit(void)
     td = &td_struct;
     rtmNumSampTimes = NUMST; /* it's not passed in, in this case */
 #endif
-    td->clockTick[0] += 1;
-    timeOfNextHit = td->clockTick[0] * td->period[0];
-
-    if(rtmNumSampTimes > 1) {
-        int i;
-        for (i = 1; i < rtmNumSampTimes; i++) {
-            if (++td->taskTick[i] == td->nTaskTicks[i]) {
-                td->taskTick[i] = 0;
-                td->clockTick[i]++;
-            }
+    for (i = 1; i < rtmNumSampTimes; i++) {
+        if (td->nextHit[i] == td->baseTick) {
+            td->nextHit[i] += td->nTaskTicks[i];
         }
     }
 
-    return(timeOfNextHit);
+    td->baseTick++;
+#ifdef RT_SIM_SKIP_EMPTY_STEPS
+    if (td->firstDiscIdx == 0 && rtmNumSampTimes > 1) {
+        td->baseTick = NextHitTick(td, rtmNumSampTimes);
+    }
+#endif
+
+    return((time_T)td->baseTick * td->stepSize);
 
 #endif /* !USE_RTMODEL */
 } /* end rt_SimGetNextSampleHit */
@@ -361,10 +399,9 @@ void rt_SimUpdateDiscreteTaskSampleHits(int_T  rtmNumSampTimes,
     sampleHit = rtmSampleHitPtr;
 
     for (i = td->firstDiscIdx; i < rtmNumSampTimes; i++) {
-        int_T hit = (td->taskTick[i] == 0);
+        int_T hit = (i == 0 || td->nextHit[i] == td->baseTick);
         if (hit) {
-            rttiSetTaskTime(rtmTPtr, i,
-                            td->clockTick[i]*td->period[i] + td->offset[i]);
+            rttiSetTaskTime(rtmTPtr, i, (real_T)td->baseTick * td->stepSize);
         }
         sampleHit[i] = hit;
     }
@@ -445,11 +482,11 @@ time_T rt_SimUpdateDiscreteEvents(int_T  rtmNumSampTimes,
 #ifdef RT_MALLOC
     TimingData *td;
     td = (TimingData *)rtmTimingData;
-    rtmNumSampTimes = NUMST;
 #else    
     TimingData *td;
     UNUSED_PARAMETER(rtmTimingData);
     td = &td_struct;
+    rtmNumSampTimes = NUMST;
 #endif
     sampleHit = rtmSampleHitPtr;
     
@@ -458,13 +495,14 @@ time_T rt_SimUpdateDiscreteEvents(int_T  rtmNumSampTimes,
      */
     i = rtmNumSampTimes;
     while (--i >= 0) {
-        if (td->taskTick[i] == 0) {
+        if (td->nextHit[i] == td->baseTick) {
             /* 
-             * Got a sample hit, reset the counter, and update the clock
-             * tick counter.
+             * Got a sample hit, update the clock tick counter and the
+             * tick of the next hit.
              */
             sampleHit[i] = 1;
             td->clockTick[i]++;
+            td->nextHit[i] += td->nTaskTicks[i];
 
             /*
              * Record the state of all "slower" events 
@@ -475,17 +513,14 @@ time_T rt_SimUpdateDiscreteEvents(int_T  rtmNumSampTimes,
             }
         } else {
             /*
-             * no sample hit, increment the counter 
+             * no sample hit
              */
             sampleHit[i] = 0;
         }
-
-        if (++td->taskTick[i] == td->nTaskTicks[i]) { /* update for next time */
-            td->taskTick[i] = 0;
-        }
     }
+    td->baseTick++;
 
-    return(td->clockTick[0]*td->period[0]);
+    return((time_T)td->clockTick[0] * td->stepSize);
     
 } /* rt_SimUpdateDiscreteEvents */
 
@@ -521,7 +556,8 @@ void rt_SimUpdateDiscreteTaskTime(real_T *rtmTPtr,
     td = &td_struct;
 #endif
     rttiSetTaskTime(rtmTPtr, tid,
-                    td->clockTick[tid]*td->period[tid] + td->offset[tid]);
+                    (real_T)(td->clockTick[tid]*td->nTaskTicks[tid] +
+                             td->offsetTicks[tid]) * td->stepSize);
 
 #endif /* !USE_RTMODEL */
 }
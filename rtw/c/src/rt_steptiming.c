@@ -0,0 +1,255 @@
+/*
+ * File    : rt_steptiming.c
+ * Abstract:
+ *   Records the execution time, start latency and overruns of the steps of
+ *   each task of a real-time main in log-bucketed histograms.
+ *
+ *   A step costs two reads of CLOCK_MONOTONIC, which is served by the vDSO
+ *   on Linux, and a few stores.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "rt_steptiming.h"
+
+/*
+ * A task is written by the one thread running its steps, so its counters
+ * are updated with plain loads and relaxed stores; only the overrun counts,
+ * which may be bumped by the thread that releases the task, need an atomic
+ * read-modify-write.  The sum of the times, a double, is stored plainly: a
+ * reader may see a mean that is one step behind.
+ */
+#if defined(__GNUC__)
+# define RT_TIMING_LOAD(x)     __atomic_load_n(&(x), __ATOMIC_RELAXED)
+# define RT_TIMING_STORE(x,v)  __atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+# define RT_TIMING_INC(x)      (void)__atomic_fetch_add(&(x), 1U, __ATOMIC_RELAXED)
+#else
+# define RT_TIMING_LOAD(x)     (x)
+# define RT_TIMING_STORE(x,v)  ((x) = (v))
+# define RT_TIMING_INC(x)      ((x)++)
+#endif
+
+typedef struct TimeHist_Tag {
+    uint32_T n;
+    uint32_T min;
+    uint32_T max;
+    real_T   sum;
+    uint32_T count[RT_STEP_TIMING_NBUCKETS];
+} TimeHist;
+
+typedef struct TaskTiming_Tag {
+    TimeHist exec;
+    TimeHist latency;
+    uint32_T nOverruns;
+    uint32_T nSkipped;
+    char_T   pad[64];      /* keep tasks on separate cache lines */
+} TaskTiming;
+
+static TaskTiming taskTiming[RT_STEP_TIMING_MAX_TASKS];
+
+
+/* Function: TimeBucket =======================================================
+ * Abstract:
+ *      Histogram bucket of a time in ns.
+ */
+static int_T TimeBucket(uint32_T t)
+{
+    int_T e;
+
+    if (t < 8U) return((int_T)t);
+
+    /* e = floor(log2(t)), at least 3 */
+#if defined(__GNUC__)
+    e = 31 - __builtin_clz(t);
+#else
+    for (e = 3; (t >> (e+1)) != 0U; e++) {
+        /* keep looking */
+    }
+#endif
+    return(8 + (e-3)*4 + (int_T)((t >> (e-2)) & 3U));
+}
+
+/* Function: TimeBucketTop ====================================================
+ * Abstract:
+ *      Largest time in ns that falls in bucket 'b'.
+ */
+static uint32_T TimeBucketTop(int_T b)
+{
+    int_T    e;
+    uint32_T sub;
+
+    if (b < 8) return((uint32_T)b);
+    e   = 3 + (b-8)/4;
+    sub = (uint32_T)((b-8)%4);
+    return(((4U + sub) << (e-2)) + ((1U << (e-2)) - 1U));
+}
+
+/* Function: TimeHistAdd ======================================================
+ * Abstract:
+ *      Adds a time to a histogram.  Only the thread recording the task may
+ *      call this.
+ */
+static void TimeHistAdd(TimeHist *h, uint32_T t)
+{
+    int_T b = TimeBucket(t);
+
+    if (h->n == 0U || t < h->min) RT_TIMING_STORE(h->min, t);
+    if (t > h->max) RT_TIMING_STORE(h->max, t);
+    h->sum += (real_T)t;
+    RT_TIMING_STORE(h->count[b], h->count[b] + 1U);
+    RT_TIMING_STORE(h->n, h->n + 1U);
+}
+
+/* Function: TimeHistStats ====================================================
+ * Abstract:
+ *      Minimum, mean, maximum and 99th percentile of a histogram.
+ */
+static void TimeHistStats(const TimeHist *h, uint32_T *n, uint32_T *min,
+                          uint32_T *mean, uint32_T *max, uint32_T *p99)
+{
+    uint32_T nSeen = RT_TIMING_LOAD(h->n);
+
+    *n = nSeen;
+    *min = *mean = *max = *p99 = 0U;
+    if (nSeen == 0U) return;
+
+    *min  = RT_TIMING_LOAD(h->min);
+    *max  = RT_TIMING_LOAD(h->max);
+    *mean = (uint32_T)(h->sum / (real_T)nSeen + 0.5);
+    {
+        /* smallest bucket holding at least 99% of the steps */
+        real_T   target = 0.99 * (real_T)nSeen;
+        real_T   below  = 0.0;
+        int_T    b;
+
+        for (b = 0; b < RT_STEP_TIMING_NBUCKETS; b++) {
+            below += (real_T)RT_TIMING_LOAD(h->count[b]);
+            if (below >= target) break;
+        }
+        if (b == RT_STEP_TIMING_NBUCKETS) b--;
+        *p99 = TimeBucketTop(b);
+        if (*p99 > *max) *p99 = *max;
+    }
+}
+
+
+/*==================*
+ * Visible routines *
+ *==================*/
+
+
+/* Function: rt_StepTimingNow =================================================
+ * Abstract:
+ *      Monotonic time in ns, modulo 2^32.
+ */
+uint32_T rt_StepTimingNow(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((uint32_T)((unsigned long)ts.tv_sec * 1000000000UL +
+                      (unsigned long)ts.tv_nsec));
+}
+
+/* Function: rt_StepTimingReset ===============================================
+ * Abstract:
+ *      Clears the statistics of all tasks.  Must not be called while steps
+ *      are being recorded.
+ */
+void rt_StepTimingReset(void)
+{
+    (void)memset(taskTiming, 0, sizeof(taskTiming));
+}
+
+/* Function: rt_StepTimingRecord ==============================================
+ * Abstract:
+ *      Records a step of task 'tid' that ran from 'start' to 'end', both
+ *      from rt_StepTimingNow.  When 'hasRelease', 'release' is the time the
+ *      step was due, and start - release is recorded as its latency.
+ */
+void rt_StepTimingRecord(int_T    tid,
+                         uint32_T release,
+                         boolean_T hasRelease,
+                         uint32_T start,
+                         uint32_T end)
+{
+    TaskTiming *tt;
+
+    if (tid < 0 || tid >= RT_STEP_TIMING_MAX_TASKS) return;
+    tt = &taskTiming[tid];
+
+    TimeHistAdd(&tt->exec, end - start);
+    if (hasRelease) {
+        uint32_T latency = start - release;
+        /* a step started early by clock granularity has no latency */
+        if (latency > 0x80000000U) latency = 0U;
+        TimeHistAdd(&tt->latency, latency);
+    }
+}
+
+/* Function: rt_StepTimingOverrun =============================================
+ * Abstract:
+ *      Counts an overrun of task 'tid', and whether the step that overran
+ *      was skipped.  May be called from any thread.
+ */
+void rt_StepTimingOverrun(int_T tid, boolean_T skipped)
+{
+    if (tid < 0 || tid >= RT_STEP_TIMING_MAX_TASKS) return;
+    RT_TIMING_INC(taskTiming[tid].nOverruns);
+    if (skipped) RT_TIMING_INC(taskTiming[tid].nSkipped);
+}
+
+/* Function: rt_StepTimingGetStats ============================================
+ * Abstract:
+ *      Statistics of task 'tid' so far.  May be called from any thread.
+ */
+void rt_StepTimingGetStats(int_T tid, rtStepTimingStats *stats)
+{
+    const TaskTiming *tt;
+
+    (void)memset(stats, 0, sizeof(*stats));
+    if (tid < 0 || tid >= RT_STEP_TIMING_MAX_TASKS) return;
+    tt = &taskTiming[tid];
+
+    stats->nOverruns = RT_TIMING_LOAD(tt->nOverruns);
+    stats->nSkipped  = RT_TIMING_LOAD(tt->nSkipped);
+    TimeHistStats(&tt->exec, &stats->nSteps, &stats->execMin,
+                  &stats->execMean, &stats->execMax, &stats->execP99);
+    TimeHistStats(&tt->latency, &stats->nLatency, &stats->latencyMin,
+                  &stats->latencyMean, &stats->latencyMax, &stats->latencyP99);
+}
+
+/* Function: rt_StepTimingPrint ===============================================
+ * Abstract:
+ *      Prints the statistics of tasks 0 to numTasks-1, in microseconds.
+ */
+void rt_StepTimingPrint(int_T numTasks)
+{
+    int_T tid;
+
+    (void)printf("\n** step timing (us) **\n");
+    (void)printf("tid      steps  overruns   skipped"
+                 "   exec min/mean/p99/max      latency min/mean/p99/max\n");
+    for (tid = 0; tid < numTasks && tid < RT_STEP_TIMING_MAX_TASKS; tid++) {
+        rtStepTimingStats s;
+        rt_StepTimingGetStats(tid, &s);
+        if (s.nSteps == 0U && s.nOverruns == 0U) continue;
+        (void)printf("%3d %10lu %9lu %9lu   %.1f/%.1f/%.1f/%.1f",
+                     (int)tid, (unsigned long)s.nSteps,
+                     (unsigned long)s.nOverruns, (unsigned long)s.nSkipped,
+                     s.execMin*1e-3, s.execMean*1e-3,
+                     s.execP99*1e-3, s.execMax*1e-3);
+        if (s.nLatency != 0U) {
+            (void)printf("   %.1f/%.1f/%.1f/%.1f",
+                         s.latencyMin*1e-3, s.latencyMean*1e-3,
+                         s.latencyP99*1e-3, s.latencyMax*1e-3);
+        }
+        (void)printf("\n");
+    }
+}
+
+/* [EOF] rt_steptiming.c */
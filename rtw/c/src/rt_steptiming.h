@@ -0,0 +1,69 @@
+/*
+ * File: rt_steptiming.h
+ *
+ * Abstract:
+ *	Per-task execution time, start latency and overrun statistics of the
+ *	steps of a real-time main (see RT_STEP_TIMING in rt_main.c).
+ *
+ *	The times are kept in log-bucketed histograms: 8 buckets of 1 ns, then
+ *	4 buckets per power of two, so that a percentile is known to within
+ *	25% over the whole range up to 4.29 s.  Each task is recorded by a
+ *	single thread, without locks; the statistics may be read from any
+ *	thread at any time, at the cost of a snapshot that can be one step
+ *	out of date.
+ */
+
+#ifndef __RT_STEPTIMING__
+#define __RT_STEPTIMING__
+
+#include "rtwtypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RT_STEP_TIMING_MAX_TASKS
+#define RT_STEP_TIMING_MAX_TASKS 16  /* tasks with statistics */
+#endif
+
+#define RT_STEP_TIMING_NBUCKETS  124 /* 8 + 4 per power of two up to 2^31 */
+
+typedef struct rtStepTimingStats_Tag {
+    uint32_T nSteps;          /* steps recorded                           */
+    uint32_T nOverruns;       /* overruns detected                        */
+    uint32_T nSkipped;        /* steps skipped after an overrun           */
+
+    uint32_T execMin;         /* execution time, ns                       */
+    uint32_T execMean;
+    uint32_T execMax;
+    uint32_T execP99;         /* upper bound of the 99th percentile       */
+
+    uint32_T nLatency;        /* steps with a known release time          */
+    uint32_T latencyMin;      /* start time - release time, ns            */
+    uint32_T latencyMean;
+    uint32_T latencyMax;
+    uint32_T latencyP99;
+} rtStepTimingStats;
+
+/* Monotonic time in ns, modulo 2^32: only differences are meaningful */
+extern uint32_T rt_StepTimingNow(void);
+
+extern void rt_StepTimingReset(void);
+
+extern void rt_StepTimingRecord(int_T    tid,
+                                uint32_T release,
+                                boolean_T hasRelease,
+                                uint32_T start,
+                                uint32_T end);
+
+extern void rt_StepTimingOverrun(int_T tid, boolean_T skipped);
+
+extern void rt_StepTimingGetStats(int_T tid, rtStepTimingStats *stats);
+
+extern void rt_StepTimingPrint(int_T numTasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_STEPTIMING__ */
@@ -1,8 +1,17 @@
 /* Copyright 2011-2019 The MathWorks, Inc. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* CPU_SET and pthread_setaffinity_np */
+#endif
 #include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <semaphore.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include "rtw_linux.h"
 
 #ifndef __USE_UNIX98
@@ -27,6 +36,8 @@ void rtw_pthread_mutex_init( void** mutexDW )
 
 typedef struct {
     void      (*func)(void);
+    void      (*funcArg)(void*); /* used instead of func when non-NULL */
+    void      *arg;
     sem_t     semaphore;
     sem_t     doneSema;
     pthread_t thread;
@@ -38,21 +49,75 @@ void* rtw_worker_task(void *arg_) {
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS,NULL);
     while (1) {
         sem_wait(&(arg->semaphore));
-        arg->func(); /* execute the task body */
+        /* execute the task body */
+        if (arg->funcArg != NULL) {
+            arg->funcArg(arg->arg);
+        } else {
+            arg->func();
+        }
         sem_post(&(arg->doneSema));
     }
 }
 
-void* rtw_register_task(void(*f)(void)){
+/*
+ * Run 'thread' under SCHED_FIFO at 'priority' unless it is 0, and pin it to
+ * core 'cpu' unless it is negative.  Returns 0, or the first error number.
+ * Both need privileges (CAP_SYS_NICE) that the caller may not have, in
+ * which case the thread keeps running with its current settings.
+ */
+int rtw_set_thread_sched(pthread_t thread, int priority, int cpu)
+{
+    int s = 0;
+    if (priority > 0) {
+        struct sched_param schedParam;
+        schedParam.sched_priority = priority;
+        s = pthread_setschedparam(thread, SCHED_FIFO, &schedParam);
+    }
+    if (cpu >= 0) {
+        int s1;
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        s1 = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+        if (s == 0) s = s1;
+    }
+    return s;
+}
+
+static pthread_task_T* rtw_create_task(void(*f)(void),
+                                       void(*fArg)(void*), void *fData){
   pthread_task_T *arg = (pthread_task_T*)malloc(sizeof(pthread_task_T));
   sem_init(&(arg->semaphore), 0, 0);
   sem_init(&(arg->doneSema), 0, 0);
   arg->func = f;
+  arg->funcArg = fArg;
+  arg->arg = fData;
   arg->isPrioritySet = 0;
   pthread_create(&(arg->thread), NULL, rtw_worker_task, arg);
   return arg;
 }
 
+void* rtw_register_task(void(*f)(void)){
+  return rtw_create_task(f, NULL, NULL);
+}
+
+/*
+ * Like rtw_register_task, for a task body taking 'fData'.  The task thread
+ * gets its scheduling from rtw_set_thread_sched(priority, cpu) instead of
+ * inheriting the priority of the first thread that triggers it; a failure
+ * to apply it is reported on stderr.
+ */
+void* rtw_register_task_ex(void(*f)(void*), void *fData,
+                           int priority, int cpu){
+  pthread_task_T *arg = rtw_create_task(NULL, f, fData);
+  int s = rtw_set_thread_sched(arg->thread, priority, cpu);
+  if (s != 0) {
+    fprintf(stderr, "rtw_set_thread_sched returned error %d\n", s);
+  }
+  arg->isPrioritySet = 1;
+  return arg;
+}
+
 void rtw_trigger_task(void *arg_){
   pthread_task_T *arg= (pthread_task_T*) arg_;
   int schedPolicy;
@@ -82,5 +147,186 @@ void rtw_deregister_task(void *arg_){
   sem_destroy(&(arg->doneSema));
   free(arg);
 }
-/* LocalWords:  PTHREAD PRIO pthread
+/*
+ * Task groups: a fixed set of tasks that are all started together and
+ * joined together, for models that fork several tasks every base step.
+ * Instead of two semaphores per task, the group has one start word, and
+ * each task a done word that it alone writes, each on its own cache line.
+ * Both sides spin for RTW_TASK_GROUP_SPIN polls before parking on a futex,
+ * which is only woken when somebody is parked on it.  Spinning is skipped on a
+ * single processor, where it can only delay the thread being waited for.
+ */
+#ifndef RTW_TASK_GROUP_SPIN
+#define RTW_TASK_GROUP_SPIN 4000
+#endif
+
+#define RTW_CACHE_LINE 64
+
+#if defined(__i386__) || defined(__x86_64__)
+#define rtw_cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define rtw_cpu_relax() __asm__ __volatile__("yield")
+#else
+#define rtw_cpu_relax() /* do nothing */
+#endif
+
+typedef struct {
+    void          (*func)(void);
+    pthread_t     thread;
+    struct rtw_task_group_Tag *group;
+    unsigned int  done;           /* epoch last completed (futex)          */
+    char          pad[RTW_CACHE_LINE - sizeof(void(*)(void)) -
+                      sizeof(pthread_t) - sizeof(void*) - sizeof(int)];
+} rtw_group_worker_T;
+
+typedef struct rtw_task_group_Tag {
+    unsigned int  epoch;          /* bumped to start the tasks (futex)     */
+    unsigned int  nStartWaiters;  /* workers parked on epoch               */
+    int           stop;           /* exit at the next start                */
+    char          pad1[RTW_CACHE_LINE - 3*sizeof(int)];
+    unsigned int  joinWaiting;    /* the joining thread is parked          */
+    char          pad2[RTW_CACHE_LINE - sizeof(int)];
+    int           nTasks;
+    int           spin;           /* polls before parking                  */
+    rtw_group_worker_T *workers;
+    void          *mem;           /* unaligned allocation                  */
+} rtw_task_group_T;
+
+static void rtw_futex_wait(unsigned int *addr, unsigned int val)
+{
+    (void)syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static void rtw_futex_wake(unsigned int *addr, int n)
+{
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+static void* rtw_group_worker(void *arg_) {
+    rtw_group_worker_T *w     = arg_;
+    rtw_task_group_T   *group = w->group;
+    unsigned int       seen   = 0;
+
+    while (1) {
+        unsigned int e;
+        int i;
+
+        /* wait for the next start: spin, then park */
+        for (i = 0; i < group->spin; i++) {
+            if (__atomic_load_n(&group->epoch, __ATOMIC_ACQUIRE) != seen) break;
+            rtw_cpu_relax();
+        }
+        while ((e = __atomic_load_n(&group->epoch, __ATOMIC_ACQUIRE)) == seen) {
+            __atomic_add_fetch(&group->nStartWaiters, 1U, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&group->epoch, __ATOMIC_SEQ_CST) == seen) {
+                rtw_futex_wait(&group->epoch, seen);
+            }
+            __atomic_sub_fetch(&group->nStartWaiters, 1U, __ATOMIC_SEQ_CST);
+        }
+        seen = e;
+        if (__atomic_load_n(&group->stop, __ATOMIC_ACQUIRE)) break;
+
+        w->func(); /* execute the task body */
+
+        __atomic_store_n(&w->done, seen, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&group->joinWaiting, __ATOMIC_SEQ_CST)) {
+            rtw_futex_wake(&w->done, 1);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Create a group running funcs[0..nTasks-1], each in its own thread.  The
+ * threads get rtw_set_thread_sched(priority, cpus[i]), or no pinning when
+ * cpus is NULL.  Returns NULL on failure.
+ */
+void* rtw_create_task_group(int nTasks, void (*const *funcs)(void),
+                            const int *cpus, int priority){
+  rtw_task_group_T *group;
+  void *mem;
+  size_t hdrSize;
+  int i;
+
+  /* group and workers aligned to cache lines */
+  hdrSize = (sizeof(rtw_task_group_T) + RTW_CACHE_LINE - 1) &
+      ~(size_t)(RTW_CACHE_LINE - 1);
+  mem = calloc(1, hdrSize + nTasks*sizeof(rtw_group_worker_T) + RTW_CACHE_LINE);
+  if (mem == NULL) return NULL;
+  group = (rtw_task_group_T *)
+      (((size_t)mem + RTW_CACHE_LINE - 1) & ~(size_t)(RTW_CACHE_LINE - 1));
+  group->mem = mem;
+  group->nTasks = nTasks;
+  group->workers = (rtw_group_worker_T *)((char *)group + hdrSize);
+  group->spin = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? RTW_TASK_GROUP_SPIN : 0;
+
+  for (i = 0; i < nTasks; i++) {
+    rtw_group_worker_T *w = &group->workers[i];
+    int s;
+    w->func = funcs[i];
+    w->group = group;
+    if (pthread_create(&w->thread, NULL, rtw_group_worker, w) != 0) {
+      group->nTasks = i;
+      rtw_destroy_task_group(group);
+      return NULL;
+    }
+    s = rtw_set_thread_sched(w->thread, priority, cpus != NULL ? cpus[i] : -1);
+    if (s != 0) {
+      fprintf(stderr, "rtw_set_thread_sched returned error %d\n", s);
+    }
+  }
+  return group;
+}
+
+/* Start all the tasks of the group; the previous start must be joined */
+void rtw_trigger_task_group(void *arg_){
+  rtw_task_group_T *group = arg_;
+  __atomic_add_fetch(&group->epoch, 1U, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&group->nStartWaiters, __ATOMIC_SEQ_CST)) {
+    rtw_futex_wake(&group->epoch, INT_MAX);
+  }
+}
+
+/* Wait until all the tasks of the last start have completed */
+void rtw_waitfor_task_group(void *arg_){
+  rtw_task_group_T *group = arg_;
+  unsigned int e = __atomic_load_n(&group->epoch, __ATOMIC_RELAXED);
+  unsigned int d;
+  int i, n = 0;
+
+  for (i = 0; i < group->nTasks; i++) {
+    unsigned int *done = &group->workers[i].done;
+
+    /* spin, with one budget of polls for the whole group, then park */
+    while (__atomic_load_n(done, __ATOMIC_ACQUIRE) != e && n < group->spin) {
+      rtw_cpu_relax();
+      n++;
+    }
+    if (__atomic_load_n(done, __ATOMIC_ACQUIRE) == e) continue;
+    __atomic_store_n(&group->joinWaiting, 1U, __ATOMIC_SEQ_CST);
+    while ((d = __atomic_load_n(done, __ATOMIC_SEQ_CST)) != e) {
+      rtw_futex_wait(done, d);
+    }
+  }
+  __atomic_store_n(&group->joinWaiting, 0U, __ATOMIC_RELAXED);
+}
+
+/* Stop the threads of a joined group and free it */
+void rtw_destroy_task_group(void *arg_){
+  rtw_task_group_T *group = arg_;
+  int i;
+
+  __atomic_store_n(&group->stop, 1, __ATOMIC_RELEASE);
+  __atomic_add_fetch(&group->epoch, 1U, __ATOMIC_SEQ_CST);
+  rtw_futex_wake(&group->epoch, INT_MAX);
+  for (i = 0; i < group->nTasks; i++) {
+    int s = pthread_join(group->workers[i].thread, NULL);
+    if( s != 0){
+      fprintf(stderr, "pthread_join returned error %d\n", s);
+    }
+  }
+  free(group->mem);
+}
+
+/* LocalWords:  PTHREAD PRIO pthread futex
  */
@@ -24,9 +24,15 @@ extern "C" {
 
 extern void rtw_pthread_mutex_init( void** mutexDW );        
 extern void* rtw_register_task(void (*)(void));
+extern void* rtw_register_task_ex(void (*)(void*), void*, int, int);
+extern int rtw_set_thread_sched(pthread_t, int, int);
 extern void rtw_trigger_task(void*);
 extern void rtw_waitfor_task(void*);
 extern void rtw_deregister_task(void*);
+extern void* rtw_create_task_group(int, void (*const *)(void), const int*, int);
+extern void rtw_trigger_task_group(void*);
+extern void rtw_waitfor_task_group(void*);
+extern void rtw_destroy_task_group(void*);
 
 #ifdef __cplusplus
 }
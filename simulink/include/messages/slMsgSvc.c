@@ -14,6 +14,8 @@
  *    - define SLMSG_USE_EXCEPTION to allow run-time exceptions
  *    - define SLMSG_ALLOW_SYSTEM_ALLOC to include malloc/free code
  *      note that this also turns on SLMSG_USE_EXCEPTION
+ *    - define SLMSG_CACHE_LINE_SIZE to the cache line size of the target
+ *      (64 by default) to keep the SRSW queue indices apart
  */
 
 #ifdef SL_INTERNAL
@@ -88,6 +90,36 @@ void __slmsg_memset_impl(void* dst, int val, unsigned long nbytes);
 
 #define SLMSG_CIRCULAR_INDEX(index, capacity) (((capacity) == 0) ? (index) : ((index) % (capacity)))
 
+#ifdef SLMSG_INCLUDE_TASK_TRANSITION_QUEUE
+/* Ordering of the SRSW queue indices between the reader and writer tasks:
+ * an index is stored with release semantics once its slot has been written
+ * or read, and loaded with acquire semantics before the slot is used, so a
+ * slot is never read before its payload or overwritten before it is read.
+ */
+#if defined(__GNUC__)
+#define SLMSG_LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define SLMSG_STORE_RELEASE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define SLMSG_LOAD_ACQUIRE(x) __slmsg_load_acquire(&(x))
+#define SLMSG_STORE_RELEASE(x, v) __slmsg_store_release(&(x), (v))
+static uint8_T __slmsg_load_acquire(volatile uint8_T* p) {
+    uint8_T v = *p;
+    atomic_thread_fence(memory_order_acquire);
+    return v;
+}
+static void __slmsg_store_release(volatile uint8_T* p, uint8_T v) {
+    atomic_thread_fence(memory_order_release);
+    *p = v;
+}
+#else
+/* volatile accesses: acquire/release with MSVC's /volatile:ms, which is the
+ * default on x86 and x64, and on single core targets */
+#define SLMSG_LOAD_ACQUIRE(x) (x)
+#define SLMSG_STORE_RELEASE(x, v) ((x) = (v))
+#endif
+#endif /* SLMSG_INCLUDE_TASK_TRANSITION_QUEUE */
+
 #define MSG_POOL_SIZE_MAX (slMsgPoolSize)(-1)
 #define MSG_POOL_MAX_CHUNK_SIZE (67108864) /*64MB*/
 
@@ -102,6 +134,25 @@ void __slmsg_memcpy_impl(void* dst, const void* src, unsigned long nbytes) {
     unsigned long idx;
     int8_T* dst8 = (int8_T*)dst;
     const int8_T* src8 = (const int8_T*)src;
+
+#if defined(__GNUC__)
+    /* Copy whole words when both ends are word aligned.  The word type may
+     * alias any payload type; other compilers have no such type and copy
+     * bytes only. */
+    typedef unsigned long __attribute__((__may_alias__)) __slmsg_word_T;
+
+    if ((((size_t)dst8 | (size_t)src8) & (sizeof(__slmsg_word_T) - 1)) == 0) {
+        __slmsg_word_T* dstW = (__slmsg_word_T*)dst;
+        const __slmsg_word_T* srcW = (const __slmsg_word_T*)src;
+        unsigned long nwords = nbytes / sizeof(__slmsg_word_T);
+        for (idx = 0; idx < nwords; ++idx) {
+            *dstW++ = *srcW++;
+        }
+        dst8 = (int8_T*)dstW;
+        src8 = (const int8_T*)srcW;
+        nbytes -= nwords * sizeof(__slmsg_word_T);
+    }
+#endif
     for (idx = 0; idx < nbytes; ++idx) {
         *dst8++ = *src8++;
     }
@@ -728,6 +779,144 @@ real_T _slMsgGetMsgPriorityValWithCast(slMessage* msg, slMsgQueue* q) {
     return priorityVal;
 }
 
+/* Whether a queue keeps its messages sorted by priority */
+static boolean_T _slMsgIsPriorityQueue(slMsgQueueType qType) {
+    return (boolean_T)(qType == SLMSG_PRIORITY_QUEUE_ASCENDING ||
+                       qType == SLMSG_PRIORITY_QUEUE_DESCENDING ||
+                       qType == SLMSG_SYSPRIORITY_QUEUE_ASCENDING ||
+                       qType == SLMSG_SYSPRIORITY_QUEUE_DESCENDING);
+}
+
+/* Put newChild where oldChild hangs from parent, or at the root of the treap */
+static void _slMsgTreeReplaceChild(slMsgQueue* q,
+                                   slMessage* parent,
+                                   slMessage* oldChild,
+                                   slMessage* newChild) {
+    if (parent == NULL) {
+        q->fTreeRoot = newChild;
+    } else if (parent->fTreeLeft == oldChild) {
+        parent->fTreeLeft = newChild;
+    } else {
+        parent->fTreeRight = newChild;
+    }
+    if (newChild != NULL) {
+        newChild->fTreeParent = parent;
+    }
+}
+
+/* Rotate a treap node above its parent; the in-order sequence, and so
+ * the linked list of the queue, is unchanged */
+static void _slMsgTreeRotateUp(slMsgQueue* q, slMessage* node) {
+    slMessage* parent = node->fTreeParent;
+
+    _slMsgTreeReplaceChild(q, parent->fTreeParent, parent, node);
+    if (parent->fTreeLeft == node) {
+        parent->fTreeLeft = node->fTreeRight;
+        if (node->fTreeRight != NULL) {
+            node->fTreeRight->fTreeParent = parent;
+        }
+        node->fTreeRight = parent;
+    } else {
+        parent->fTreeRight = node->fTreeLeft;
+        if (node->fTreeLeft != NULL) {
+            node->fTreeLeft->fTreeParent = parent;
+        }
+        node->fTreeLeft = parent;
+    }
+    parent->fTreeParent = node;
+}
+
+/* Whether priority key a sorts before key b. A NaN priority is taken as
+ * the lowest priority in either order: it sorts after every number, and
+ * NaNs keep their arrival order among themselves. NaN messages therefore
+ * always stay at the tail, whereas the former linear walk let a later
+ * message of any priority be queued behind them. */
+static boolean_T _slMsgPriorityKeyLess(real_T a, real_T b) {
+    return (boolean_T)(a < b || (b != b && a == a));
+}
+
+/* Insert a message in a priority queue, behind the messages of equal
+ * priority. The priority is read from the message once and cached; the
+ * treap finds the message's neighbor, next to which it is linked in the
+ * list, and random weights keep the treap balanced. */
+static void _slMsgPriorityInsert(slMsgQueue* q, slMessage* msg) {
+    slMessage* parent = NULL;
+    slMessage* node = q->fTreeRoot;
+    real_T key = _slMsgGetMsgPriorityValWithCast(msg, q);
+    uint32_T seed = q->fTreeSeed;
+
+    if (q->fType == SLMSG_PRIORITY_QUEUE_DESCENDING ||
+        q->fType == SLMSG_SYSPRIORITY_QUEUE_DESCENDING) {
+        key = -key;
+    }
+    msg->fPriorityKey = key;
+
+    /* xorshift32 */
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    q->fTreeSeed = seed;
+    msg->fTreeWeight = seed;
+    msg->fTreeLeft = NULL;
+    msg->fTreeRight = NULL;
+
+    /* Equal keys go right, after the messages already queued */
+    while (node != NULL) {
+        parent = node;
+        node = _slMsgPriorityKeyLess(key, node->fPriorityKey) ? node->fTreeLeft : node->fTreeRight;
+    }
+    msg->fTreeParent = parent;
+
+    if (parent == NULL) {
+        q->fTreeRoot = msg;
+        q->fHead = msg;
+        q->fTail = msg;
+    } else if (_slMsgPriorityKeyLess(key, parent->fPriorityKey)) {
+        /* A left leaf comes just before its parent */
+        parent->fTreeLeft = msg;
+        msg->fPrev = parent->fPrev;
+        msg->fNext = parent;
+        if (parent->fPrev != NULL) {
+            parent->fPrev->fNext = msg;
+        } else {
+            q->fHead = msg;
+        }
+        parent->fPrev = msg;
+    } else {
+        /* A right leaf comes just after its parent */
+        parent->fTreeRight = msg;
+        msg->fNext = parent->fNext;
+        msg->fPrev = parent;
+        if (parent->fNext != NULL) {
+            parent->fNext->fPrev = msg;
+        } else {
+            q->fTail = msg;
+        }
+        parent->fNext = msg;
+    }
+
+    /* Restore the heap order of the weights */
+    while (msg->fTreeParent != NULL && msg->fTreeParent->fTreeWeight > msg->fTreeWeight) {
+        _slMsgTreeRotateUp(q, msg);
+    }
+}
+
+/* Take a message out of the treap of its priority queue; the caller
+ * unlinks it from the list */
+static void _slMsgPriorityRemove(slMsgQueue* q, slMessage* msg) {
+    /* Rotate the message down until it has at most one child */
+    while (msg->fTreeLeft != NULL && msg->fTreeRight != NULL) {
+        _slMsgTreeRotateUp(q, (msg->fTreeLeft->fTreeWeight < msg->fTreeRight->fTreeWeight)
+                                  ? msg->fTreeLeft
+                                  : msg->fTreeRight);
+    }
+    _slMsgTreeReplaceChild(q, msg->fTreeParent, msg,
+                           (msg->fTreeLeft != NULL) ? msg->fTreeLeft : msg->fTreeRight);
+    msg->fTreeParent = NULL;
+    msg->fTreeLeft = NULL;
+    msg->fTreeRight = NULL;
+}
+
 /* ------------------------------------------------------------------------
  *  Private Methods of slMsgManager
  *
@@ -813,6 +1002,8 @@ void _slMsgCreateMsgQueue(slMsgManager* msgMgr,
     q->fPriorityDataOffset = priorityDataOffset;
     q->fHead = NULL;
     q->fTail = NULL;
+    q->fTreeRoot = NULL;
+    q->fTreeSeed = 2463534242U;
     q->_nextMsgId = 0;
     q->fMgr = msgMgr;
     q->fIsOverflow = 0;
@@ -832,6 +1023,8 @@ void _slMsgCreateMsgQueue(slMsgManager* msgMgr,
     q->fSRSWFIFOQueue.fCircularChunkSize = 0;
     q->fSRSWFIFOQueue.fCircularHead = 0;
     q->fSRSWFIFOQueue.fCircularTail = 0;
+    q->fSRSWFIFOQueue.fCachedHead = 0;
+    q->fSRSWFIFOQueue.fCachedTail = 0;
     q->fSRSWFIFOQueue.fCircularArray = NULL;
 #endif
 }
@@ -872,6 +1065,8 @@ void _slMsgCreateSRSWMsgQueue(slMsgManager* msgMgr,
     q->fPriorityDataOffset = priorityDataOffset;
     q->fHead = NULL;
     q->fTail = NULL;
+    q->fTreeRoot = NULL;
+    q->fTreeSeed = 2463534242U;
     q->readerMessageMemPoolId = readerMessageMemPoolId;
     q->writerMessageMemPoolId = writerMessageMemPoolId;
     q->readerPayloadMemPoolId = readerPayloadMemPoolId;
@@ -896,6 +1091,8 @@ void _slMsgCreateSRSWMsgQueue(slMsgManager* msgMgr,
     q->fSRSWFIFOQueue.fCircularChunkSize = dataSize + sizeof(slMsgId);
     q->fSRSWFIFOQueue.fCircularHead = 0;
     q->fSRSWFIFOQueue.fCircularTail = 0; /* initialization */
+    q->fSRSWFIFOQueue.fCachedHead = 0;
+    q->fSRSWFIFOQueue.fCachedTail = 0;
     q->fSRSWFIFOQueue.fCircularArray = circularArray;
 #else
     (void)circularArray;
@@ -931,6 +1128,10 @@ void _slMsgRemoveFromQueue(slMsgManager* msgMgr, slMessage* msg, slMsgQueueId qI
     isDropping = (numMsg == q->fCapacity);
 #endif
 
+    if (_slMsgIsPriorityQueue(q->fType)) {
+        _slMsgPriorityRemove(q, msg);
+    }
+
     prev = msg->fPrev;
     next = msg->fNext;
 
@@ -976,8 +1177,11 @@ slMessage* _slMsgAddToQueue(slMsgManager* msgMgr, slMessage* msg, slMsgQueueId q
     q = &(msgMgr->fQueues[queueId]);
     qType = q->fType;
 
-    /* Empty queue */
-    if (q->fTail == NULL) {
+    if (_slMsgIsPriorityQueue(qType)) {
+        _slMsgPriorityInsert(q, msg);
+
+    } else if (q->fTail == NULL) {
+        /* Empty queue */
         q->fHead = msg;
         q->fTail = msg;
 
@@ -999,56 +1203,6 @@ slMessage* _slMsgAddToQueue(slMsgManager* msgMgr, slMessage* msg, slMsgQueueId q
             q->fHead = msg;
             break;
         }
-        case SLMSG_PRIORITY_QUEUE_ASCENDING:
-        case SLMSG_PRIORITY_QUEUE_DESCENDING:
-        case SLMSG_SYSPRIORITY_QUEUE_ASCENDING:
-        case SLMSG_SYSPRIORITY_QUEUE_DESCENDING: {
-            real_T newVal;
-            int newMsgAdded = 0;
-            slMessage* thisMsg = q->fHead;
-
-            /* Iterate over queue messages and insert by priority */
-            newVal = _slMsgGetMsgPriorityValWithCast(msg, q);
-
-            while (thisMsg != NULL) {
-                const real_T thisVal = _slMsgGetMsgPriorityValWithCast(thisMsg, q);
-
-                if (((qType == SLMSG_PRIORITY_QUEUE_DESCENDING ||
-                      qType == SLMSG_SYSPRIORITY_QUEUE_DESCENDING) &&
-                     (thisVal < newVal)) ||
-                    ((qType == SLMSG_PRIORITY_QUEUE_ASCENDING ||
-                      qType == SLMSG_SYSPRIORITY_QUEUE_ASCENDING) &&
-                     (thisVal > newVal))) {
-
-                    if (thisMsg->fPrev == NULL) {
-                        thisMsg->fPrev = msg;
-                        msg->fNext = thisMsg;
-                        if (thisMsg == q->fHead) {
-                            q->fHead = msg;
-                        }
-                        newMsgAdded = 1;
-                    } else {
-                        slMessage* prev = thisMsg->fPrev;
-                        prev->fNext = msg;
-                        msg->fPrev = prev;
-                        msg->fNext = thisMsg;
-                        thisMsg->fPrev = msg;
-                        newMsgAdded = 1;
-                    }
-                    break;
-                }
-                thisMsg = thisMsg->fNext;
-            }
-
-            /* If we haven't added it yet then add to the end */
-            if (newMsgAdded == 0) {
-                slMessage* oldtail = q->fTail;
-                oldtail->fNext = msg;
-                msg->fPrev = oldtail;
-                q->fTail = msg;
-            }
-            break;
-        }
         default:
             __slmsg_assert(0);
             break;
@@ -1254,6 +1408,8 @@ slMessage* _slMsgSvcSRSWSendMsg(slMsgManager* msgMgr, slMessage* msg, slMsgQueue
 
 #ifdef SLMSG_INCLUDE_TASK_TRANSITION_QUEUE
     slMsgQueue* q;
+    uint8_T tail;
+    uint8_T nextTail;
 #else
     (void)msgMgr;
     (void)queueId;
@@ -1283,14 +1439,20 @@ slMessage* _slMsgSvcSRSWSendMsg(slMsgManager* msgMgr, slMessage* msg, slMsgQueue
     }
 #endif
 
-    /* the circular queue is not full if the next node of tail is not head */
-    if (SLMSG_CIRCULAR_INDEX(q->fSRSWFIFOQueue.fCircularTail + 1,
-                             q->fSRSWFIFOQueue.fCircularCapacity) !=
-        q->fSRSWFIFOQueue.fCircularHead) {
+    /* Only this task writes the tail */
+    tail = q->fSRSWFIFOQueue.fCircularTail;
+    nextTail = (uint8_T)SLMSG_CIRCULAR_INDEX(tail + 1, q->fSRSWFIFOQueue.fCircularCapacity);
+
+    /* the circular queue is not full if the next node of tail is not head;
+     * the head is only reloaded from the reader when the last one seen says full */
+    if (nextTail == q->fSRSWFIFOQueue.fCachedHead) {
+        q->fSRSWFIFOQueue.fCachedHead = SLMSG_LOAD_ACQUIRE(q->fSRSWFIFOQueue.fCircularHead);
+    }
+    if (nextTail != q->fSRSWFIFOQueue.fCachedHead) {
 
         /* copy msg payload */
         void* dst = (q->fSRSWFIFOQueue.fCircularArray +
-                     (q->fSRSWFIFOQueue.fCircularTail * q->fSRSWFIFOQueue.fCircularChunkSize));
+                     (tail * q->fSRSWFIFOQueue.fCircularChunkSize));
         slMsgMemPool* msgWriterPool = &(msgMgr->fPoolMgr.fPools[q->writerMessageMemPoolId]);
         if (_slMsgIsDataPointerPool(msgWriterPool)) {
             _slMsgDataPointerDeepCopy(msgWriterPool, dst, msg->fData);
@@ -1303,13 +1465,12 @@ slMessage* _slMsgSvcSRSWSendMsg(slMsgManager* msgMgr, slMessage* msg, slMsgQueue
 #ifndef SLMSG_PRODUCTION_CODE
         /* copy msg id */
         SLMSG_MEMCPY((q->fSRSWFIFOQueue.fCircularArray +
-                      (q->fSRSWFIFOQueue.fCircularTail * q->fSRSWFIFOQueue.fCircularChunkSize) +
-                      q->fDataSize),
+                      (tail * q->fSRSWFIFOQueue.fCircularChunkSize) + q->fDataSize),
                      &(msg->fId), sizeof(slMsgId));
 #endif
 
-        q->fSRSWFIFOQueue.fCircularTail = SLMSG_CIRCULAR_INDEX(q->fSRSWFIFOQueue.fCircularTail + 1,
-                                                               q->fSRSWFIFOQueue.fCircularCapacity);
+        /* publish the slot to the reader */
+        SLMSG_STORE_RELEASE(q->fSRSWFIFOQueue.fCircularTail, nextTail);
 
         _slMsgDestroy(msgMgr, msg);
         return NULL;
@@ -1421,6 +1582,7 @@ slMessage* _slMsgSvcSRSWReadMsgFromQueue(slMsgManager* msgMgr,
     slMessage* msg = NULL;
 #ifdef SLMSG_INCLUDE_TASK_TRANSITION_QUEUE
     slMsgQueue* q = NULL;
+    uint8_T head;
 #else
     (void)msgMgr;
     (void)queueId;
@@ -1433,26 +1595,33 @@ slMessage* _slMsgSvcSRSWReadMsgFromQueue(slMsgManager* msgMgr,
     __slmsg_assert(msgMgr->fQueues != NULL);
     q = &(msgMgr->fQueues[queueId]);
 
-    /* if queue is not empty */
-    if (q->fSRSWFIFOQueue.fCircularHead != q->fSRSWFIFOQueue.fCircularTail) {
+    /* Only this task writes the head */
+    head = q->fSRSWFIFOQueue.fCircularHead;
+
+    /* if queue is not empty; the tail is only reloaded from the writer when
+     * the last one seen says empty */
+    if (head == q->fSRSWFIFOQueue.fCachedTail) {
+        q->fSRSWFIFOQueue.fCachedTail = SLMSG_LOAD_ACQUIRE(q->fSRSWFIFOQueue.fCircularTail);
+    }
+    if (head != q->fSRSWFIFOQueue.fCachedTail) {
         msg = _slMsgSvcCreateMsg(
             msgMgr,
-            (q->fSRSWFIFOQueue.fCircularArray +
-             (q->fSRSWFIFOQueue.fCircularHead * q->fSRSWFIFOQueue.fCircularChunkSize)),
+            (q->fSRSWFIFOQueue.fCircularArray + (head * q->fSRSWFIFOQueue.fCircularChunkSize)),
             q->fDataSize, queueId);
 
 #ifndef SLMSG_PRODUCTION_CODE
         /* copy msg id */
         SLMSG_MEMCPY(&(msg->fId),
                      (q->fSRSWFIFOQueue.fCircularArray +
-                      (q->fSRSWFIFOQueue.fCircularHead * q->fSRSWFIFOQueue.fCircularChunkSize) +
-                      q->fDataSize),
+                      (head * q->fSRSWFIFOQueue.fCircularChunkSize) + q->fDataSize),
                      sizeof(slMsgId));
 #endif
 
         if (pop) {
-            q->fSRSWFIFOQueue.fCircularHead = SLMSG_CIRCULAR_INDEX(
-                q->fSRSWFIFOQueue.fCircularHead + 1, q->fSRSWFIFOQueue.fCircularCapacity);
+            /* hand the slot back to the writer */
+            SLMSG_STORE_RELEASE(q->fSRSWFIFOQueue.fCircularHead,
+                                (uint8_T)SLMSG_CIRCULAR_INDEX(
+                                    head + 1, q->fSRSWFIFOQueue.fCircularCapacity));
             q->fIsOverflow = 0;
         }
     }
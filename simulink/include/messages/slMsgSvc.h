@@ -61,6 +61,11 @@ typedef struct __slmsg_MemPoolMgr_T __slmsg_MemPoolMgr;
 typedef struct __slmsg_MemPool_T slMsgMemPool;
 #endif
 
+/* Keeps the indices of a SRSW queue that each task writes on separate cache lines */
+#ifndef SLMSG_CACHE_LINE_SIZE
+#define SLMSG_CACHE_LINE_SIZE 64
+#endif
+
 #define DEF_EVT_PRIORITY (20)
 #define SLMSG_UNSPECIFIED (-1)
 
@@ -194,6 +199,14 @@ struct _slMessage {
     slMsgMemPoolId fMsgPoolId;
     slMsgMemPoolId fDataPoolId;
 
+    /* Priority queues only: the priority read once on insertion (negated
+     * for descending queues) and the message's node in the queue's treap */
+    real_T fPriorityKey;
+    slMessage* fTreeParent;
+    slMessage* fTreeLeft;
+    slMessage* fTreeRight;
+    uint32_T fTreeWeight;
+
 #ifndef SLMSG_PRODUCTION_CODE
     slMsgId fId;
     uint_T fPriority;
@@ -218,6 +231,10 @@ typedef struct _slMsgManager slMsgManager;
  *     A queue holds static properties that define queuing behavior as
  *     well as messages that are contained in the queue at runtime as a
  *     linked list.
+ *
+ *     Priority queues also keep their messages in a treap ordered like
+ *     the list (priority, then arrival), so that a message finds its place
+ *     in O(log n) comparisons of cached keys instead of a walk of the list.
  */
 typedef struct _slMsgQueue {
     slMsgQueueId fId;
@@ -234,6 +251,8 @@ typedef struct _slMsgQueue {
     slMsgDataSize fPriorityDataOffset; /* offset in bytes to priority field */
     slMessage* fHead;
     slMessage* fTail;
+    slMessage* fTreeRoot;  /* priority queues only */
+    uint32_T fTreeSeed;    /* draws the treap weights */
     volatile slMsgId _nextMsgId;
 
     slMsgManager* fMgr;
@@ -253,11 +272,21 @@ typedef struct _slMsgQueue {
 #ifdef SLMSG_INCLUDE_TASK_TRANSITION_QUEUE
     /*For SRSW lock-free queue only*/
     struct {
+        /* set at creation, then only read */
         uint8_T* fCircularArray;
-        volatile uint8_T fCircularHead;
-        volatile uint8_T fCircularTail;
         slMsgDataSize fCircularChunkSize;
         uint8_T fCircularCapacity;
+        char_T _fPad0[SLMSG_CACHE_LINE_SIZE];
+
+        /* written by the reader */
+        volatile uint8_T fCircularHead;
+        uint8_T fCachedTail; /* last fCircularTail seen by the reader */
+        char_T _fPad1[SLMSG_CACHE_LINE_SIZE];
+
+        /* written by the writer */
+        volatile uint8_T fCircularTail;
+        uint8_T fCachedHead; /* last fCircularHead seen by the writer */
+        char_T _fPad2[SLMSG_CACHE_LINE_SIZE];
     } fSRSWFIFOQueue;
 #endif
 } slMsgQueue;